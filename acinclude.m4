@@ -3,6 +3,16 @@ AC_DEFUN([AX_LIBBDE_CHECK_LOCAL],
   [dnl Check for internationalization functions in libbde/libbde_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for memory map functions in libbde/libbde_volume.c
+  AC_CHECK_HEADERS([fcntl.h sys/mman.h sys/stat.h unistd.h])
+
+  AC_CHECK_FUNCS([mmap munmap])
+
+  dnl Check for Linux kernel crypto API (AF_ALG) functions in libbde/libbde_aes_af_alg.c
+  AC_CHECK_HEADERS([linux/if_alg.h sys/socket.h sys/uio.h])
+
+  AC_CHECK_FUNCS([splice vmsplice])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
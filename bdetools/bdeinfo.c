@@ -59,8 +59,9 @@ void usage_fprint(
 	fprintf( stream, "Use bdeinfo to determine information about a BitLocker Drive\n"
 	                 " Encrypted (BDE) volume\n\n" );
 
-	fprintf( stream, "Usage: bdeinfo [ -k keys ] [ -o offset ] [ -p password ]\n"
-	                 "               [ -r password ] [ -s filename ] [ -hvV ] source\n\n" );
+	fprintf( stream, "Usage: bdeinfo [ -k keys ] [ -K filename ] [ -o offset ]\n"
+	                 "               [ -p password ] [ -r password ] [ -s filename ]\n"
+	                 "               [ -hvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
@@ -68,6 +69,9 @@ void usage_fprint(
 	fprintf( stream, "\t-k:     the full volume encryption key and tweak key\n"
 	                 "\t        formatted in base16 and separated by a : character\n"
 	                 "\t        e.g. FKEV:TWEAK\n" );
+	fprintf( stream, "\t-K:     specify the key cache file, the volume master key is read\n"
+	                 "\t        from this file if it exists and written to it after\n"
+	                 "\t        the volume was unlocked\n" );
 	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-p:     specify the password/passphrase\n" );
 	fprintf( stream, "\t-r:     specify the recovery password\n" );
@@ -130,6 +134,7 @@ int main( int argc, char * const argv[] )
 #endif
 {
 	libbde_error_t *error                           = NULL;
+	system_character_t *option_key_cache_filename   = NULL;
 	system_character_t *option_keys                 = NULL;
 	system_character_t *option_password             = NULL;
 	system_character_t *option_recovery_password    = NULL;
@@ -174,7 +179,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = bdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:r:s:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hk:K:o:p:r:s:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -201,6 +206,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'K':
+				option_key_cache_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -334,6 +344,21 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_key_cache_filename != NULL )
+	{
+		if( info_handle_read_key_cache(
+		     bdeinfo_info_handle,
+		     source,
+		     option_key_cache_filename,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read key cache.\n" );
+
+			goto on_error;
+		}
+	}
 	result = info_handle_open_input(
 	          bdeinfo_info_handle,
 	          source,
@@ -370,6 +395,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_key_cache_filename != NULL )
+	{
+		if( info_handle_write_key_cache(
+		     bdeinfo_info_handle,
+		     option_key_cache_filename,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to write key cache.\n" );
+
+			goto on_error;
+		}
+	}
 	if( info_handle_close_input(
 	     bdeinfo_info_handle,
 	     &error ) != 0 )
@@ -90,9 +90,9 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use bdemount to mount a BitLocker Drive Encrypted (BDE) volume\n\n" );
 
-	fprintf( stream, "Usage: bdemount [ -k keys ] [ -o offset ] [ -p password ]\n"
-	                 "                [ -r password ] [ -s filename ] [ -X extended_options ]\n"
-	                 "                [ -hvV ] source mount_point\n\n" );
+	fprintf( stream, "Usage: bdemount [ -k keys ] [ -K filename ] [ -o offset ]\n"
+	                 "                [ -p password ] [ -r password ] [ -s filename ]\n"
+	                 "                [ -X extended_options ] [ -hvV ] source mount_point\n\n" );
 
 	fprintf( stream, "\tsource:      the source file or device\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -101,6 +101,9 @@ void usage_fprint(
 	fprintf( stream, "\t-k:          the full volume encryption key and tweak key\n"
 	                 "\t             formatted in base16 and separated by a : character\n"
 	                 "\t             e.g. FKEV:TWEAK\n" );
+	fprintf( stream, "\t-K:          specify the key cache file, the volume master key is read\n"
+	                 "\t             from this file if it exists and written to it after\n"
+	                 "\t             the volume was unlocked\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-p:          specify the password/passphrase\n" );
 	fprintf( stream, "\t-r:          specify the recovery password\n" );
@@ -109,7 +112,9 @@ void usage_fprint(
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             bdemount will remain running in the foreground\n" );
 	fprintf( stream, "\t-V:          print version\n" );
-	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
+	fprintf( stream, "\t-X:          extended options to pass to sub system\n"
+	                 "\t             cache=<size> sets the size of the decrypted\n"
+	                 "\t             data cache in bytes\n" );
 }
 
 /* Signal handler for bdemount
@@ -156,6 +161,105 @@ void bdemount_signal_handler(
 	}
 }
 
+/* Sets the bdemount specific extended options
+ * The options that are handled are removed from the extended options string
+ * Returns 1 if successful or -1 on error
+ */
+int bdemount_set_extended_options(
+     mount_handle_t *mount_handle,
+     system_character_t *extended_options,
+     libcerror_error_t **error )
+{
+	system_character_t *option_end   = NULL;
+	system_character_t *option_start = NULL;
+	static char *function            = "bdemount_set_extended_options";
+	system_character_t character     = 0;
+	size_t option_length             = 0;
+	size_t string_index              = 0;
+	int result                       = 0;
+
+	if( extended_options == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extended options.",
+		 function );
+
+		return( -1 );
+	}
+	option_start = extended_options;
+
+	while( *option_start != 0 )
+	{
+		option_end = option_start;
+
+		while( ( *option_end != 0 )
+		    && ( *option_end != (system_character_t) ',' ) )
+		{
+			option_end++;
+		}
+		option_length = (size_t) ( option_end - option_start );
+
+		if( ( option_length > 6 )
+		 && ( system_string_compare(
+		       option_start,
+		       _SYSTEM_STRING( "cache=" ),
+		       6 ) == 0 ) )
+		{
+			character   = *option_end;
+			*option_end = 0;
+
+			result = mount_handle_set_cache_size(
+			          mount_handle,
+			          &( option_start[ 6 ] ),
+			          error );
+
+			*option_end = character;
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set cache size.",
+				 function );
+
+				return( -1 );
+			}
+			/* Remove the option and its separator
+			 */
+			if( *option_end == (system_character_t) ',' )
+			{
+				option_end++;
+			}
+			else if( option_start > extended_options )
+			{
+				option_start--;
+			}
+			string_index = 0;
+
+			do
+			{
+				option_start[ string_index ] = option_end[ string_index ];
+			}
+			while( option_end[ string_index++ ] != 0 );
+		}
+		else
+		{
+			option_start = option_end;
+
+			if( *option_start == (system_character_t) ',' )
+			{
+				option_start++;
+			}
+		}
+	}
+	return( 1 );
+}
+
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 
 #if ( SIZEOF_OFF_T != 8 ) && ( SIZEOF_OFF_T != 4 )
@@ -781,6 +885,7 @@ int bdemount_fuse_getattr(
 	static char *function    = "bdemount_fuse_getattr";
 	size64_t volume_size     = 0;
 	uint64_t creation_time   = 0;
+	size_t io_size           = 0;
 	size_t path_length       = 0;
 	int number_of_sub_items  = 0;
 	int result               = -ENOENT;
@@ -879,6 +984,22 @@ int bdemount_fuse_getattr(
 
 				goto on_error;
 			}
+			if( mount_handle_get_optimal_io_size(
+			     bdemount_mount_handle,
+			     &io_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve optimal IO size.",
+				 function );
+
+				result = -EIO;
+
+				goto on_error;
+			}
 			result = 0;
 		}
 	}
@@ -905,6 +1026,12 @@ int bdemount_fuse_getattr(
 
 			goto on_error;
 		}
+		/* Hint the preferred read size that is decrypted directly into the buffer
+		 */
+		if( io_size != 0 )
+		{
+			stat_info->st_blksize = (blksize_t) io_size;
+		}
 	}
 	return( result );
 
@@ -2024,6 +2151,7 @@ int main( int argc, char * const argv[] )
 	libbde_error_t *error                           = NULL;
 	system_character_t *mount_point                 = NULL;
 	system_character_t *option_extended_options     = NULL;
+	system_character_t *option_key_cache_filename   = NULL;
 	system_character_t *option_keys                 = NULL;
 	system_character_t *option_password             = NULL;
 	system_character_t *option_recovery_password    = NULL;
@@ -2080,7 +2208,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = bdetools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:r:s:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hk:K:o:p:r:s:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2107,6 +2235,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'K':
+				option_key_cache_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -2258,6 +2391,35 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_extended_options != NULL )
+	{
+		if( bdemount_set_extended_options(
+		     bdemount_mount_handle,
+		     option_extended_options,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set extended options.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_key_cache_filename != NULL )
+	{
+		if( mount_handle_read_key_cache(
+		     bdemount_mount_handle,
+		     source,
+		     option_key_cache_filename,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read key cache.\n" );
+
+			goto on_error;
+		}
+	}
 	result = mount_handle_open_input(
 	          bdemount_mount_handle,
 	          source,
@@ -2284,6 +2446,20 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_key_cache_filename != NULL )
+	{
+		if( mount_handle_write_key_cache(
+		     bdemount_mount_handle,
+		     option_key_cache_filename,
+		     &error ) == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to write key cache.\n" );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	if( memory_set(
 	     &bdemount_fuse_operations,
@@ -2296,7 +2472,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
-	if( option_extended_options != NULL )
+	if( ( option_extended_options != NULL )
+	 && ( option_extended_options[ 0 ] != 0 ) )
 	{
 		/* This argument is required but ignored
 		 */
@@ -0,0 +1,100 @@
+/*
+ * Key cache file format definitions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BDETOOLS_KEY_CACHE_H )
+#define _BDETOOLS_KEY_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+#define BDETOOLS_KEY_CACHE_FILE_SIGNATURE		"BDEKCACH"
+
+#define BDETOOLS_KEY_CACHE_FILE_FORMAT_VERSION		1
+
+/* The key cache file contains the unprotected volume master key
+ * where supported it is created with owner only access
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) \
+ && defined( HAVE_OPEN ) && defined( HAVE_FSTAT ) && defined( HAVE_FCHMOD ) \
+ && defined( HAVE_FTRUNCATE ) && defined( HAVE_WRITE ) && defined( HAVE_CLOSE )
+#define BDETOOLS_HAVE_KEY_CACHE_FILE_MODE
+
+#if defined( O_NOFOLLOW )
+#define BDETOOLS_KEY_CACHE_FILE_OPEN_FLAGS		( O_WRONLY | O_CREAT | O_NOFOLLOW )
+#else
+#define BDETOOLS_KEY_CACHE_FILE_OPEN_FLAGS		( O_WRONLY | O_CREAT )
+#endif
+#endif
+
+typedef struct bdetools_key_cache_file bdetools_key_cache_file_t;
+
+struct bdetools_key_cache_file
+{
+	/* The signature
+	 * Consists of 8 bytes
+	 * Contains: "BDEKCACH"
+	 */
+	uint8_t signature[ 8 ];
+
+	/* The format version
+	 * Consists of 4 bytes
+	 */
+	uint8_t format_version[ 4 ];
+
+	/* Reserved
+	 * Consists of 4 bytes
+	 */
+	uint8_t reserved[ 4 ];
+
+	/* The volume identifier
+	 * Consists of 16 bytes
+	 * Contains a GUID
+	 */
+	uint8_t volume_identifier[ 16 ];
+
+	/* The volume master key
+	 * Consists of 32 bytes
+	 */
+	uint8_t volume_master_key[ 32 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BDETOOLS_KEY_CACHE_H ) */
+
@@ -28,6 +28,7 @@
 #include <types.h>
 #include <wide_string.h>
 
+#include "bdetools_key_cache.h"
 #include "bdetools_libbde.h"
 #include "bdetools_libbfio.h"
 #include "bdetools_libcerror.h"
@@ -903,6 +904,830 @@ int info_handle_read_startup_key(
 	return( 1 );
 }
 
+/* Retrieves the volume identifier of the source volume
+ * The source is opened separately so that no key protector is used
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int info_handle_get_source_volume_identifier(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libcerror_error_t **error )
+{
+	libbde_volume_t *volume          = NULL;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "info_handle_get_source_volume_identifier";
+	size_t filename_length           = 0;
+	int result                       = 0;
+	int volume_is_open               = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_range_set(
+	     file_io_handle,
+	     info_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set volume offset in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_initialize(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     LIBBDE_OPEN_READ,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	volume_is_open = 1;
+
+	result = libbde_volume_get_volume_identifier(
+	          volume,
+	          volume_identifier,
+	          volume_identifier_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	volume_is_open = 0;
+
+	if( libbde_volume_close(
+	     volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_free(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( volume_is_open != 0 )
+	{
+		libbde_volume_close(
+		 volume,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the volume master key from a key cache file
+ * The key cache file is only used if it was written for the source volume
+ * This function needs to be used after the volume offset was set
+ * Returns 1 if successful, 0 if the key cache file does not exist or -1 on error
+ */
+int info_handle_read_key_cache(
+     info_handle_t *info_handle,
+     const system_character_t *source,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	bdetools_key_cache_file_t key_cache_file;
+
+	uint8_t volume_identifier[ 16 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "info_handle_read_key_cache";
+	size64_t file_size               = 0;
+	size_t filename_length           = 0;
+	ssize_t read_count               = 0;
+	uint32_t format_version          = 0;
+	int result                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if key cache file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_get_size(
+		     file_io_handle,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key cache file size.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_size != (size64_t) sizeof( bdetools_key_cache_file_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file size.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              (uint8_t *) &key_cache_file,
+		              sizeof( bdetools_key_cache_file_t ),
+		              error );
+
+		if( read_count != (ssize_t) sizeof( bdetools_key_cache_file_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     key_cache_file.signature,
+		     BDETOOLS_KEY_CACHE_FILE_SIGNATURE,
+		     8 ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file signature.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 key_cache_file.format_version,
+		 format_version );
+
+		if( format_version != BDETOOLS_KEY_CACHE_FILE_FORMAT_VERSION )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file format version: %" PRIu32 ".",
+			 function,
+			 format_version );
+
+			goto on_error;
+		}
+		result = info_handle_get_source_volume_identifier(
+		          info_handle,
+		          source,
+		          volume_identifier,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source volume identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( memory_compare(
+		            key_cache_file.volume_identifier,
+		            volume_identifier,
+		            16 ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISMATCH,
+			 "%s: key cache file was not written for the source volume.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbde_volume_set_volume_master_key(
+		     info_handle->input_volume,
+		     key_cache_file.volume_master_key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set volume master key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	memory_set(
+	 &key_cache_file,
+	 0,
+	 sizeof( bdetools_key_cache_file_t ) );
+
+	return( -1 );
+}
+
+/* Writes the volume master key to a key cache file
+ * The key cache file allows the volume to be unlocked without a key protector
+ * It contains the unprotected volume master key, hence on POSIX systems it is
+ * created with owner only access and the access of an existing file is restricted
+ * Returns 1 if successful, 0 if the volume master key is not available or -1 on error
+ */
+int info_handle_write_key_cache(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	bdetools_key_cache_file_t key_cache_file;
+
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	struct stat file_stat;
+
+	int file_descriptor              = -1;
+#else
+	libbfio_handle_t *file_io_handle = NULL;
+	size_t filename_length           = 0;
+#endif
+	static char *function            = "info_handle_write_key_cache";
+	ssize_t write_count              = 0;
+	int result                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_volume_get_volume_master_key(
+	          info_handle->input_volume,
+	          key_cache_file.volume_master_key,
+	          32,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume master key.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libbde_volume_get_volume_identifier(
+		          info_handle->input_volume,
+		          key_cache_file.volume_identifier,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		memory_set(
+		 &key_cache_file,
+		 0,
+		 sizeof( bdetools_key_cache_file_t ) );
+
+		return( 0 );
+	}
+	if( memory_copy(
+	     key_cache_file.signature,
+	     BDETOOLS_KEY_CACHE_FILE_SIGNATURE,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key cache file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 key_cache_file.format_version,
+	 BDETOOLS_KEY_CACHE_FILE_FORMAT_VERSION );
+
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	/* The file is not truncated on open so that an existing file is restricted
+	 * to owner only access before the volume master key is written to it
+	 */
+	file_descriptor = open(
+	                   filename,
+	                   BDETOOLS_KEY_CACHE_FILE_OPEN_FLAGS,
+	                   S_IRUSR | S_IWUSR );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_stat ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine key cache file status.",
+		 function );
+
+		goto on_error;
+	}
+	if( !S_ISREG( file_stat.st_mode ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unsupported key cache file - not a regular file.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_stat.st_mode & ( S_IRWXG | S_IRWXO ) ) != 0 )
+	{
+		if( fchmod(
+		     file_descriptor,
+		     file_stat.st_mode & S_IRWXU ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to restrict key cache file access.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ftruncate(
+	     file_descriptor,
+	     0 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to truncate key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = write(
+	               file_descriptor,
+	               (void *) &key_cache_file,
+	               sizeof( bdetools_key_cache_file_t ) );
+#else
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &key_cache_file,
+	               sizeof( bdetools_key_cache_file_t ),
+	               error );
+#endif /* defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE ) */
+
+	if( write_count != (ssize_t) sizeof( bdetools_key_cache_file_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write key cache file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	file_descriptor = -1;
+#else
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE ) */
+
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+#else
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+#endif
+	memory_set(
+	 &key_cache_file,
+	 0,
+	 sizeof( bdetools_key_cache_file_t ) );
+
+	return( -1 );
+}
+
 /* Sets the volume offset
  * Returns 1 if successful or -1 on error
  */
@@ -1129,6 +1954,7 @@ int info_handle_volume_fprint(
 	uint64_t value_64bit                  = 0;
 	uint16_t encryption_method            = 0;
 	uint16_t key_protector_type           = 0;
+	int crypto_backend                    = 0;
 	int key_protector_index               = 0;
 	int number_of_key_protectors          = 0;
 	int result                            = 0;
@@ -1248,6 +2074,72 @@ int info_handle_volume_fprint(
 	 info_handle->notify_stream,
 	 "\n" );
 
+	if( libbde_get_crypto_backend(
+	     &crypto_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve crypto backend.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tCrypto backend\t\t\t: " );
+
+	switch( crypto_backend )
+	{
+		case LIBBDE_CRYPTO_BACKEND_PORTABLE:
+			fprintf(
+			 info_handle->notify_stream,
+			 "Portable" );
+
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AES_NI:
+			fprintf(
+			 info_handle->notify_stream,
+			 "AES-NI" );
+
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_VAES:
+			fprintf(
+			 info_handle->notify_stream,
+			 "VAES (AVX-512)" );
+
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_OPENSSL:
+			fprintf(
+			 info_handle->notify_stream,
+			 "OpenSSL EVP" );
+
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AF_ALG:
+			fprintf(
+			 info_handle->notify_stream,
+			 "Linux AF_ALG" );
+
+			break;
+
+		default:
+			fprintf(
+			 info_handle->notify_stream,
+			 "Unknown (%d)",
+			 crypto_backend );
+
+			break;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
 	if( libbde_volume_get_volume_identifier(
 	     info_handle->input_volume,
 	     guid_buffer,
@@ -97,6 +97,24 @@ int info_handle_read_startup_key(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int info_handle_get_source_volume_identifier(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libcerror_error_t **error );
+
+int info_handle_read_key_cache(
+     info_handle_t *info_handle,
+     const system_character_t *source,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int info_handle_write_key_cache(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int info_handle_set_volume_offset(
      info_handle_t *info_handle,
      const system_character_t *string,
@@ -20,12 +20,14 @@
  */
 
 #include <common.h>
+#include <byte_stream.h>
 #include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
 #include <wide_string.h>
 
+#include "bdetools_key_cache.h"
 #include "bdetools_libbde.h"
 #include "bdetools_libbfio.h"
 #include "bdetools_libcerror.h"
@@ -917,6 +919,830 @@ int mount_handle_read_startup_key(
 	return( 1 );
 }
 
+/* Retrieves the volume identifier of the source volume
+ * The source is opened separately so that no key protector is used
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int mount_handle_get_source_volume_identifier(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libcerror_error_t **error )
+{
+	libbde_volume_t *volume          = NULL;
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "mount_handle_get_source_volume_identifier";
+	size_t filename_length           = 0;
+	int result                       = 0;
+	int volume_is_open               = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_range_set(
+	     file_io_handle,
+	     mount_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set volume offset in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_initialize(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_open_file_io_handle(
+	     volume,
+	     file_io_handle,
+	     LIBBDE_OPEN_READ,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume.",
+		 function );
+
+		goto on_error;
+	}
+	volume_is_open = 1;
+
+	result = libbde_volume_get_volume_identifier(
+	          volume,
+	          volume_identifier,
+	          volume_identifier_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	volume_is_open = 0;
+
+	if( libbde_volume_close(
+	     volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_free(
+	     &volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( volume_is_open != 0 )
+	{
+		libbde_volume_close(
+		 volume,
+		 NULL );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the volume master key from a key cache file
+ * The key cache file is only used if it was written for the source volume
+ * This function needs to be used after the volume offset was set
+ * Returns 1 if successful, 0 if the key cache file does not exist or -1 on error
+ */
+int mount_handle_read_key_cache(
+     mount_handle_t *mount_handle,
+     const system_character_t *source,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	bdetools_key_cache_file_t key_cache_file;
+
+	uint8_t volume_identifier[ 16 ];
+
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "mount_handle_read_key_cache";
+	size64_t file_size               = 0;
+	size_t filename_length           = 0;
+	ssize_t read_count               = 0;
+	uint32_t format_version          = 0;
+	int result                       = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbfio_handle_exists(
+	          file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine if key cache file exists.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_get_size(
+		     file_io_handle,
+		     &file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve key cache file size.",
+			 function );
+
+			goto on_error;
+		}
+		if( file_size != (size64_t) sizeof( bdetools_key_cache_file_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file size.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              (uint8_t *) &key_cache_file,
+		              sizeof( bdetools_key_cache_file_t ),
+		              error );
+
+		if( read_count != (ssize_t) sizeof( bdetools_key_cache_file_t ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close key cache file.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     key_cache_file.signature,
+		     BDETOOLS_KEY_CACHE_FILE_SIGNATURE,
+		     8 ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file signature.",
+			 function );
+
+			goto on_error;
+		}
+		byte_stream_copy_to_uint32_little_endian(
+		 key_cache_file.format_version,
+		 format_version );
+
+		if( format_version != BDETOOLS_KEY_CACHE_FILE_FORMAT_VERSION )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key cache file format version: %" PRIu32 ".",
+			 function,
+			 format_version );
+
+			goto on_error;
+		}
+		result = mount_handle_get_source_volume_identifier(
+		          mount_handle,
+		          source,
+		          volume_identifier,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source volume identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( memory_compare(
+		            key_cache_file.volume_identifier,
+		            volume_identifier,
+		            16 ) != 0 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISMATCH,
+			 "%s: key cache file was not written for the source volume.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbde_volume_set_volume_master_key(
+		     mount_handle->input_volume,
+		     key_cache_file.volume_master_key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set volume master key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	memory_set(
+	 &key_cache_file,
+	 0,
+	 sizeof( bdetools_key_cache_file_t ) );
+
+	return( -1 );
+}
+
+/* Writes the volume master key to a key cache file
+ * The key cache file allows the volume to be unlocked without a key protector
+ * It contains the unprotected volume master key, hence on POSIX systems it is
+ * created with owner only access and the access of an existing file is restricted
+ * Returns 1 if successful, 0 if the volume master key is not available or -1 on error
+ */
+int mount_handle_write_key_cache(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	bdetools_key_cache_file_t key_cache_file;
+
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	struct stat file_stat;
+
+	int file_descriptor              = -1;
+#else
+	libbfio_handle_t *file_io_handle = NULL;
+	size_t filename_length           = 0;
+#endif
+	static char *function            = "mount_handle_write_key_cache";
+	ssize_t write_count              = 0;
+	int result                       = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_volume_get_volume_master_key(
+	          mount_handle->input_volume,
+	          key_cache_file.volume_master_key,
+	          32,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume master key.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		result = libbde_volume_get_volume_identifier(
+		          mount_handle->input_volume,
+		          key_cache_file.volume_identifier,
+		          16,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume identifier.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		memory_set(
+		 &key_cache_file,
+		 0,
+		 sizeof( bdetools_key_cache_file_t ) );
+
+		return( 0 );
+	}
+	if( memory_copy(
+	     key_cache_file.signature,
+	     BDETOOLS_KEY_CACHE_FILE_SIGNATURE,
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key cache file signature.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 key_cache_file.format_version,
+	 BDETOOLS_KEY_CACHE_FILE_FORMAT_VERSION );
+
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	/* The file is not truncated on open so that an existing file is restricted
+	 * to owner only access before the volume master key is written to it
+	 */
+	file_descriptor = open(
+	                   filename,
+	                   BDETOOLS_KEY_CACHE_FILE_OPEN_FLAGS,
+	                   S_IRUSR | S_IWUSR );
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( fstat(
+	     file_descriptor,
+	     &file_stat ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to determine key cache file status.",
+		 function );
+
+		goto on_error;
+	}
+	if( !S_ISREG( file_stat.st_mode ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unsupported key cache file - not a regular file.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( file_stat.st_mode & ( S_IRWXG | S_IRWXO ) ) != 0 )
+	{
+		if( fchmod(
+		     file_descriptor,
+		     file_stat.st_mode & S_IRWXU ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to restrict key cache file access.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( ftruncate(
+	     file_descriptor,
+	     0 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to truncate key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = write(
+	               file_descriptor,
+	               (void *) &key_cache_file,
+	               sizeof( bdetools_key_cache_file_t ) );
+#else
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               (uint8_t *) &key_cache_file,
+	               sizeof( bdetools_key_cache_file_t ),
+	               error );
+#endif /* defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE ) */
+
+	if( write_count != (ssize_t) sizeof( bdetools_key_cache_file_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write key cache file.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	if( close(
+	     file_descriptor ) != 0 )
+	{
+		file_descriptor = -1;
+
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	file_descriptor = -1;
+#else
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#endif /* defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE ) */
+
+	if( memory_set(
+	     &key_cache_file,
+	     0,
+	     sizeof( bdetools_key_cache_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key cache file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+#if defined( BDETOOLS_HAVE_KEY_CACHE_FILE_MODE )
+	if( file_descriptor != -1 )
+	{
+		close(
+		 file_descriptor );
+	}
+#else
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+#endif
+	memory_set(
+	 &key_cache_file,
+	 0,
+	 sizeof( bdetools_key_cache_file_t ) );
+
+	return( -1 );
+}
+
 /* Sets the volume offset
  * Returns 1 if successful or -1 on error
  */
@@ -963,6 +1789,64 @@ int mount_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the cache size
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_cache_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( bdetools_system_string_copy_from_64_bit_in_decimal(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_set_cache_size(
+	     mount_handle->input_volume,
+	     (size64_t) value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set cache size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Opens the mount handle
  * Returns 1 if successful or -1 on error
  */
@@ -1245,6 +2129,44 @@ int mount_handle_get_size(
 	return( 1 );
 }
 
+/* Retrieves the optimal IO size of the input volume
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_optimal_io_size(
+     mount_handle_t *mount_handle,
+     size_t *io_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_optimal_io_size";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_get_optimal_io_size(
+	     mount_handle->input_volume,
+	     io_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve optimal IO size from input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the creation time of the input volume
  * Returns 1 if successful or -1 on error
  */
@@ -97,11 +97,34 @@ int mount_handle_read_startup_key(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int mount_handle_get_source_volume_identifier(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libcerror_error_t **error );
+
+int mount_handle_read_key_cache(
+     mount_handle_t *mount_handle,
+     const system_character_t *source,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int mount_handle_write_key_cache(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int mount_handle_set_volume_offset(
      mount_handle_t *mount_handle,
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_set_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int mount_handle_open_input(
      mount_handle_t *mount_handle,
      const system_character_t *filename,
@@ -132,6 +155,11 @@ int mount_handle_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_handle_get_optimal_io_size(
+     mount_handle_t *mount_handle,
+     size_t *io_size,
+     libcerror_error_t **error );
+
 int mount_handle_get_creation_time(
      mount_handle_t *mount_handle,
      uint64_t *creation_time,
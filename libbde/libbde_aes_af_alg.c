@@ -0,0 +1,1258 @@
+/*
+ * Linux kernel crypto API (AF_ALG) AES functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* The splice and vmsplice functions are GNU extensions
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE
+#endif
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libbde_aes_af_alg.h"
+
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <linux/if_alg.h>
+
+#if !defined( SOL_ALG )
+#define SOL_ALG 279
+#endif
+#endif /* defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT ) */
+
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+
+/* The maximum size of the data of a single request, which must fit
+ * into the pipe that is used to splice the data into the operation socket
+ */
+#define LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE	32768
+
+/* Determines if Linux kernel crypto API (AF_ALG) AES support is available
+ * The kernel must provide the AES-XTS and AES-CBC skcipher algorithms
+ * Returns 1 if available or 0 if not
+ */
+int libbde_aes_af_alg_is_supported(
+     void )
+{
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	struct sockaddr_alg socket_address;
+
+	const char *algorithm_names[ 2 ] = { "xts(aes)", "cbc(aes)" };
+	int algorithm_index              = 0;
+	int socket_descriptor            = 0;
+	int result                       = 1;
+
+	for( algorithm_index = 0;
+	     algorithm_index < 2;
+	     algorithm_index++ )
+	{
+		socket_descriptor = socket(
+		                     AF_ALG,
+		                     SOCK_SEQPACKET,
+		                     0 );
+
+		if( socket_descriptor == -1 )
+		{
+			return( 0 );
+		}
+		if( memory_set(
+		     &socket_address,
+		     0,
+		     sizeof( struct sockaddr_alg ) ) == NULL )
+		{
+			result = 0;
+		}
+		else
+		{
+			socket_address.salg_family = AF_ALG;
+
+			narrow_string_copy(
+			 (char *) socket_address.salg_type,
+			 "skcipher",
+			 9 );
+
+			narrow_string_copy(
+			 (char *) socket_address.salg_name,
+			 algorithm_names[ algorithm_index ],
+			 9 );
+
+			if( bind(
+			     socket_descriptor,
+			     (struct sockaddr *) &socket_address,
+			     sizeof( struct sockaddr_alg ) ) != 0 )
+			{
+				result = 0;
+			}
+		}
+		close(
+		 socket_descriptor );
+
+		if( result == 0 )
+		{
+			break;
+		}
+	}
+	return( result );
+#else
+	return( 0 );
+#endif
+}
+
+/* Creates a Linux kernel crypto API (AF_ALG) AES context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_context_initialize(
+     libbde_aes_af_alg_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_af_alg_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	*context = memory_allocate_structure(
+	            libbde_aes_af_alg_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libbde_aes_af_alg_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+
+		return( -1 );
+	}
+	( *context )->algorithm_socket_descriptor = -1;
+	( *context )->operation_socket_descriptor = -1;
+
+	if( pipe(
+	     ( *context )->pipe_descriptors ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to create pipe.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AF_ALG is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT ) */
+}
+
+/* Frees a Linux kernel crypto API (AF_ALG) AES context
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_context_free(
+     libbde_aes_af_alg_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_af_alg_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+		/* Closing the algorithm socket also releases the key in the kernel
+		 */
+		if( ( *context )->operation_socket_descriptor != -1 )
+		{
+			close(
+			 ( *context )->operation_socket_descriptor );
+		}
+		if( ( *context )->algorithm_socket_descriptor != -1 )
+		{
+			close(
+			 ( *context )->algorithm_socket_descriptor );
+		}
+		close(
+		 ( *context )->pipe_descriptors[ 0 ] );
+
+		close(
+		 ( *context )->pipe_descriptors[ 1 ] );
+#endif
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the key of a Linux kernel crypto API (AF_ALG) AES context
+ * For AES-XTS the key consists of the data key followed by the tweak key
+ * and the key bit size is the size of both keys
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_context_set_key(
+     libbde_aes_af_alg_context_t *context,
+     int cipher_mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	struct sockaddr_alg socket_address;
+
+	const char *algorithm_name = NULL;
+#endif
+	static char *function      = "libbde_aes_af_alg_context_set_key";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB )
+	 && ( cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC )
+	 && ( cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( cipher_mode == LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS )
+	{
+		if( ( key_bit_size != 256 )
+		 && ( key_bit_size != 512 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key bit size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( ( key_bit_size != 128 )
+	      && ( key_bit_size != 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	if( cipher_mode == LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB )
+	{
+		algorithm_name = "ecb(aes)";
+	}
+	else if( cipher_mode == LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC )
+	{
+		algorithm_name = "cbc(aes)";
+	}
+	else
+	{
+		algorithm_name = "xts(aes)";
+	}
+	/* A key that was set before is replaced by binding a new algorithm socket
+	 */
+	if( context->operation_socket_descriptor != -1 )
+	{
+		close(
+		 context->operation_socket_descriptor );
+
+		context->operation_socket_descriptor = -1;
+	}
+	if( context->algorithm_socket_descriptor != -1 )
+	{
+		close(
+		 context->algorithm_socket_descriptor );
+
+		context->algorithm_socket_descriptor = -1;
+	}
+	context->cipher_mode = 0;
+
+	if( memory_set(
+	     &socket_address,
+	     0,
+	     sizeof( struct sockaddr_alg ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear socket address.",
+		 function );
+
+		return( -1 );
+	}
+	socket_address.salg_family = AF_ALG;
+
+	narrow_string_copy(
+	 (char *) socket_address.salg_type,
+	 "skcipher",
+	 9 );
+
+	narrow_string_copy(
+	 (char *) socket_address.salg_name,
+	 algorithm_name,
+	 9 );
+
+	context->algorithm_socket_descriptor = socket(
+	                                        AF_ALG,
+	                                        SOCK_SEQPACKET,
+	                                        0 );
+
+	if( context->algorithm_socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to create algorithm socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( bind(
+	     context->algorithm_socket_descriptor,
+	     (struct sockaddr *) &socket_address,
+	     sizeof( struct sockaddr_alg ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to bind algorithm socket to: %s.",
+		 function,
+		 algorithm_name );
+
+		goto on_error;
+	}
+	if( setsockopt(
+	     context->algorithm_socket_descriptor,
+	     SOL_ALG,
+	     ALG_SET_KEY,
+	     key,
+	     (socklen_t) ( key_bit_size / 8 ) ) != 0 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to set key in algorithm socket.",
+		 function );
+
+		goto on_error;
+	}
+	context->operation_socket_descriptor = accept(
+	                                        context->algorithm_socket_descriptor,
+	                                        NULL,
+	                                        0 );
+
+	if( context->operation_socket_descriptor == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to create operation socket.",
+		 function );
+
+		goto on_error;
+	}
+	context->cipher_mode = cipher_mode;
+
+	return( 1 );
+
+on_error:
+	if( context->algorithm_socket_descriptor != -1 )
+	{
+		close(
+		 context->algorithm_socket_descriptor );
+
+		context->algorithm_socket_descriptor = -1;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AF_ALG is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT ) */
+}
+
+/* De- or encrypts the data of a single request
+ * The operation and the initialization vector are set on the operation socket,
+ * the input data is spliced from the pipe into the socket so that it is not copied
+ * by the kernel and the output data is read back directly into the output buffer
+ * The initialization vector is optional and consists of 16 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_crypt_request(
+     libbde_aes_af_alg_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	uint8_t control_data[ CMSG_SPACE( sizeof( uint32_t ) ) + CMSG_SPACE( sizeof( struct af_alg_iv ) + 16 ) ];
+
+	struct af_alg_iv *algorithm_initialization_vector = NULL;
+	struct cmsghdr *control_message                   = NULL;
+	struct iovec input_vector;
+	struct msghdr message;
+
+	size_t data_offset                                = 0;
+	ssize_t read_count                                = 0;
+	ssize_t write_count                               = 0;
+	uint32_t operation                                = 0;
+#endif
+	static char *function                             = "libbde_aes_af_alg_crypt_request";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->operation_socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing operation socket.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size == 0 )
+	 || ( input_data_size > (size_t) LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT )
+	if( memory_set(
+	     control_data,
+	     0,
+	     sizeof( control_data ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear control data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     &message,
+	     0,
+	     sizeof( struct msghdr ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear message.",
+		 function );
+
+		return( -1 );
+	}
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		operation = ALG_OP_ENCRYPT;
+	}
+	else
+	{
+		operation = ALG_OP_DECRYPT;
+	}
+	message.msg_control    = control_data;
+	message.msg_controllen = CMSG_SPACE( sizeof( uint32_t ) );
+
+	if( initialization_vector != NULL )
+	{
+		message.msg_controllen += CMSG_SPACE( sizeof( struct af_alg_iv ) + 16 );
+	}
+	control_message = CMSG_FIRSTHDR(
+	                   &message );
+
+	control_message->cmsg_level = SOL_ALG;
+	control_message->cmsg_type  = ALG_SET_OP;
+	control_message->cmsg_len   = CMSG_LEN( sizeof( uint32_t ) );
+
+	memory_copy(
+	 CMSG_DATA( control_message ),
+	 &operation,
+	 sizeof( uint32_t ) );
+
+	if( initialization_vector != NULL )
+	{
+		control_message = CMSG_NXTHDR(
+		                   &message,
+		                   control_message );
+
+		control_message->cmsg_level = SOL_ALG;
+		control_message->cmsg_type  = ALG_SET_IV;
+		control_message->cmsg_len   = CMSG_LEN( sizeof( struct af_alg_iv ) + 16 );
+
+		algorithm_initialization_vector = (struct af_alg_iv *) CMSG_DATA( control_message );
+
+		algorithm_initialization_vector->ivlen = 16;
+
+		memory_copy(
+		 algorithm_initialization_vector->iv,
+		 initialization_vector,
+		 16 );
+	}
+	/* The operation is set without data, the request is completed by the data
+	 * that is spliced into the operation socket
+	 */
+	write_count = sendmsg(
+	               context->operation_socket_descriptor,
+	               &message,
+	               MSG_MORE );
+
+	if( write_count == -1 )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to set operation.",
+		 function );
+
+		return( -1 );
+	}
+	/* The pages of the input data are mapped into the pipe instead of copied
+	 */
+	while( data_offset < input_data_size )
+	{
+		input_vector.iov_base = (void *) &( input_data[ data_offset ] );
+		input_vector.iov_len  = input_data_size - data_offset;
+
+		write_count = vmsplice(
+		               context->pipe_descriptors[ 1 ],
+		               &input_vector,
+		               1,
+		               0 );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to map input data into pipe.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) write_count;
+	}
+	/* The input data of the request is spliced in a single call so that
+	 * the kernel does not complete the request on a partial splice
+	 */
+	write_count = splice(
+	               context->pipe_descriptors[ 0 ],
+	               NULL,
+	               context->operation_socket_descriptor,
+	               NULL,
+	               input_data_size,
+	               0 );
+
+	if( write_count != (ssize_t) input_data_size )
+	{
+		libcerror_system_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 (uint32_t) errno,
+		 "%s: unable to splice input data into operation socket.",
+		 function );
+
+		return( -1 );
+	}
+	data_offset = 0;
+
+	while( data_offset < input_data_size )
+	{
+		read_count = read(
+		              context->operation_socket_descriptor,
+		              &( output_data[ data_offset ] ),
+		              input_data_size - data_offset );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 (uint32_t) errno,
+			 "%s: unable to read output data from operation socket.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read output data from operation socket.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += (size_t) read_count;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AF_ALG is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_AF_ALG_SUPPORT ) */
+}
+
+/* Encrypts independent blocks using AES-ECB
+ * The input data size must be a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_encrypt_ecb(
+     libbde_aes_af_alg_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_af_alg_encrypt_ecb";
+	size_t data_offset    = 0;
+	size_t request_size   = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The blocks are independent so a request can contain as many blocks
+	 * as fit in the pipe
+	 */
+	while( data_offset < input_data_size )
+	{
+		request_size = input_data_size - data_offset;
+
+		if( request_size > LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE )
+		{
+			request_size = LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE;
+		}
+		if( libbde_aes_af_alg_crypt_request(
+		     context,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     NULL,
+		     &( input_data[ data_offset ] ),
+		     request_size,
+		     &( output_data[ data_offset ] ),
+		     request_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+			 "%s: unable to encrypt blocks.",
+			 function );
+
+			return( -1 );
+		}
+		data_offset += request_size;
+	}
+	return( 1 );
+}
+
+/* Decrypts sectors using AES-CBC
+ * Every sector is decrypted in a separate request with its own initialization vector,
+ * the key of the algorithm socket is reused for all sectors
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_decrypt_cbc(
+     libbde_aes_af_alg_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_af_alg_decrypt_cbc";
+	size_t sector_offset  = 0;
+	size_t vector_offset  = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( ( input_data_size / bytes_per_sector ) * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		if( libbde_aes_af_alg_crypt_request(
+		     context,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     &( initialization_vectors[ vector_offset ] ),
+		     &( input_data[ sector_offset ] ),
+		     bytes_per_sector,
+		     &( output_data[ sector_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+		vector_offset += 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts sectors using AES-XTS
+ * Every sector is de- or encrypted in a separate request, with as initialization
+ * vector the 128-bit little-endian sector number, the key of the algorithm socket
+ * is reused for all sectors
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_af_alg_crypt_xts(
+     libbde_aes_af_alg_context_t *context,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	uint8_t initialization_vector[ 16 ];
+
+	static char *function = "libbde_aes_af_alg_crypt_xts";
+	size_t sector_offset  = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) LIBBDE_AES_AF_ALG_MAXIMUM_REQUEST_SIZE )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     initialization_vector,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 initialization_vector,
+		 sector_number );
+
+		if( libbde_aes_af_alg_crypt_request(
+		     context,
+		     mode,
+		     initialization_vector,
+		     &( input_data[ sector_offset ] ),
+		     bytes_per_sector,
+		     &( output_data[ sector_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de- or encrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+		sector_number++;
+	}
+	return( 1 );
+}
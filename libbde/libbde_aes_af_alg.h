@@ -0,0 +1,123 @@
+/*
+ * Linux kernel crypto API (AF_ALG) AES functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_AES_AF_ALG_H )
+#define _LIBBDE_AES_AF_ALG_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LINUX_IF_ALG_H ) && defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SPLICE ) && defined( HAVE_VMSPLICE )
+#define HAVE_LIBBDE_AES_AF_ALG_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_aes_af_alg_context libbde_aes_af_alg_context_t;
+
+struct libbde_aes_af_alg_context
+{
+	/* The algorithm (transformation) socket descriptor
+	 */
+	int algorithm_socket_descriptor;
+
+	/* The operation (request) socket descriptor
+	 */
+	int operation_socket_descriptor;
+
+	/* The pipe descriptors used to splice the input data
+	 * into the operation socket
+	 */
+	int pipe_descriptors[ 2 ];
+
+	/* The cipher mode
+	 */
+	int cipher_mode;
+};
+
+int libbde_aes_af_alg_is_supported(
+     void );
+
+int libbde_aes_af_alg_context_initialize(
+     libbde_aes_af_alg_context_t **context,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_context_free(
+     libbde_aes_af_alg_context_t **context,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_context_set_key(
+     libbde_aes_af_alg_context_t *context,
+     int cipher_mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_crypt_request(
+     libbde_aes_af_alg_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_encrypt_ecb(
+     libbde_aes_af_alg_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_decrypt_cbc(
+     libbde_aes_af_alg_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_af_alg_crypt_xts(
+     libbde_aes_af_alg_context_t *context,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_AES_AF_ALG_H ) */
+
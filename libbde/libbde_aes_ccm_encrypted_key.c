@@ -129,11 +129,6 @@ int libbde_aes_ccm_encrypted_key_free(
 	}
 	if( *aes_ccm_encrypted_key != NULL )
 	{
-		if( ( *aes_ccm_encrypted_key )->data != NULL )
-		{
-			memory_free(
-			 ( *aes_ccm_encrypted_key )->data );
-		}
 		memory_free(
 		 *aes_ccm_encrypted_key );
 
@@ -150,7 +145,7 @@ int libbde_aes_ccm_encrypted_key_read(
      libbde_metadata_entry_t *metadata_entry,
      libcerror_error_t **error )
 {
-	uint8_t *value_data               = NULL;
+	const uint8_t *value_data         = NULL;
 	static char *function             = "libbde_aes_ccm_encrypted_key_read";
 	size_t value_data_size            = 0;
 
@@ -335,54 +330,20 @@ int libbde_aes_ccm_encrypted_key_read(
 		 0 );
 	}
 #endif
-	aes_ccm_encrypted_key->data = (uint8_t *) memory_allocate(
-	                                           sizeof( uint8_t ) * value_data_size );
-
-	if( aes_ccm_encrypted_key->data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_copy(
-	     aes_ccm_encrypted_key->data,
-	     value_data,
-	     value_data_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy data to AES-CCM encrypted key.",
-		 function );
-
-		goto on_error;
-	}
+	aes_ccm_encrypted_key->data      = value_data;
 	aes_ccm_encrypted_key->data_size = value_data_size;
-	
+
 	return( 1 );
 
-on_error:
 #if defined( HAVE_DEBUG_OUTPUT )
+on_error:
 	if( filetime != NULL )
 	{
 		libfdatetime_filetime_free(
 		 &filetime,
 		 NULL );
 	}
-#endif
-	if( aes_ccm_encrypted_key->data != NULL )
-	{
-		memory_free(
-		 aes_ccm_encrypted_key->data );
-
-		aes_ccm_encrypted_key->data = NULL;
-	}
 	return( -1 );
+#endif
 }
 
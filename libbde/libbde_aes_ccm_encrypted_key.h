@@ -41,8 +41,9 @@ struct libbde_aes_ccm_encrypted_key
 	uint8_t nonce[ 12 ];
 
 	/* The (encrypted) data
+	 * references the metadata entry value data
 	 */
-	uint8_t *data;
+	const uint8_t *data;
 
 	/* The (encrypted) data size
 	 */
@@ -0,0 +1,884 @@
+/*
+ * OpenSSL EVP AES functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_aes_evp.h"
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+
+/* Determines if OpenSSL EVP AES support is available
+ * Returns 1 if available or 0 if not
+ */
+int libbde_aes_evp_is_supported(
+     void )
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Creates an OpenSSL EVP AES context
+ * Make sure the value context is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_context_initialize(
+     libbde_aes_evp_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_evp_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid context value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	*context = memory_allocate_structure(
+	            libbde_aes_evp_context_t );
+
+	if( *context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create context.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *context,
+	     0,
+	     sizeof( libbde_aes_evp_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		memory_free(
+		 *context );
+
+		*context = NULL;
+
+		return( -1 );
+	}
+	( *context )->cipher_context = EVP_CIPHER_CTX_new();
+
+	if( ( *context )->cipher_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create cipher context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *context != NULL )
+	{
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( -1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: OpenSSL EVP is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_EVP_SUPPORT ) */
+}
+
+/* Frees an OpenSSL EVP AES context
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_context_free(
+     libbde_aes_evp_context_t **context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_evp_context_free";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *context != NULL )
+	{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+		if( ( *context )->cipher_context != NULL )
+		{
+			/* Also clears the key schedule
+			 */
+			EVP_CIPHER_CTX_free(
+			 ( *context )->cipher_context );
+		}
+#endif
+		memory_free(
+		 *context );
+
+		*context = NULL;
+	}
+	return( 1 );
+}
+
+/* Sets the key of an OpenSSL EVP AES context
+ * For AES-XTS the key consists of the data key followed by the tweak key
+ * and the key bit size is the size of both keys
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_context_set_key(
+     libbde_aes_evp_context_t *context,
+     int cipher_mode,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	const EVP_CIPHER *cipher = NULL;
+#endif
+	static char *function    = "libbde_aes_evp_context_set_key";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_ECB )
+	 && ( cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_CBC )
+	 && ( cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_XTS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( cipher_mode == LIBBDE_AES_EVP_CIPHER_MODE_XTS )
+	{
+		if( ( key_bit_size != 256 )
+		 && ( key_bit_size != 512 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported key bit size.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( ( key_bit_size != 128 )
+	      && ( key_bit_size != 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	if( cipher_mode == LIBBDE_AES_EVP_CIPHER_MODE_ECB )
+	{
+		if( key_bit_size == 128 )
+		{
+			cipher = EVP_aes_128_ecb();
+		}
+		else
+		{
+			cipher = EVP_aes_256_ecb();
+		}
+	}
+	else if( cipher_mode == LIBBDE_AES_EVP_CIPHER_MODE_CBC )
+	{
+		if( key_bit_size == 128 )
+		{
+			cipher = EVP_aes_128_cbc();
+		}
+		else
+		{
+			cipher = EVP_aes_256_cbc();
+		}
+	}
+	else
+	{
+		if( key_bit_size == 256 )
+		{
+			cipher = EVP_aes_128_xts();
+		}
+		else
+		{
+			cipher = EVP_aes_256_xts();
+		}
+	}
+	if( EVP_CipherInit_ex(
+	     context->cipher_context,
+	     cipher,
+	     NULL,
+	     key,
+	     NULL,
+	     ( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) ? 1 : 0 ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in cipher context.",
+		 function );
+
+		return( -1 );
+	}
+	if( EVP_CIPHER_CTX_set_padding(
+	     context->cipher_context,
+	     0 ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to disable padding in cipher context.",
+		 function );
+
+		return( -1 );
+	}
+	context->cipher_mode = cipher_mode;
+	context->mode        = mode;
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: OpenSSL EVP is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_EVP_SUPPORT ) */
+}
+
+/* Encrypts independent blocks using AES-ECB
+ * The input data size must be a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_encrypt_ecb(
+     libbde_aes_evp_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	int output_length     = 0;
+#endif
+	static char *function = "libbde_aes_evp_encrypt_ecb";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_ECB )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( input_data_size > (size_t) INT_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	if( EVP_CipherUpdate(
+	     context->cipher_context,
+	     output_data,
+	     &output_length,
+	     input_data,
+	     (int) input_data_size ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt blocks.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_length != (int) input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: OpenSSL EVP is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_EVP_SUPPORT ) */
+}
+
+/* Decrypts sectors using AES-CBC
+ * Every sector is decrypted with its own initialization vector, the key
+ * schedule of the cipher context is reused for all sectors
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_decrypt_cbc(
+     libbde_aes_evp_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	size_t sector_offset  = 0;
+	size_t vector_offset  = 0;
+	int output_length     = 0;
+#endif
+	static char *function = "libbde_aes_evp_decrypt_cbc";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_CBC )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) INT_MAX )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( ( input_data_size / bytes_per_sector ) * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		if( EVP_CipherInit_ex(
+		     context->cipher_context,
+		     NULL,
+		     NULL,
+		     NULL,
+		     &( initialization_vectors[ vector_offset ] ),
+		     -1 ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to set initialization vector in cipher context.",
+			 function );
+
+			return( -1 );
+		}
+		if( EVP_CipherUpdate(
+		     context->cipher_context,
+		     &( output_data[ sector_offset ] ),
+		     &output_length,
+		     &( input_data[ sector_offset ] ),
+		     (int) bytes_per_sector ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+		if( output_length != (int) bytes_per_sector )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid output length value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		vector_offset += 16;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: OpenSSL EVP is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_EVP_SUPPORT ) */
+}
+
+/* De- or encrypts sectors using AES-XTS
+ * The initialization vector of every sector is the 128-bit little-endian
+ * sector number, the key schedule of the cipher context is reused for all sectors
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_evp_crypt_xts(
+     libbde_aes_evp_context_t *context,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	uint8_t initialization_vector[ 16 ];
+
+	size_t sector_offset  = 0;
+	int output_length     = 0;
+#endif
+	static char *function = "libbde_aes_evp_crypt_xts";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->cipher_mode != LIBBDE_AES_EVP_CIPHER_MODE_XTS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: invalid context - unsupported cipher mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( bytes_per_sector > (size_t) INT_MAX )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	if( memory_set(
+	     initialization_vector,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 initialization_vector,
+		 sector_number );
+
+		if( EVP_CipherInit_ex(
+		     context->cipher_context,
+		     NULL,
+		     NULL,
+		     NULL,
+		     initialization_vector,
+		     -1 ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to set initialization vector in cipher context.",
+			 function );
+
+			return( -1 );
+		}
+		if( EVP_CipherUpdate(
+		     context->cipher_context,
+		     &( output_data[ sector_offset ] ),
+		     &output_length,
+		     &( input_data[ sector_offset ] ),
+		     (int) bytes_per_sector ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de- or encrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+		if( output_length != (int) bytes_per_sector )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid output length value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		sector_number++;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: OpenSSL EVP is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_EVP_SUPPORT ) */
+}
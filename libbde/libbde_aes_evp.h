@@ -0,0 +1,112 @@
+/*
+ * OpenSSL EVP AES functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_AES_EVP_H )
+#define _LIBBDE_AES_EVP_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LIBCRYPTO ) && defined( HAVE_OPENSSL_EVP_H )
+#include <openssl/evp.h>
+
+#define HAVE_LIBBDE_AES_EVP_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_aes_evp_context libbde_aes_evp_context_t;
+
+struct libbde_aes_evp_context
+{
+#if defined( HAVE_LIBBDE_AES_EVP_SUPPORT )
+	/* The cipher context
+	 */
+	EVP_CIPHER_CTX *cipher_context;
+#endif
+
+	/* The cipher mode
+	 */
+	int cipher_mode;
+
+	/* The crypt mode
+	 */
+	int mode;
+};
+
+int libbde_aes_evp_is_supported(
+     void );
+
+int libbde_aes_evp_context_initialize(
+     libbde_aes_evp_context_t **context,
+     libcerror_error_t **error );
+
+int libbde_aes_evp_context_free(
+     libbde_aes_evp_context_t **context,
+     libcerror_error_t **error );
+
+int libbde_aes_evp_context_set_key(
+     libbde_aes_evp_context_t *context,
+     int cipher_mode,
+     int mode,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libbde_aes_evp_encrypt_ecb(
+     libbde_aes_evp_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_evp_decrypt_cbc(
+     libbde_aes_evp_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_evp_crypt_xts(
+     libbde_aes_evp_context_t *context,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_AES_EVP_H ) */
+
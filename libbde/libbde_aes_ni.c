@@ -0,0 +1,1037 @@
+/*
+ * AES-NI functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_aes_ni.h"
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#define LIBBDE_AES_NI_TARGET		__attribute__(( target( "aes,sse2" ) ))
+
+/* The number of blocks that are de- or encrypted in parallel,
+ * which hides the latency of the AES round instructions
+ */
+#define LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS	8
+
+/* Computes the next AES-128 round key
+ */
+#define libbde_aes_ni_expand_key_128( round_keys, round_index, round_constant ) \
+	key_generation = _mm_shuffle_epi32( \
+	                  _mm_aeskeygenassist_si128( round_keys[ round_index - 1 ], round_constant ), \
+	                  0xff ); \
+	round_key      = round_keys[ round_index - 1 ]; \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 8 ) ); \
+	round_keys[ round_index ] = _mm_xor_si128( round_key, key_generation );
+
+/* Computes the next even AES-256 round key
+ */
+#define libbde_aes_ni_expand_key_256_even( round_keys, round_index, round_constant ) \
+	key_generation = _mm_shuffle_epi32( \
+	                  _mm_aeskeygenassist_si128( round_keys[ round_index - 1 ], round_constant ), \
+	                  0xff ); \
+	round_key      = round_keys[ round_index - 2 ]; \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 8 ) ); \
+	round_keys[ round_index ] = _mm_xor_si128( round_key, key_generation );
+
+/* Computes the next odd AES-256 round key
+ */
+#define libbde_aes_ni_expand_key_256_odd( round_keys, round_index ) \
+	key_generation = _mm_shuffle_epi32( \
+	                  _mm_aeskeygenassist_si128( round_keys[ round_index - 1 ], 0x00 ), \
+	                  0xaa ); \
+	round_key      = round_keys[ round_index - 2 ]; \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 4 ) ); \
+	round_key      = _mm_xor_si128( round_key, _mm_slli_si128( round_key, 8 ) ); \
+	round_keys[ round_index ] = _mm_xor_si128( round_key, key_generation );
+
+/* Multiplies a XTS tweak by the primitive element alpha in GF(2^128)
+ * Every 32-bit lane is shifted left by 1, where the carry of a lane is moved
+ * into the next lane and the carry of the last lane is reduced by 0x87
+ */
+#define libbde_aes_ni_xts_multiply_alpha( tweak ) \
+	_mm_xor_si128( \
+	 _mm_slli_epi32( tweak, 1 ), \
+	 _mm_shuffle_epi32( \
+	  _mm_and_si128( \
+	   _mm_srai_epi32( tweak, 31 ), \
+	   alpha_mask ), \
+	  0x93 ) )
+
+#endif /* defined( HAVE_LIBBDE_AES_NI_SUPPORT ) */
+
+/* Determines if the CPU supports the AES-NI instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_aes_ni_is_supported(
+     void )
+{
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( ecx & bit_AES ) == 0 )
+	 || ( ( edx & bit_SSE2 ) == 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Sets the key of an AES-NI key schedule
+ * Make sure to check libbde_aes_ni_is_supported before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+LIBBDE_AES_NI_TARGET
+#endif
+int libbde_aes_ni_key_schedule_set_key(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	__m128i round_keys[ 15 ];
+
+	__m128i key_generation = _mm_setzero_si128();
+	__m128i round_key      = _mm_setzero_si128();
+	int round_index        = 0;
+#endif
+	static char *function  = "libbde_aes_ni_key_schedule_set_key";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_bit_size != 128 )
+	 && ( key_bit_size != 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	round_keys[ 0 ] = _mm_loadu_si128(
+	                   (__m128i *) key );
+
+	if( key_bit_size == 128 )
+	{
+		libbde_aes_ni_expand_key_128( round_keys, 1, 0x01 )
+		libbde_aes_ni_expand_key_128( round_keys, 2, 0x02 )
+		libbde_aes_ni_expand_key_128( round_keys, 3, 0x04 )
+		libbde_aes_ni_expand_key_128( round_keys, 4, 0x08 )
+		libbde_aes_ni_expand_key_128( round_keys, 5, 0x10 )
+		libbde_aes_ni_expand_key_128( round_keys, 6, 0x20 )
+		libbde_aes_ni_expand_key_128( round_keys, 7, 0x40 )
+		libbde_aes_ni_expand_key_128( round_keys, 8, 0x80 )
+		libbde_aes_ni_expand_key_128( round_keys, 9, 0x1b )
+		libbde_aes_ni_expand_key_128( round_keys, 10, 0x36 )
+
+		key_schedule->number_of_rounds = 10;
+	}
+	else
+	{
+		round_keys[ 1 ] = _mm_loadu_si128(
+		                   (__m128i *) &( key[ 16 ] ) );
+
+		libbde_aes_ni_expand_key_256_even( round_keys, 2, 0x01 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 3 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 4, 0x02 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 5 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 6, 0x04 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 7 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 8, 0x08 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 9 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 10, 0x10 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 11 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 12, 0x20 )
+		libbde_aes_ni_expand_key_256_odd( round_keys, 13 )
+		libbde_aes_ni_expand_key_256_even( round_keys, 14, 0x40 )
+
+		key_schedule->number_of_rounds = 14;
+	}
+	/* The decryption round keys are the encryption round keys in reverse order,
+	 * where the inner round keys are transformed by InvMixColumns
+	 */
+	for( round_index = 0;
+	     round_index <= key_schedule->number_of_rounds;
+	     round_index++ )
+	{
+		_mm_storeu_si128(
+		 (__m128i *) &( key_schedule->encryption_round_keys[ round_index * 16 ] ),
+		 round_keys[ round_index ] );
+
+		if( ( round_index == 0 )
+		 || ( round_index == key_schedule->number_of_rounds ) )
+		{
+			round_key = round_keys[ key_schedule->number_of_rounds - round_index ];
+		}
+		else
+		{
+			round_key = _mm_aesimc_si128(
+			             round_keys[ key_schedule->number_of_rounds - round_index ] );
+		}
+		_mm_storeu_si128(
+		 (__m128i *) &( key_schedule->decryption_round_keys[ round_index * 16 ] ),
+		 round_key );
+	}
+	/* Do not leave key material on the stack
+	 */
+	for( round_index = 0;
+	     round_index < 15;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm_setzero_si128();
+	}
+	key_generation = _mm_setzero_si128();
+	round_key      = _mm_setzero_si128();
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_NI_SUPPORT ) */
+}
+
+/* Encrypts independent blocks using AES-ECB
+ * The blocks are encrypted 8 at a time with interleaved AES rounds
+ * The input data size must be a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+LIBBDE_AES_NI_TARGET
+#endif
+int libbde_aes_ni_encrypt_ecb(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i round_keys[ 15 ];
+
+	size_t data_offset    = 0;
+	int block_index       = 0;
+	int number_of_rounds  = 0;
+	int round_index       = 0;
+#endif
+	static char *function = "libbde_aes_ni_encrypt_ecb";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm_loadu_si128(
+		                             (__m128i *) &( key_schedule->encryption_round_keys[ round_index * 16 ] ) );
+	}
+	while( ( data_offset + ( LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16 ) ) <= input_data_size )
+	{
+		for( block_index = 0;
+		     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+		     block_index++ )
+		{
+			blocks[ block_index ] = _mm_xor_si128(
+			                         _mm_loadu_si128(
+			                          (__m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) ),
+			                         round_keys[ 0 ] );
+		}
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			for( block_index = 0;
+			     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			     block_index++ )
+			{
+				blocks[ block_index ] = _mm_aesenc_si128(
+				                         blocks[ block_index ],
+				                         round_keys[ round_index ] );
+			}
+		}
+		for( block_index = 0;
+		     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+		     block_index++ )
+		{
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+			 _mm_aesenclast_si128(
+			  blocks[ block_index ],
+			  round_keys[ number_of_rounds ] ) );
+		}
+		data_offset += LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16;
+	}
+	while( data_offset < input_data_size )
+	{
+		blocks[ 0 ] = _mm_xor_si128(
+		               _mm_loadu_si128(
+		                (__m128i *) &( input_data[ data_offset ] ) ),
+		               round_keys[ 0 ] );
+
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			blocks[ 0 ] = _mm_aesenc_si128(
+			               blocks[ 0 ],
+			               round_keys[ round_index ] );
+		}
+		_mm_storeu_si128(
+		 (__m128i *) &( output_data[ data_offset ] ),
+		 _mm_aesenclast_si128(
+		  blocks[ 0 ],
+		  round_keys[ number_of_rounds ] ) );
+
+		data_offset += 16;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_NI_SUPPORT ) */
+}
+
+/* Decrypts sectors using AES-CBC
+ * Every sector is decrypted with its own initialization vector. Since every
+ * plaintext block only depends on two ciphertext blocks the blocks of a sector
+ * are decrypted 8 at a time with interleaved AES rounds
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+LIBBDE_AES_NI_TARGET
+#endif
+int libbde_aes_ni_decrypt_cbc(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i encrypted_blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i round_keys[ 15 ];
+
+	__m128i previous_block = _mm_setzero_si128();
+	size_t block_offset    = 0;
+	size_t sector_offset   = 0;
+	size_t vector_offset   = 0;
+	int block_index        = 0;
+	int number_of_rounds   = 0;
+	int round_index        = 0;
+#endif
+	static char *function  = "libbde_aes_ni_decrypt_cbc";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( ( input_data_size / bytes_per_sector ) * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = _mm_loadu_si128(
+		                             (__m128i *) &( key_schedule->decryption_round_keys[ round_index * 16 ] ) );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		previous_block = _mm_loadu_si128(
+		                  (__m128i *) &( initialization_vectors[ vector_offset ] ) );
+
+		vector_offset += 16;
+		block_offset   = 0;
+
+		/* The encrypted blocks are loaded before any block is stored
+		 * so that the data can be decrypted in-place
+		 */
+		while( ( block_offset + ( LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16 ) ) <= bytes_per_sector )
+		{
+			for( block_index = 0;
+			     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			     block_index++ )
+			{
+				encrypted_blocks[ block_index ] = _mm_loadu_si128(
+				                                   (__m128i *) &( input_data[ sector_offset + block_offset + ( block_index * 16 ) ] ) );
+
+				blocks[ block_index ] = _mm_xor_si128(
+				                         encrypted_blocks[ block_index ],
+				                         round_keys[ 0 ] );
+			}
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				for( block_index = 0;
+				     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+				     block_index++ )
+				{
+					blocks[ block_index ] = _mm_aesdec_si128(
+					                         blocks[ block_index ],
+					                         round_keys[ round_index ] );
+				}
+			}
+			for( block_index = 0;
+			     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			     block_index++ )
+			{
+				blocks[ block_index ] = _mm_aesdeclast_si128(
+				                         blocks[ block_index ],
+				                         round_keys[ number_of_rounds ] );
+
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ sector_offset + block_offset + ( block_index * 16 ) ] ),
+				 _mm_xor_si128(
+				  blocks[ block_index ],
+				  previous_block ) );
+
+				previous_block = encrypted_blocks[ block_index ];
+			}
+			block_offset += LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16;
+		}
+		while( block_offset < bytes_per_sector )
+		{
+			encrypted_blocks[ 0 ] = _mm_loadu_si128(
+			                         (__m128i *) &( input_data[ sector_offset + block_offset ] ) );
+
+			blocks[ 0 ] = _mm_xor_si128(
+			               encrypted_blocks[ 0 ],
+			               round_keys[ 0 ] );
+
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				blocks[ 0 ] = _mm_aesdec_si128(
+				               blocks[ 0 ],
+				               round_keys[ round_index ] );
+			}
+			blocks[ 0 ] = _mm_aesdeclast_si128(
+			               blocks[ 0 ],
+			               round_keys[ number_of_rounds ] );
+
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ sector_offset + block_offset ] ),
+			 _mm_xor_si128(
+			  blocks[ 0 ],
+			  previous_block ) );
+
+			previous_block = encrypted_blocks[ 0 ];
+
+			block_offset += 16;
+		}
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_NI_SUPPORT ) */
+}
+
+/* De- or encrypts sectors using AES-XTS
+ * The tweak of every sector is the encrypted sector number, of which the tweaks
+ * of the consecutive blocks are computed incrementally. The blocks are de- or
+ * encrypted 8 at a time with interleaved AES rounds
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+LIBBDE_AES_NI_TARGET
+#endif
+int libbde_aes_ni_crypt_xts(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     libbde_aes_ni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i round_keys[ 15 ];
+	__m128i tweak_round_keys[ 15 ];
+	__m128i tweaks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+
+	__m128i alpha_mask    = _mm_set_epi32( 0x87, 1, 1, 1 );
+	__m128i tweak         = _mm_setzero_si128();
+	size_t block_offset   = 0;
+	size_t sector_offset  = 0;
+	int block_index       = 0;
+	int number_of_rounds  = 0;
+	int round_index       = 0;
+#endif
+	static char *function = "libbde_aes_ni_crypt_xts";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key_schedule->number_of_rounds != key_schedule->number_of_rounds )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid tweak key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+		{
+			round_keys[ round_index ] = _mm_loadu_si128(
+			                             (__m128i *) &( key_schedule->decryption_round_keys[ round_index * 16 ] ) );
+		}
+		else
+		{
+			round_keys[ round_index ] = _mm_loadu_si128(
+			                             (__m128i *) &( key_schedule->encryption_round_keys[ round_index * 16 ] ) );
+		}
+		tweak_round_keys[ round_index ] = _mm_loadu_si128(
+		                                   (__m128i *) &( tweak_key_schedule->encryption_round_keys[ round_index * 16 ] ) );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		/* The tweak is the encrypted 128-bit little-endian sector number
+		 */
+		tweak = _mm_xor_si128(
+		         _mm_set_epi64x( 0, (long long) sector_number ),
+		         tweak_round_keys[ 0 ] );
+
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			tweak = _mm_aesenc_si128(
+			         tweak,
+			         tweak_round_keys[ round_index ] );
+		}
+		tweak = _mm_aesenclast_si128(
+		         tweak,
+		         tweak_round_keys[ number_of_rounds ] );
+
+		block_offset = 0;
+
+		while( ( block_offset + ( LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16 ) ) <= bytes_per_sector )
+		{
+			for( block_index = 0;
+			     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			     block_index++ )
+			{
+				tweaks[ block_index ] = tweak;
+				tweak                 = libbde_aes_ni_xts_multiply_alpha( tweak );
+
+				blocks[ block_index ] = _mm_xor_si128(
+				                         _mm_loadu_si128(
+				                          (__m128i *) &( input_data[ sector_offset + block_offset + ( block_index * 16 ) ] ) ),
+				                         _mm_xor_si128(
+				                          tweaks[ block_index ],
+				                          round_keys[ 0 ] ) );
+			}
+			if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+			{
+				for( round_index = 1;
+				     round_index < number_of_rounds;
+				     round_index++ )
+				{
+					for( block_index = 0;
+					     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+					     block_index++ )
+					{
+						blocks[ block_index ] = _mm_aesdec_si128(
+						                         blocks[ block_index ],
+						                         round_keys[ round_index ] );
+					}
+				}
+				for( block_index = 0;
+				     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+				     block_index++ )
+				{
+					blocks[ block_index ] = _mm_aesdeclast_si128(
+					                         blocks[ block_index ],
+					                         round_keys[ number_of_rounds ] );
+				}
+			}
+			else
+			{
+				for( round_index = 1;
+				     round_index < number_of_rounds;
+				     round_index++ )
+				{
+					for( block_index = 0;
+					     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+					     block_index++ )
+					{
+						blocks[ block_index ] = _mm_aesenc_si128(
+						                         blocks[ block_index ],
+						                         round_keys[ round_index ] );
+					}
+				}
+				for( block_index = 0;
+				     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+				     block_index++ )
+				{
+					blocks[ block_index ] = _mm_aesenclast_si128(
+					                         blocks[ block_index ],
+					                         round_keys[ number_of_rounds ] );
+				}
+			}
+			for( block_index = 0;
+			     block_index < LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			     block_index++ )
+			{
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ sector_offset + block_offset + ( block_index * 16 ) ] ),
+				 _mm_xor_si128(
+				  blocks[ block_index ],
+				  tweaks[ block_index ] ) );
+			}
+			block_offset += LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS * 16;
+		}
+		/* De- or encrypt the remaining blocks of sectors that are not
+		 * a multiple of the parallel blocks size one at a time
+		 */
+		while( block_offset < bytes_per_sector )
+		{
+			blocks[ 0 ] = _mm_xor_si128(
+			               _mm_loadu_si128(
+			                (__m128i *) &( input_data[ sector_offset + block_offset ] ) ),
+			               _mm_xor_si128(
+			                tweak,
+			                round_keys[ 0 ] ) );
+
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+				{
+					blocks[ 0 ] = _mm_aesdec_si128(
+					               blocks[ 0 ],
+					               round_keys[ round_index ] );
+				}
+				else
+				{
+					blocks[ 0 ] = _mm_aesenc_si128(
+					               blocks[ 0 ],
+					               round_keys[ round_index ] );
+				}
+			}
+			if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+			{
+				blocks[ 0 ] = _mm_aesdeclast_si128(
+				               blocks[ 0 ],
+				               round_keys[ number_of_rounds ] );
+			}
+			else
+			{
+				blocks[ 0 ] = _mm_aesenclast_si128(
+				               blocks[ 0 ],
+				               round_keys[ number_of_rounds ] );
+			}
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ sector_offset + block_offset ] ),
+			 _mm_xor_si128(
+			  blocks[ 0 ],
+			  tweak ) );
+
+			tweak = libbde_aes_ni_xts_multiply_alpha( tweak );
+
+			block_offset += 16;
+		}
+		sector_number++;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: AES-NI is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_NI_SUPPORT ) */
+}
+
@@ -0,0 +1,104 @@
+/*
+ * AES-NI functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBBDE_AES_NI_H )
+#define _LIBBDE_AES_NI_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+/* The AES-NI functions are build using function specific target attributes,
+ * so that no additional compiler flags are needed
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_LIBBDE_AES_NI_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_aes_ni_key_schedule libbde_aes_ni_key_schedule_t;
+
+struct libbde_aes_ni_key_schedule
+{
+	/* The encryption round keys
+	 */
+	uint8_t encryption_round_keys[ 15 * 16 ];
+
+	/* The decryption round keys
+	 */
+	uint8_t decryption_round_keys[ 15 * 16 ];
+
+	/* The number of rounds
+	 */
+	int number_of_rounds;
+};
+
+int libbde_aes_ni_is_supported(
+     void );
+
+int libbde_aes_ni_key_schedule_set_key(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_encrypt_ecb(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_decrypt_cbc(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_crypt_xts(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     libbde_aes_ni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_AES_NI_H ) */
+
@@ -0,0 +1,961 @@
+/*
+ * VAES (AVX-512) functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_aes_ni.h"
+#include "libbde_aes_vaes.h"
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+
+#include <cpuid.h>
+#include <immintrin.h>
+
+#define LIBBDE_AES_VAES_TARGET		__attribute__(( target( "aes,sse2,avx512f,vaes" ) ))
+
+/* The number of 512-bit vectors of 4 blocks that are de- or encrypted
+ * in parallel, which hides the latency of the AES round instructions
+ */
+#define LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS	4
+
+/* Multiplies the XTS tweaks in the 128-bit lanes of a vector by the primitive
+ * element alpha in GF(2^128) to the power of the shift counts of the lanes
+ * The 64-bit values are shifted left, where the carry of the lower value is
+ * moved into the upper value and the carry of the upper value is reduced by
+ * 0x87 into the lower value
+ */
+#define libbde_aes_vaes_xts_multiply_alpha_power( tweaks, shift_counts, carry_shift_counts ) \
+	carries = _mm512_shuffle_epi32( \
+	           _mm512_srlv_epi64( tweaks, carry_shift_counts ), \
+	           (_MM_PERM_ENUM) 0x4e ); \
+	tweaks  = _mm512_xor_si512( \
+	           _mm512_sllv_epi64( tweaks, shift_counts ), \
+	           _mm512_mask_blend_epi64( \
+	            0x55, \
+	            carries, \
+	            _mm512_xor_si512( \
+	             _mm512_xor_si512( \
+	              carries, \
+	              _mm512_slli_epi64( carries, 1 ) ), \
+	             _mm512_xor_si512( \
+	              _mm512_slli_epi64( carries, 2 ), \
+	              _mm512_slli_epi64( carries, 7 ) ) ) ) );
+
+/* Loads a 128-bit round key into all the lanes of a vector
+ */
+#define libbde_aes_vaes_load_round_key( round_keys_data, round_index ) \
+	_mm512_broadcast_i32x4( \
+	 _mm_loadu_si128( \
+	  (__m128i *) &( round_keys_data[ round_index * 16 ] ) ) )
+
+#endif /* defined( HAVE_LIBBDE_AES_VAES_SUPPORT ) */
+
+/* Determines if the CPU and operating system support the VAES and AVX-512
+ * instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_aes_vaes_is_supported(
+     void )
+{
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	unsigned int eax       = 0;
+	unsigned int ebx       = 0;
+	unsigned int ecx       = 0;
+	unsigned int edx       = 0;
+	unsigned int xcr0_low  = 0;
+	unsigned int xcr0_high = 0;
+
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ecx & bit_OSXSAVE ) == 0 )
+	{
+		return( 0 );
+	}
+	/* The operating system must save the AVX-512 state, which consists
+	 * of the SSE, AVX, opmask and upper ZMM registers (XCR0 bits 1, 2, 5, 6 and 7)
+	 */
+	__asm__ __volatile__(
+	 "xgetbv"
+	 : "=a" ( xcr0_low ), "=d" ( xcr0_high )
+	 : "c" ( 0 ) );
+
+	if( ( xcr0_low & 0xe6 ) != 0xe6 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ( ebx & bit_AVX512F ) == 0 )
+	 || ( ( ecx & bit_VAES ) == 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Encrypts independent blocks using AES-ECB
+ * The blocks are encrypted 16 at a time, 4 blocks per 512-bit vector
+ * The input data size must be a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+LIBBDE_AES_VAES_TARGET
+#endif
+int libbde_aes_vaes_encrypt_ecb(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	__m512i round_keys[ 15 ];
+	__m512i vectors[ LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS ];
+
+	size_t data_offset    = 0;
+	int number_of_rounds  = 0;
+	int round_index       = 0;
+	int vector_index      = 0;
+#endif
+	static char *function = "libbde_aes_vaes_encrypt_ecb";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = libbde_aes_vaes_load_round_key(
+		                             key_schedule->encryption_round_keys,
+		                             round_index );
+	}
+	while( ( data_offset + ( LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64 ) ) <= input_data_size )
+	{
+		for( vector_index = 0;
+		     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+		     vector_index++ )
+		{
+			vectors[ vector_index ] = _mm512_xor_si512(
+			                           _mm512_loadu_si512(
+			                            &( input_data[ data_offset + ( vector_index * 64 ) ] ) ),
+			                           round_keys[ 0 ] );
+		}
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			for( vector_index = 0;
+			     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+			     vector_index++ )
+			{
+				vectors[ vector_index ] = _mm512_aesenc_epi128(
+				                           vectors[ vector_index ],
+				                           round_keys[ round_index ] );
+			}
+		}
+		for( vector_index = 0;
+		     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+		     vector_index++ )
+		{
+			_mm512_storeu_si512(
+			 &( output_data[ data_offset + ( vector_index * 64 ) ] ),
+			 _mm512_aesenclast_epi128(
+			  vectors[ vector_index ],
+			  round_keys[ number_of_rounds ] ) );
+		}
+		data_offset += LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64;
+	}
+	/* Encrypt the remaining blocks one at a time in the first lane of a vector
+	 */
+	while( data_offset < input_data_size )
+	{
+		vectors[ 0 ] = _mm512_xor_si512(
+		                _mm512_castsi128_si512(
+		                 _mm_loadu_si128(
+		                  (__m128i *) &( input_data[ data_offset ] ) ) ),
+		                round_keys[ 0 ] );
+
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			vectors[ 0 ] = _mm512_aesenc_epi128(
+			                vectors[ 0 ],
+			                round_keys[ round_index ] );
+		}
+		_mm_storeu_si128(
+		 (__m128i *) &( output_data[ data_offset ] ),
+		 _mm512_castsi512_si128(
+		  _mm512_aesenclast_epi128(
+		   vectors[ 0 ],
+		   round_keys[ number_of_rounds ] ) ) );
+
+		data_offset += 16;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: VAES is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_VAES_SUPPORT ) */
+}
+
+/* Decrypts sectors using AES-CBC
+ * Every sector is decrypted with its own initialization vector. Since every
+ * plaintext block only depends on two ciphertext blocks the blocks of a sector
+ * are decrypted 16 at a time, 4 blocks per 512-bit vector
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+LIBBDE_AES_VAES_TARGET
+#endif
+int libbde_aes_vaes_decrypt_cbc(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	__m512i encrypted_vectors[ LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS ];
+	__m512i round_keys[ 15 ];
+	__m512i vectors[ LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS ];
+
+	__m512i previous_vector = _mm512_setzero_si512();
+	size_t block_offset     = 0;
+	size_t sector_offset    = 0;
+	size_t vector_offset    = 0;
+	int number_of_rounds    = 0;
+	int round_index         = 0;
+	int vector_index        = 0;
+#endif
+	static char *function   = "libbde_aes_vaes_decrypt_cbc";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( ( input_data_size / bytes_per_sector ) * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		round_keys[ round_index ] = libbde_aes_vaes_load_round_key(
+		                             key_schedule->decryption_round_keys,
+		                             round_index );
+	}
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		/* The previous encrypted block is kept in the last lane
+		 * of the previous vector
+		 */
+		previous_vector = _mm512_broadcast_i32x4(
+		                   _mm_loadu_si128(
+		                    (__m128i *) &( initialization_vectors[ vector_offset ] ) ) );
+
+		vector_offset += 16;
+		block_offset   = 0;
+
+		/* The encrypted blocks are loaded before any block is stored
+		 * so that the data can be decrypted in-place
+		 */
+		while( ( block_offset + ( LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64 ) ) <= bytes_per_sector )
+		{
+			for( vector_index = 0;
+			     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+			     vector_index++ )
+			{
+				encrypted_vectors[ vector_index ] = _mm512_loadu_si512(
+				                                     &( input_data[ sector_offset + block_offset + ( vector_index * 64 ) ] ) );
+
+				vectors[ vector_index ] = _mm512_xor_si512(
+				                           encrypted_vectors[ vector_index ],
+				                           round_keys[ 0 ] );
+			}
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				for( vector_index = 0;
+				     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+				     vector_index++ )
+				{
+					vectors[ vector_index ] = _mm512_aesdec_epi128(
+					                           vectors[ vector_index ],
+					                           round_keys[ round_index ] );
+				}
+			}
+			for( vector_index = 0;
+			     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+			     vector_index++ )
+			{
+				/* The encrypted blocks preceding the blocks of the vector are
+				 * the last block of the previous vector and the first 3 blocks
+				 * of the vector
+				 */
+				_mm512_storeu_si512(
+				 &( output_data[ sector_offset + block_offset + ( vector_index * 64 ) ] ),
+				 _mm512_xor_si512(
+				  _mm512_aesdeclast_epi128(
+				   vectors[ vector_index ],
+				   round_keys[ number_of_rounds ] ),
+				  _mm512_alignr_epi64(
+				   encrypted_vectors[ vector_index ],
+				   previous_vector,
+				   6 ) ) );
+
+				previous_vector = encrypted_vectors[ vector_index ];
+			}
+			block_offset += LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64;
+		}
+		/* Decrypt the remaining blocks one at a time in the first lane of a vector
+		 */
+		while( block_offset < bytes_per_sector )
+		{
+			encrypted_vectors[ 0 ] = _mm512_castsi128_si512(
+			                          _mm_loadu_si128(
+			                           (__m128i *) &( input_data[ sector_offset + block_offset ] ) ) );
+
+			vectors[ 0 ] = _mm512_xor_si512(
+			                encrypted_vectors[ 0 ],
+			                round_keys[ 0 ] );
+
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				vectors[ 0 ] = _mm512_aesdec_epi128(
+				                vectors[ 0 ],
+				                round_keys[ round_index ] );
+			}
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ sector_offset + block_offset ] ),
+			 _mm512_castsi512_si128(
+			  _mm512_xor_si512(
+			   _mm512_aesdeclast_epi128(
+			    vectors[ 0 ],
+			    round_keys[ number_of_rounds ] ),
+			   _mm512_alignr_epi64(
+			    encrypted_vectors[ 0 ],
+			    previous_vector,
+			    6 ) ) ) );
+
+			previous_vector = _mm512_broadcast_i32x4(
+			                   _mm512_castsi512_si128(
+			                    encrypted_vectors[ 0 ] ) );
+
+			block_offset += 16;
+		}
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: VAES is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_VAES_SUPPORT ) */
+}
+
+/* De- or encrypts sectors using AES-XTS
+ * The tweak of every sector is the encrypted sector number, of which the tweaks
+ * of the consecutive blocks are computed 4 at a time. The blocks are de- or
+ * encrypted 16 at a time, 4 blocks per 512-bit vector
+ * The input data size must be a multiple of the bytes per sector, which must be
+ * a multiple of the AES block size
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+LIBBDE_AES_VAES_TARGET
+#endif
+int libbde_aes_vaes_crypt_xts(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     libbde_aes_ni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	__m512i round_keys[ 15 ];
+	__m512i tweak_round_keys[ 15 ];
+	__m512i tweak_vectors[ LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS ];
+	__m512i vectors[ LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS ];
+
+	__m512i carries                 = _mm512_setzero_si512();
+	__m512i carry_shift_counts      = _mm512_setzero_si512();
+	__m512i lane_shift_counts       = _mm512_setzero_si512();
+	__m512i lane_carry_shift_counts = _mm512_setzero_si512();
+	__m512i shift_counts            = _mm512_setzero_si512();
+	__m512i tweaks                  = _mm512_setzero_si512();
+	size_t block_offset             = 0;
+	size_t sector_offset            = 0;
+	int number_of_rounds            = 0;
+	int round_index                 = 0;
+	int vector_index                = 0;
+#endif
+	static char *function           = "libbde_aes_vaes_crypt_xts";
+
+	if( key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key_schedule == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key schedule.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( key_schedule->number_of_rounds != 10 )
+	 && ( key_schedule->number_of_rounds != 14 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key_schedule->number_of_rounds != key_schedule->number_of_rounds )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid tweak key schedule - number of rounds value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( bytes_per_sector % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_VAES_SUPPORT )
+	number_of_rounds = key_schedule->number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+		{
+			round_keys[ round_index ] = libbde_aes_vaes_load_round_key(
+			                             key_schedule->decryption_round_keys,
+			                             round_index );
+		}
+		else
+		{
+			round_keys[ round_index ] = libbde_aes_vaes_load_round_key(
+			                             key_schedule->encryption_round_keys,
+			                             round_index );
+		}
+		tweak_round_keys[ round_index ] = libbde_aes_vaes_load_round_key(
+		                                   tweak_key_schedule->encryption_round_keys,
+		                                   round_index );
+	}
+	/* Lane N of the first tweaks vector of a sector is multiplied by alpha^N,
+	 * the tweaks vectors that follow are multiplied by alpha^4
+	 */
+	lane_shift_counts       = _mm512_set_epi64( 3, 3, 2, 2, 1, 1, 0, 0 );
+	lane_carry_shift_counts = _mm512_set_epi64( 61, 61, 62, 62, 63, 63, 64, 64 );
+	shift_counts            = _mm512_set1_epi64( 4 );
+	carry_shift_counts      = _mm512_set1_epi64( 60 );
+
+	for( sector_offset = 0;
+	     sector_offset < input_data_size;
+	     sector_offset += bytes_per_sector )
+	{
+		/* The tweak is the encrypted 128-bit little-endian sector number
+		 */
+		tweaks = _mm512_xor_si512(
+		          _mm512_broadcast_i32x4(
+		           _mm_set_epi64x( 0, (long long) sector_number ) ),
+		          tweak_round_keys[ 0 ] );
+
+		for( round_index = 1;
+		     round_index < number_of_rounds;
+		     round_index++ )
+		{
+			tweaks = _mm512_aesenc_epi128(
+			          tweaks,
+			          tweak_round_keys[ round_index ] );
+		}
+		tweaks = _mm512_aesenclast_epi128(
+		          tweaks,
+		          tweak_round_keys[ number_of_rounds ] );
+
+		libbde_aes_vaes_xts_multiply_alpha_power( tweaks, lane_shift_counts, lane_carry_shift_counts )
+
+		block_offset = 0;
+
+		while( ( block_offset + ( LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64 ) ) <= bytes_per_sector )
+		{
+			for( vector_index = 0;
+			     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+			     vector_index++ )
+			{
+				tweak_vectors[ vector_index ] = tweaks;
+
+				libbde_aes_vaes_xts_multiply_alpha_power( tweaks, shift_counts, carry_shift_counts )
+
+				vectors[ vector_index ] = _mm512_xor_si512(
+				                           _mm512_loadu_si512(
+				                            &( input_data[ sector_offset + block_offset + ( vector_index * 64 ) ] ) ),
+				                           _mm512_xor_si512(
+				                            tweak_vectors[ vector_index ],
+				                            round_keys[ 0 ] ) );
+			}
+			if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+			{
+				for( round_index = 1;
+				     round_index < number_of_rounds;
+				     round_index++ )
+				{
+					for( vector_index = 0;
+					     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+					     vector_index++ )
+					{
+						vectors[ vector_index ] = _mm512_aesdec_epi128(
+						                           vectors[ vector_index ],
+						                           round_keys[ round_index ] );
+					}
+				}
+				for( vector_index = 0;
+				     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+				     vector_index++ )
+				{
+					vectors[ vector_index ] = _mm512_aesdeclast_epi128(
+					                           vectors[ vector_index ],
+					                           round_keys[ number_of_rounds ] );
+				}
+			}
+			else
+			{
+				for( round_index = 1;
+				     round_index < number_of_rounds;
+				     round_index++ )
+				{
+					for( vector_index = 0;
+					     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+					     vector_index++ )
+					{
+						vectors[ vector_index ] = _mm512_aesenc_epi128(
+						                           vectors[ vector_index ],
+						                           round_keys[ round_index ] );
+					}
+				}
+				for( vector_index = 0;
+				     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+				     vector_index++ )
+				{
+					vectors[ vector_index ] = _mm512_aesenclast_epi128(
+					                           vectors[ vector_index ],
+					                           round_keys[ number_of_rounds ] );
+				}
+			}
+			for( vector_index = 0;
+			     vector_index < LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS;
+			     vector_index++ )
+			{
+				_mm512_storeu_si512(
+				 &( output_data[ sector_offset + block_offset + ( vector_index * 64 ) ] ),
+				 _mm512_xor_si512(
+				  vectors[ vector_index ],
+				  tweak_vectors[ vector_index ] ) );
+			}
+			block_offset += LIBBDE_AES_VAES_NUMBER_OF_PARALLEL_VECTORS * 64;
+		}
+		/* De- or encrypt the remaining blocks one at a time in the first lane
+		 * of a vector, where the tweaks are rotated by one lane after every block
+		 */
+		while( block_offset < bytes_per_sector )
+		{
+			vectors[ 0 ] = _mm512_xor_si512(
+			                _mm512_castsi128_si512(
+			                 _mm_loadu_si128(
+			                  (__m128i *) &( input_data[ sector_offset + block_offset ] ) ) ),
+			                _mm512_xor_si512(
+			                 tweaks,
+			                 round_keys[ 0 ] ) );
+
+			for( round_index = 1;
+			     round_index < number_of_rounds;
+			     round_index++ )
+			{
+				if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+				{
+					vectors[ 0 ] = _mm512_aesdec_epi128(
+					                vectors[ 0 ],
+					                round_keys[ round_index ] );
+				}
+				else
+				{
+					vectors[ 0 ] = _mm512_aesenc_epi128(
+					                vectors[ 0 ],
+					                round_keys[ round_index ] );
+				}
+			}
+			if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+			{
+				vectors[ 0 ] = _mm512_aesdeclast_epi128(
+				                vectors[ 0 ],
+				                round_keys[ number_of_rounds ] );
+			}
+			else
+			{
+				vectors[ 0 ] = _mm512_aesenclast_epi128(
+				                vectors[ 0 ],
+				                round_keys[ number_of_rounds ] );
+			}
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ sector_offset + block_offset ] ),
+			 _mm512_castsi512_si128(
+			  _mm512_xor_si512(
+			   vectors[ 0 ],
+			   tweaks ) ) );
+
+			tweaks = _mm512_alignr_epi32(
+			          tweaks,
+			          tweaks,
+			          4 );
+
+			block_offset += 16;
+
+			/* After 4 blocks the lanes are back in their original order
+			 */
+			if( ( block_offset % 64 ) == 0 )
+			{
+				libbde_aes_vaes_xts_multiply_alpha_power( tweaks, shift_counts, carry_shift_counts )
+			}
+		}
+		sector_number++;
+	}
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: VAES is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_AES_VAES_SUPPORT ) */
+}
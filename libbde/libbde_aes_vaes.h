@@ -0,0 +1,81 @@
+/*
+ * VAES (AVX-512) functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_AES_VAES_H )
+#define _LIBBDE_AES_VAES_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_aes_ni.h"
+#include "libbde_libcerror.h"
+
+/* The VAES functions are build using function specific target attributes,
+ * the VAES intrinsics require GCC 8 or Clang 6 or later
+ */
+#if defined( HAVE_LIBBDE_AES_NI_SUPPORT ) && ( ( defined( __clang__ ) && ( __clang_major__ >= 6 ) ) || ( !defined( __clang__ ) && ( __GNUC__ >= 8 ) ) )
+#define HAVE_LIBBDE_AES_VAES_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libbde_aes_vaes_is_supported(
+     void );
+
+int libbde_aes_vaes_encrypt_ecb(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_vaes_decrypt_cbc(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_vaes_crypt_xts(
+     libbde_aes_ni_key_schedule_t *key_schedule,
+     libbde_aes_ni_key_schedule_t *tweak_key_schedule,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_AES_VAES_H ) */
+
@@ -27,7 +27,13 @@
 #include "libbde_diffuser.h"
 #include "libbde_libcerror.h"
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+#include <immintrin.h>
+#endif
+
 /* Decrypts the data using Diffuser-A and B
+ * The data is decrypted in-place, where on little-endian hosts 32-bit aligned
+ * data is used as 32-bit values without conversion
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_decrypt(
@@ -35,11 +41,15 @@ int libbde_diffuser_decrypt(
      size_t data_size,
      libcerror_error_t **error )
 {
-	uint32_t *values_32bit   = NULL;
-	static char *function    = "libbde_diffuser_decrypt";
-	size_t data_index        = 0;
-	size_t number_of_values  = 0;
-	size_t value_32bit_index = 0;
+	uint32_t values_buffer[ LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ];
+
+	uint32_t *allocated_values = NULL;
+	uint32_t *values_32bit     = NULL;
+	static char *function      = "libbde_diffuser_decrypt";
+	size_t number_of_values    = 0;
+	size_t value_32bit_index   = 0;
+	uint32_t value_32bit       = 0;
+	uint8_t is_little_endian   = 0;
 
 	if( data == NULL )
 	{
@@ -63,44 +73,79 @@ int libbde_diffuser_decrypt(
 
 		return( -1 );
 	}
-	if( ( data_size % 4 ) != 0 )
+	if( ( data_size % 16 ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported data size - not a multitude of 4.",
+		 "%s: unsupported data size - not a multitude of 16.",
 		 function );
 
 		return( -1 );
 	}
 	number_of_values = data_size / 4;
 
-	values_32bit = (uint32_t *) memory_allocate(
-	                             data_size );
-
-	if( values_32bit == NULL )
+	if( ( (intptr_t) data % sizeof( uint32_t ) ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values 32-bit.",
-		 function );
+		values_32bit = (uint32_t *) data;
+	}
+	else
+	{
+		/* Unaligned data is decrypted in a buffer on the stack
+		 * or in an allocated buffer if it does not fit on the stack
+		 */
+		if( number_of_values <= LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES )
+		{
+			values_32bit = values_buffer;
+		}
+		else
+		{
+			allocated_values = (uint32_t *) memory_allocate(
+			                                 data_size );
 
-		goto on_error;
+			if( allocated_values == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create values buffer.",
+				 function );
+
+				return( -1 );
+			}
+			values_32bit = allocated_values;
+		}
+		if( memory_copy(
+		     values_32bit,
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to values buffer.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	data_index = 0;
+	is_little_endian = (uint8_t) _BYTE_STREAM_HOST_IS_ENDIAN_LITTLE;
 
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	if( is_little_endian == 0 )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 (uint8_t *) &( values_32bit[ value_32bit_index ] ),
+			 value_32bit );
 
-		data_index += sizeof( uint32_t );
+			values_32bit[ value_32bit_index ] = value_32bit;
+		}
 	}
 	if( libbde_diffuser_b_decrypt(
 	     values_32bit,
@@ -130,47 +175,69 @@ int libbde_diffuser_decrypt(
 
 		goto on_error;
 	}
-	data_index = 0;
-
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	if( is_little_endian == 0 )
 	{
-		byte_stream_copy_from_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			value_32bit = values_32bit[ value_32bit_index ];
 
-		data_index += sizeof( uint32_t );
+			byte_stream_copy_from_uint32_little_endian(
+			 (uint8_t *) &( values_32bit[ value_32bit_index ] ),
+			 value_32bit );
+		}
 	}
-	if( memory_set(
-	     values_32bit,
-	     0,
-	     data_size ) == NULL )
+	if( values_32bit != (uint32_t *) data )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values 32-bit.",
-		 function );
-
-		goto on_error;
+		if( memory_copy(
+		     data,
+		     values_32bit,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy values buffer to data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     values_32bit,
+		     0,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear values buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( allocated_values != NULL )
+	{
+		memory_free(
+		 allocated_values );
 	}
-	memory_free(
-	 values_32bit );
-
 	return( 1 );
 
 on_error:
-	if( values_32bit != NULL )
+	if( values_32bit != (uint32_t *) data )
 	{
 		memory_set(
 		 values_32bit,
 		 0,
 		 data_size );
-
+	}
+	if( allocated_values != NULL )
+	{
 		memory_free(
-		 values_32bit );
+		 allocated_values );
 	}
 	return( -1 );
 }
@@ -211,6 +278,17 @@ int libbde_diffuser_a_decrypt(
 
 		return( -1 );
 	}
+	if( ( number_of_values % 4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values - not a multitude of 4.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_values > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -277,6 +355,9 @@ int libbde_diffuser_a_decrypt(
 }
 
 /* Decrypts the data using Diffuser-B
+ * Every value is updated using the values 2 and 5 positions ahead of it, that
+ * except for the last 5 values are not yet updated in the same iteration,
+ * hence all but the last values of an iteration can be decrypted in parallel
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_b_decrypt(
@@ -290,6 +371,11 @@ int libbde_diffuser_b_decrypt(
 	size_t value_32bit_index2   = 0;
 	size_t value_32bit_index3   = 0;
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+	int has_avx2                = 0;
+	int has_sse2                = 0;
+#endif
+
 	if( values_32bit == NULL )
 	{
 		libcerror_error_set(
@@ -312,6 +398,17 @@ int libbde_diffuser_b_decrypt(
 
 		return( -1 );
 	}
+	if( ( number_of_values % 4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values - not a multitude of 4.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_values > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -323,13 +420,32 @@ int libbde_diffuser_b_decrypt(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+	has_avx2 = __builtin_cpu_supports( "avx2" );
+	has_sse2 = __builtin_cpu_supports( "sse2" );
+#endif
 	for( number_of_iterations = 3;
 	     number_of_iterations > 0;
 	     number_of_iterations-- )
 	{
 		value_32bit_index1 = 0;
-		value_32bit_index2 = 2;
-		value_32bit_index3 = 5;
+
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+		if( has_avx2 != 0 )
+		{
+			value_32bit_index1 = libbde_diffuser_b_decrypt_avx2(
+			                      values_32bit,
+			                      number_of_values );
+		}
+		else if( has_sse2 != 0 )
+		{
+			value_32bit_index1 = libbde_diffuser_b_decrypt_sse2(
+			                      values_32bit,
+			                      number_of_values );
+		}
+#endif
+		value_32bit_index2 = ( value_32bit_index1 + 2 ) % number_of_values;
+		value_32bit_index3 = ( value_32bit_index1 + 5 ) % number_of_values;
 
 		while( value_32bit_index1 < ( number_of_values - 1 ) )
 		{
@@ -377,7 +493,122 @@ int libbde_diffuser_b_decrypt(
 	return( 1 );
 }
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+
+/* Decrypts the values of an iteration of Diffuser-B that do not depend on
+ * values updated in the same iteration, 4 values at a time using SSE2
+ * Returns the number of values decrypted
+ */
+__attribute__(( target( "sse2" ) ))
+size_t libbde_diffuser_b_decrypt_sse2(
+        uint32_t *values_32bit,
+        size_t number_of_values )
+{
+	__m128i keep_mask          = _mm_set_epi32( 0, -1, 0, -1 );
+	__m128i rotate_10_mask     = _mm_set_epi32( 0, 0, -1, 0 );
+	__m128i rotate_25_mask     = _mm_set_epi32( -1, 0, 0, 0 );
+	__m128i values             = _mm_setzero_si128();
+	__m128i values2            = _mm_setzero_si128();
+	__m128i values3            = _mm_setzero_si128();
+	size_t value_32bit_index   = 0;
+
+	/* The values of index + 2 and index + 5 of the last value of a group
+	 * must precede the values updated at the start of the iteration
+	 */
+	while( ( value_32bit_index + 4 + 5 ) <= number_of_values )
+	{
+		values  = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index ] ) );
+		values2 = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index + 2 ] ) );
+		values3 = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index + 5 ] ) );
+
+		/* The values at index % 4 of 1 and 3 are rotated by 10 and 25 bits
+		 */
+		values3 = _mm_or_si128(
+		           _mm_and_si128(
+		            values3,
+		            keep_mask ),
+		           _mm_or_si128(
+		            _mm_and_si128(
+		             _mm_or_si128(
+		              _mm_slli_epi32( values3, 10 ),
+		              _mm_srli_epi32( values3, 22 ) ),
+		             rotate_10_mask ),
+		            _mm_and_si128(
+		             _mm_or_si128(
+		              _mm_slli_epi32( values3, 25 ),
+		              _mm_srli_epi32( values3, 7 ) ),
+		             rotate_25_mask ) ) );
+
+		values = _mm_add_epi32(
+		          values,
+		          _mm_xor_si128(
+		           values2,
+		           values3 ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( values_32bit[ value_32bit_index ] ),
+		 values );
+
+		value_32bit_index += 4;
+	}
+	return( value_32bit_index );
+}
+
+/* Decrypts the values of an iteration of Diffuser-B that do not depend on
+ * values updated in the same iteration, 8 values at a time using AVX2
+ * Returns the number of values decrypted
+ */
+__attribute__(( target( "avx2" ) ))
+size_t libbde_diffuser_b_decrypt_avx2(
+        uint32_t *values_32bit,
+        size_t number_of_values )
+{
+	__m256i left_shifts      = _mm256_set_epi32( 25, 0, 10, 0, 25, 0, 10, 0 );
+	__m256i right_shifts     = _mm256_set_epi32( 7, 32, 22, 32, 7, 32, 22, 32 );
+	__m256i values           = _mm256_setzero_si256();
+	__m256i values2          = _mm256_setzero_si256();
+	__m256i values3          = _mm256_setzero_si256();
+	size_t value_32bit_index = 0;
+
+	while( ( value_32bit_index + 8 + 5 ) <= number_of_values )
+	{
+		values  = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index ] ) );
+		values2 = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index + 2 ] ) );
+		values3 = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index + 5 ] ) );
+
+		/* A variable shift of 32 bits results in 0, hence the values
+		 * at index % 4 of 0 and 2 are not rotated
+		 */
+		values3 = _mm256_or_si256(
+		           _mm256_sllv_epi32( values3, left_shifts ),
+		           _mm256_srlv_epi32( values3, right_shifts ) );
+
+		values = _mm256_add_epi32(
+		          values,
+		          _mm256_xor_si256(
+		           values2,
+		           values3 ) );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( values_32bit[ value_32bit_index ] ),
+		 values );
+
+		value_32bit_index += 8;
+	}
+	return( value_32bit_index );
+}
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT ) */
+
 /* Encrypts the data using Diffuser-A and B
+ * The data is encrypted in-place, where on little-endian hosts 32-bit aligned
+ * data is used as 32-bit values without conversion
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_encrypt(
@@ -385,11 +616,15 @@ int libbde_diffuser_encrypt(
      size_t data_size,
      libcerror_error_t **error )
 {
-	uint32_t *values_32bit   = NULL;
-	static char *function    = "libbde_diffuser_encrypt";
-	size_t data_index        = 0;
-	size_t number_of_values  = 0;
-	size_t value_32bit_index = 0;
+	uint32_t values_buffer[ LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ];
+
+	uint32_t *allocated_values = NULL;
+	uint32_t *values_32bit     = NULL;
+	static char *function      = "libbde_diffuser_encrypt";
+	size_t number_of_values    = 0;
+	size_t value_32bit_index   = 0;
+	uint32_t value_32bit       = 0;
+	uint8_t is_little_endian   = 0;
 
 	if( data == NULL )
 	{
@@ -413,44 +648,79 @@ int libbde_diffuser_encrypt(
 
 		return( -1 );
 	}
-	if( ( data_size % 4 ) != 0 )
+	if( ( data_size % 16 ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported data size - not a multitude of 4.",
+		 "%s: unsupported data size - not a multitude of 16.",
 		 function );
 
 		return( -1 );
 	}
 	number_of_values = data_size / 4;
 
-	values_32bit = (uint32_t *) memory_allocate(
-	                             data_size );
-
-	if( values_32bit == NULL )
+	if( ( (intptr_t) data % sizeof( uint32_t ) ) == 0 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values 32-bit.",
-		 function );
+		values_32bit = (uint32_t *) data;
+	}
+	else
+	{
+		/* Unaligned data is encrypted in a buffer on the stack
+		 * or in an allocated buffer if it does not fit on the stack
+		 */
+		if( number_of_values <= LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES )
+		{
+			values_32bit = values_buffer;
+		}
+		else
+		{
+			allocated_values = (uint32_t *) memory_allocate(
+			                                 data_size );
 
-		goto on_error;
+			if( allocated_values == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create values buffer.",
+				 function );
+
+				return( -1 );
+			}
+			values_32bit = allocated_values;
+		}
+		if( memory_copy(
+		     values_32bit,
+		     data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to values buffer.",
+			 function );
+
+			goto on_error;
+		}
 	}
-	data_index = 0;
+	is_little_endian = (uint8_t) _BYTE_STREAM_HOST_IS_ENDIAN_LITTLE;
 
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	if( is_little_endian == 0 )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 (uint8_t *) &( values_32bit[ value_32bit_index ] ),
+			 value_32bit );
 
-		data_index += sizeof( uint32_t );
+			values_32bit[ value_32bit_index ] = value_32bit;
+		}
 	}
 	if( libbde_diffuser_a_encrypt(
 	     values_32bit,
@@ -480,52 +750,79 @@ int libbde_diffuser_encrypt(
 
 		goto on_error;
 	}
-	data_index = 0;
-
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	if( is_little_endian == 0 )
 	{
-		byte_stream_copy_from_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			value_32bit = values_32bit[ value_32bit_index ];
 
-		data_index += sizeof( uint32_t );
+			byte_stream_copy_from_uint32_little_endian(
+			 (uint8_t *) &( values_32bit[ value_32bit_index ] ),
+			 value_32bit );
+		}
 	}
-	if( memory_set(
-	     values_32bit,
-	     0,
-	     data_size ) == NULL )
+	if( values_32bit != (uint32_t *) data )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values 32-bit.",
-		 function );
-
-		goto on_error;
+		if( memory_copy(
+		     data,
+		     values_32bit,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy values buffer to data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     values_32bit,
+		     0,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear values buffer.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( allocated_values != NULL )
+	{
+		memory_free(
+		 allocated_values );
 	}
-	memory_free(
-	 values_32bit );
-
 	return( 1 );
 
 on_error:
-	if( values_32bit != NULL )
+	if( values_32bit != (uint32_t *) data )
 	{
 		memory_set(
 		 values_32bit,
 		 0,
 		 data_size );
-
+	}
+	if( allocated_values != NULL )
+	{
 		memory_free(
-		 values_32bit );
+		 allocated_values );
 	}
 	return( -1 );
 }
 
 /* Encrypts the data using Diffuser-A
+ * This reverses Diffuser-A decryption, hence the values are updated in
+ * reverse order. Every value is updated using the values 2 and 5 positions
+ * before it, that except for the first 5 values are not yet updated in the
+ * same iteration, hence all but the first values of an iteration can be
+ * encrypted in parallel
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_a_encrypt(
@@ -539,6 +836,11 @@ int libbde_diffuser_a_encrypt(
 	size_t value_32bit_index2   = 0;
 	size_t value_32bit_index3   = 0;
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+	int has_avx2                = 0;
+	int has_sse2                = 0;
+#endif
+
 	if( values_32bit == NULL )
 	{
 		libcerror_error_set(
@@ -561,6 +863,17 @@ int libbde_diffuser_a_encrypt(
 
 		return( -1 );
 	}
+	if( ( number_of_values % 4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values - not a multitude of 4.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_values > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -572,69 +885,84 @@ int libbde_diffuser_a_encrypt(
 
 		return( -1 );
 	}
-/* TODO reverse loop
-	number_of_iterations = number_of_values * 5;
-
-	value_32bit_index1 = 0;
-	value_32bit_index2 = number_of_values - 2;
-	value_32bit_index3 = number_of_values - 5;
-*/
-
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+	has_avx2 = __builtin_cpu_supports( "avx2" );
+	has_sse2 = __builtin_cpu_supports( "sse2" );
+#endif
 	for( number_of_iterations = 5;
 	     number_of_iterations > 0;
 	     number_of_iterations-- )
 	{
-		value_32bit_index1 = 0;
-		value_32bit_index2 = number_of_values - 2;
-		value_32bit_index3 = number_of_values - 5;
+		value_32bit_index1 = number_of_values;
 
-		while( value_32bit_index1 < ( number_of_values - 1 ) )
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+		if( has_avx2 != 0 )
 		{
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ byte_stream_bit_rotate_left_32bit(
-			                                       values_32bit[ value_32bit_index3 ],
-			                                       9 );
+			value_32bit_index1 = libbde_diffuser_a_encrypt_avx2(
+			                      values_32bit,
+			                      number_of_values );
+		}
+		else if( has_sse2 != 0 )
+		{
+			value_32bit_index1 = libbde_diffuser_a_encrypt_sse2(
+			                      values_32bit,
+			                      number_of_values );
+		}
+#endif
+		/* The indexes are decremented before they are used
+		 */
+		value_32bit_index2 = ( value_32bit_index1 + number_of_values - 2 ) % number_of_values;
+		value_32bit_index3 = ( value_32bit_index1 + number_of_values - 5 ) % number_of_values;
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+		while( value_32bit_index1 > 0 )
+		{
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
 
-			if( value_32bit_index3 >= number_of_values )
-			{
-				value_32bit_index3 -= number_of_values;
-			}
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ values_32bit[ value_32bit_index3 ];
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
 
-			if( value_32bit_index2 >= number_of_values )
-			{
-				value_32bit_index2 -= number_of_values;
-			}
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ byte_stream_bit_rotate_left_32bit(
 			                                       values_32bit[ value_32bit_index3 ],
 			                                       13 );
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			if( value_32bit_index2 == 0 )
+			{
+				value_32bit_index2 = number_of_values;
+			}
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
 
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ values_32bit[ value_32bit_index3 ];
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			if( value_32bit_index3 == 0 )
+			{
+				value_32bit_index3 = number_of_values;
+			}
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
+
+			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
+			                                    ^ byte_stream_bit_rotate_left_32bit(
+			                                       values_32bit[ value_32bit_index3 ],
+			                                       9 );
 		}
 	}
 	return( 1 );
 }
 
 /* Encrypts the data using Diffuser-B
+ * This reverses Diffuser-B decryption, hence the values are updated in
+ * reverse order
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_b_encrypt(
@@ -670,6 +998,17 @@ int libbde_diffuser_b_encrypt(
 
 		return( -1 );
 	}
+	if( ( number_of_values % 4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of values - not a multitude of 4.",
+		 function );
+
+		return( -1 );
+	}
 	if( number_of_values > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
@@ -681,65 +1020,174 @@ int libbde_diffuser_b_encrypt(
 
 		return( -1 );
 	}
-/* TODO reverse loop
-	number_of_iterations = number_of_values * 3;
-
-	value_32bit_index1 = 0;
-	value_32bit_index2 = 2;
-	value_32bit_index3 = 5;
-*/
-
 	for( number_of_iterations = 3;
 	     number_of_iterations > 0;
 	     number_of_iterations-- )
 	{
-		value_32bit_index1 = 0;
+		/* The indexes are decremented before they are used
+		 */
+		value_32bit_index1 = number_of_values;
 		value_32bit_index2 = 2;
 		value_32bit_index3 = 5;
 
-		while( value_32bit_index1 < ( number_of_values - 1 ) )
+		while( value_32bit_index1 > 0 )
 		{
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ values_32bit[ value_32bit_index3 ];
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
 
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ byte_stream_bit_rotate_left_32bit(
 			                                       values_32bit[ value_32bit_index3 ],
-			                                       10 );
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			                                       25 );
 
-			if( value_32bit_index2 >= number_of_values )
+			if( value_32bit_index3 == 0 )
 			{
-				value_32bit_index2 -= number_of_values;
+				value_32bit_index3 = number_of_values;
 			}
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
+
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ values_32bit[ value_32bit_index3 ];
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
-
-			if( value_32bit_index3 >= number_of_values )
+			if( value_32bit_index2 == 0 )
 			{
-				value_32bit_index3 -= number_of_values;
+				value_32bit_index2 = number_of_values;
 			}
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
+
 			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
 			                                    ^ byte_stream_bit_rotate_left_32bit(
 			                                       values_32bit[ value_32bit_index3 ],
-			                                       25 );
+			                                       10 );
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit_index1--;
+			value_32bit_index2--;
+			value_32bit_index3--;
+
+			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
+			                                    ^ values_32bit[ value_32bit_index3 ];
 		}
 	}
 	return( 1 );
 }
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+
+/* Encrypts the values of an iteration of Diffuser-A that do not depend on
+ * values updated in the same iteration, 4 values at a time using SSE2
+ * starting with the last values
+ * Returns the index of the first value encrypted
+ */
+__attribute__(( target( "sse2" ) ))
+size_t libbde_diffuser_a_encrypt_sse2(
+        uint32_t *values_32bit,
+        size_t number_of_values )
+{
+	__m128i keep_mask        = _mm_set_epi32( -1, 0, -1, 0 );
+	__m128i rotate_9_mask    = _mm_set_epi32( 0, 0, 0, -1 );
+	__m128i rotate_13_mask   = _mm_set_epi32( 0, -1, 0, 0 );
+	__m128i values           = _mm_setzero_si128();
+	__m128i values2          = _mm_setzero_si128();
+	__m128i values3          = _mm_setzero_si128();
+	size_t value_32bit_index = number_of_values;
+
+	/* The value of index - 5 of the first value of a group must not precede
+	 * the first value, since these are updated at the end of the iteration
+	 */
+	while( value_32bit_index >= ( 4 + 5 ) )
+	{
+		value_32bit_index -= 4;
+
+		values  = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index ] ) );
+		values2 = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index - 2 ] ) );
+		values3 = _mm_loadu_si128(
+		           (__m128i *) &( values_32bit[ value_32bit_index - 5 ] ) );
+
+		/* The values at index % 4 of 0 and 2 are rotated by 9 and 13 bits
+		 */
+		values3 = _mm_or_si128(
+		           _mm_and_si128(
+		            values3,
+		            keep_mask ),
+		           _mm_or_si128(
+		            _mm_and_si128(
+		             _mm_or_si128(
+		              _mm_slli_epi32( values3, 9 ),
+		              _mm_srli_epi32( values3, 23 ) ),
+		             rotate_9_mask ),
+		            _mm_and_si128(
+		             _mm_or_si128(
+		              _mm_slli_epi32( values3, 13 ),
+		              _mm_srli_epi32( values3, 19 ) ),
+		             rotate_13_mask ) ) );
+
+		values = _mm_sub_epi32(
+		          values,
+		          _mm_xor_si128(
+		           values2,
+		           values3 ) );
+
+		_mm_storeu_si128(
+		 (__m128i *) &( values_32bit[ value_32bit_index ] ),
+		 values );
+	}
+	return( value_32bit_index );
+}
+
+/* Encrypts the values of an iteration of Diffuser-A that do not depend on
+ * values updated in the same iteration, 8 values at a time using AVX2
+ * starting with the last values
+ * Returns the index of the first value encrypted
+ */
+__attribute__(( target( "avx2" ) ))
+size_t libbde_diffuser_a_encrypt_avx2(
+        uint32_t *values_32bit,
+        size_t number_of_values )
+{
+	__m256i left_shifts      = _mm256_set_epi32( 0, 13, 0, 9, 0, 13, 0, 9 );
+	__m256i right_shifts     = _mm256_set_epi32( 32, 19, 32, 23, 32, 19, 32, 23 );
+	__m256i values           = _mm256_setzero_si256();
+	__m256i values2          = _mm256_setzero_si256();
+	__m256i values3          = _mm256_setzero_si256();
+	size_t value_32bit_index = number_of_values;
+
+	while( value_32bit_index >= ( 8 + 5 ) )
+	{
+		value_32bit_index -= 8;
+
+		values  = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index ] ) );
+		values2 = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index - 2 ] ) );
+		values3 = _mm256_loadu_si256(
+		           (__m256i *) &( values_32bit[ value_32bit_index - 5 ] ) );
+
+		/* A variable shift of 32 bits results in 0, hence the values
+		 * at index % 4 of 1 and 3 are not rotated
+		 */
+		values3 = _mm256_or_si256(
+		           _mm256_sllv_epi32( values3, left_shifts ),
+		           _mm256_srlv_epi32( values3, right_shifts ) );
+
+		values = _mm256_sub_epi32(
+		          values,
+		          _mm256_xor_si256(
+		           values2,
+		           values3 ) );
+
+		_mm256_storeu_si256(
+		 (__m256i *) &( values_32bit[ value_32bit_index ] ),
+		 values );
+	}
+	return( value_32bit_index );
+}
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT ) */
+
@@ -27,6 +27,19 @@
 
 #include "libbde_libcerror.h"
 
+/* The SIMD functions are build using function specific target attributes,
+ * so that no additional compiler flags are needed
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT
+#endif
+
+/* The maximum number of 32-bit values of unaligned data that are buffered
+ * on the stack, which corresponds to the largest supported sector size
+ * Larger unaligned data is buffered in allocated memory
+ */
+#define LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES	1024
+
 #if defined( __cplusplus )
 extern "C" {
 #endif
@@ -46,6 +59,18 @@ int libbde_diffuser_b_decrypt(
      size_t number_of_values,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+
+size_t libbde_diffuser_b_decrypt_sse2(
+        uint32_t *values_32bit,
+        size_t number_of_values );
+
+size_t libbde_diffuser_b_decrypt_avx2(
+        uint32_t *values_32bit,
+        size_t number_of_values );
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT ) */
+
 int libbde_diffuser_encrypt(
      uint8_t *data,
      size_t data_size,
@@ -61,6 +86,18 @@ int libbde_diffuser_b_encrypt(
      size_t number_of_values,
      libcerror_error_t **error );
 
+#if defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT )
+
+size_t libbde_diffuser_a_encrypt_sse2(
+        uint32_t *values_32bit,
+        size_t number_of_values );
+
+size_t libbde_diffuser_a_encrypt_avx2(
+        uint32_t *values_32bit,
+        size_t number_of_values );
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_SIMD_SUPPORT ) */
+
 #ifdef __cplusplus
 }
 #endif
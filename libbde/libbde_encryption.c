@@ -24,6 +24,10 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libbde_aes_af_alg.h"
+#include "libbde_aes_evp.h"
+#include "libbde_aes_ni.h"
+#include "libbde_aes_vaes.h"
 #include "libbde_definitions.h"
 #include "libbde_diffuser.h"
 #include "libbde_encryption.h"
@@ -31,6 +35,135 @@
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
 
+/* The maximum number of sectors of which the AES-CBC initialization vectors
+ * and sector keys are computed in a single pass
+ */
+#define LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS	32
+
+/* The crypto backend requested for encryption contexts created afterwards
+ */
+int libbde_encryption_crypto_backend = LIBBDE_CRYPTO_BACKEND_AUTOMATIC;
+
+/* Determines if a crypto backend is supported by the CPU and the build
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_encryption_crypto_backend_is_supported(
+     int crypto_backend )
+{
+	switch( crypto_backend )
+	{
+		case LIBBDE_CRYPTO_BACKEND_PORTABLE:
+			return( 1 );
+
+		case LIBBDE_CRYPTO_BACKEND_AES_NI:
+			return( libbde_aes_ni_is_supported() );
+
+		case LIBBDE_CRYPTO_BACKEND_VAES:
+			return( libbde_aes_vaes_is_supported() );
+
+		case LIBBDE_CRYPTO_BACKEND_OPENSSL:
+			return( libbde_aes_evp_is_supported() );
+
+		case LIBBDE_CRYPTO_BACKEND_AF_ALG:
+			return( libbde_aes_af_alg_is_supported() );
+
+		default:
+			break;
+	}
+	return( 0 );
+}
+
+/* Retrieves the crypto backend
+ * If the automatic crypto backend was requested the fastest crypto backend
+ * supported is retrieved, in order: VAES, AES-NI, OpenSSL EVP and portable
+ * The AF_ALG crypto backend is never selected automatically
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_get_crypto_backend(
+     int *crypto_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_get_crypto_backend";
+
+	if( crypto_backend == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid crypto backend.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_encryption_crypto_backend != LIBBDE_CRYPTO_BACKEND_AUTOMATIC )
+	{
+		*crypto_backend = libbde_encryption_crypto_backend;
+	}
+	else if( libbde_aes_vaes_is_supported() != 0 )
+	{
+		*crypto_backend = LIBBDE_CRYPTO_BACKEND_VAES;
+	}
+	else if( libbde_aes_ni_is_supported() != 0 )
+	{
+		*crypto_backend = LIBBDE_CRYPTO_BACKEND_AES_NI;
+	}
+	else if( libbde_aes_evp_is_supported() != 0 )
+	{
+		*crypto_backend = LIBBDE_CRYPTO_BACKEND_OPENSSL;
+	}
+	else
+	{
+		*crypto_backend = LIBBDE_CRYPTO_BACKEND_PORTABLE;
+	}
+	return( 1 );
+}
+
+/* Sets the crypto backend
+ * The crypto backend applies to encryption contexts created afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_set_crypto_backend(
+     int crypto_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_set_crypto_backend";
+
+	if( ( crypto_backend != LIBBDE_CRYPTO_BACKEND_AUTOMATIC )
+	 && ( crypto_backend != LIBBDE_CRYPTO_BACKEND_PORTABLE )
+	 && ( crypto_backend != LIBBDE_CRYPTO_BACKEND_AES_NI )
+	 && ( crypto_backend != LIBBDE_CRYPTO_BACKEND_VAES )
+	 && ( crypto_backend != LIBBDE_CRYPTO_BACKEND_OPENSSL )
+	 && ( crypto_backend != LIBBDE_CRYPTO_BACKEND_AF_ALG ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported crypto backend.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( crypto_backend != LIBBDE_CRYPTO_BACKEND_AUTOMATIC )
+	 && ( libbde_encryption_crypto_backend_is_supported(
+	       crypto_backend ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: crypto backend: %d not supported by CPU or build.",
+		 function,
+		 crypto_backend );
+
+		return( -1 );
+	}
+	libbde_encryption_crypto_backend = crypto_backend;
+
+	return( 1 );
+}
+
 /* Creates an encryption context
  * Make sure the value encryption context is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -205,7 +338,21 @@ int libbde_encryption_initialize(
 			goto on_error;
 		}
 	}
+	if( libbde_encryption_get_crypto_backend(
+	     &( ( *context )->crypto_backend ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve crypto backend.",
+		 function );
+
+		goto on_error;
+	}
 	( *context )->method = method;
+	( *context )->engine = LIBBDE_ENCRYPTION_ENGINE_FUSED;
 
 	return( 1 );
 
@@ -375,6 +522,132 @@ int libbde_encryption_free(
 				result = -1;
 			}
 		}
+		if( ( *context )->fvek_evp_ecb_context != NULL )
+		{
+			if( libbde_aes_evp_context_free(
+			     &( ( *context )->fvek_evp_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free FVEK EVP ECB context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->tweak_evp_ecb_context != NULL )
+		{
+			if( libbde_aes_evp_context_free(
+			     &( ( *context )->tweak_evp_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free TWEAK EVP ECB context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->fvek_evp_decryption_context != NULL )
+		{
+			if( libbde_aes_evp_context_free(
+			     &( ( *context )->fvek_evp_decryption_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free FVEK EVP decryption context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->fvek_evp_encryption_context != NULL )
+		{
+			if( libbde_aes_evp_context_free(
+			     &( ( *context )->fvek_evp_encryption_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free FVEK EVP encryption context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->fvek_af_alg_ecb_context != NULL )
+		{
+			if( libbde_aes_af_alg_context_free(
+			     &( ( *context )->fvek_af_alg_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free FVEK AF_ALG ECB context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->tweak_af_alg_ecb_context != NULL )
+		{
+			if( libbde_aes_af_alg_context_free(
+			     &( ( *context )->tweak_af_alg_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free TWEAK AF_ALG ECB context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *context )->fvek_af_alg_context != NULL )
+		{
+			if( libbde_aes_af_alg_context_free(
+			     &( ( *context )->fvek_af_alg_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable free FVEK AF_ALG context.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( memory_set(
+		     *context,
+		     0,
+		     sizeof( libbde_encryption_context_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear context.",
+			 function );
+
+			result = -1;
+		}
 		memory_free(
 		 *context );
 
@@ -383,6 +656,133 @@ int libbde_encryption_free(
 	return( result );
 }
 
+/* Clones an encryption context
+ * The clone has its own AES contexts, so that it can be used by another thread
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_clone(
+     libbde_encryption_context_t **destination_context,
+     libbde_encryption_context_t *source_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_clone";
+
+	if( destination_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid destination context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *destination_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid destination context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_context == NULL )
+	{
+		*destination_context = NULL;
+
+		return( 1 );
+	}
+	if( libbde_encryption_initialize(
+	     destination_context,
+	     source_context->method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create destination context.",
+		 function );
+
+		goto on_error;
+	}
+	( *destination_context )->crypto_backend = source_context->crypto_backend;
+	( *destination_context )->engine         = source_context->engine;
+
+	if( libbde_encryption_set_keys(
+	     *destination_context,
+	     source_context->full_volume_encryption_key,
+	     source_context->full_volume_encryption_key_size,
+	     source_context->tweak_key,
+	     source_context->tweak_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys in destination context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *destination_context != NULL )
+	{
+		libbde_encryption_free(
+		 destination_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Sets the engine used to decrypt AES-CBC Diffuser sectors
+ * The staged engine decrypts a batch of sectors in separate AES-CBC, Diffuser
+ * and sector key passes, the fused engine runs all passes on a single sector
+ * and the generic engine de- or encrypts all sectors using libbde_encryption_crypt
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_set_engine(
+     libbde_encryption_context_t *context,
+     int engine,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_set_engine";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( engine != LIBBDE_ENCRYPTION_ENGINE_STAGED )
+	 && ( engine != LIBBDE_ENCRYPTION_ENGINE_FUSED )
+	 && ( engine != LIBBDE_ENCRYPTION_ENGINE_GENERIC ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported engine.",
+		 function );
+
+		return( -1 );
+	}
+	context->engine = engine;
+
+	return( 1 );
+}
+
 /* Sets the de- and encryption keys
  * Returns 1 if successful or -1 on error
  */
@@ -394,9 +794,10 @@ int libbde_encryption_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error )
 {
-	static char *function = "libbde_encryption_set_keys";
-	size_t key_bit_size   = 0;
-	size_t key_byte_size  = 0;
+	const uint8_t *schedule_tweak_key = NULL;
+	static char *function             = "libbde_encryption_set_keys";
+	size_t key_bit_size               = 0;
+	size_t key_byte_size              = 0;
 
 	if( context == NULL )
 	{
@@ -493,18 +894,50 @@ int libbde_encryption_set_keys(
 
 		return( -1 );
 	}
-	key_bit_size = key_byte_size * 8;
-
-	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	if( memory_copy(
+	     context->full_volume_encryption_key,
+	     full_volume_encryption_key,
+	     key_byte_size ) == NULL )
 	{
-		if( libcaes_context_set_key(
-		     context->fvek_decryption_context,
-		     LIBCAES_CRYPT_MODE_DECRYPT,
-		     full_volume_encryption_key,
-		     key_bit_size,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy full volume encryption key.",
+		 function );
+
+		return( -1 );
+	}
+	context->full_volume_encryption_key_size = key_byte_size;
+
+	if( memory_copy(
+	     context->tweak_key,
+	     tweak_key,
+	     key_byte_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	context->tweak_key_size = key_byte_size;
+
+	key_bit_size = key_byte_size * 8;
+
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		if( libcaes_context_set_key(
+		     context->fvek_decryption_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     full_volume_encryption_key,
+		     key_bit_size,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
@@ -614,29 +1047,129 @@ int libbde_encryption_set_keys(
 			return( -1 );
 		}
 	}
+	if( ( context->crypto_backend == LIBBDE_CRYPTO_BACKEND_AES_NI )
+	 || ( context->crypto_backend == LIBBDE_CRYPTO_BACKEND_VAES ) )
+	{
+		/* For AES-XTS the first half of the key is the data key and the second half the tweak key
+		 */
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+		{
+			schedule_tweak_key = &( full_volume_encryption_key[ key_byte_size ] );
+		}
+		else
+		{
+			schedule_tweak_key = tweak_key;
+		}
+		if( libbde_aes_ni_key_schedule_set_key(
+		     &( context->fvek_key_schedule ),
+		     full_volume_encryption_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set full volume encryption key in AES-NI key schedule.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbde_aes_ni_key_schedule_set_key(
+		     &( context->tweak_key_schedule ),
+		     schedule_tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set tweak key in AES-NI key schedule.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( context->crypto_backend == LIBBDE_CRYPTO_BACKEND_OPENSSL )
+	{
+		if( libbde_encryption_set_evp_keys(
+		     context,
+		     full_volume_encryption_key,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in OpenSSL EVP contexts.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( context->crypto_backend == LIBBDE_CRYPTO_BACKEND_AF_ALG )
+	{
+		if( libbde_encryption_set_af_alg_keys(
+		     context,
+		     full_volume_encryption_key,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in AF_ALG contexts.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* The method specific decrypt function is selected once so that decrypting
+	 * a sector does not need to determine the method again
+	 */
+	switch( context->method )
+	{
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_CBC:
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_CBC:
+			context->decrypt_sector = &libbde_encryption_decrypt_aes_cbc_sector;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER:
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER:
+			context->decrypt_sector = &libbde_encryption_decrypt_aes_cbc_diffuser_sector;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_XTS:
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_XTS:
+			context->decrypt_sector = &libbde_encryption_decrypt_aes_xts_sector;
+			break;
+
+		default:
+			context->decrypt_sector = NULL;
+			break;
+	}
 	return( 1 );
 }
 
-/* De- or encrypts a block of data
+/* Sets the keys in the OpenSSL EVP contexts
+ * The key bit size is the size of a single AES key, for AES-XTS the full volume
+ * encryption key consists of the data key followed by the tweak key
  * Returns 1 if successful or -1 on error
  */
-int libbde_encryption_crypt(
+int libbde_encryption_set_evp_keys(
      libbde_encryption_context_t *context,
-     int mode,
-     const uint8_t *input_data,
-     size_t input_data_size,
-     uint8_t *output_data,
-     size_t output_data_size,
-     uint64_t block_key,
+     const uint8_t *full_volume_encryption_key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
      libcerror_error_t **error )
 {
-	uint8_t block_key_data[ 16 ];
-	uint8_t initialization_vector[ 16 ];
-	uint8_t sector_key_data[ 32 ];
-
-	static char *function        = "libbde_encryption_crypt";
-	size_t data_index            = 0;
-	size_t sector_key_data_index = 0;
+	static char *function = "libbde_encryption_set_evp_keys";
 
 	if( context == NULL )
 	{
@@ -649,330 +1182,2099 @@ int libbde_encryption_crypt(
 
 		return( -1 );
 	}
-	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
-	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	if( full_volume_encryption_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported mode.",
-		 function );
-
-		return( -1 );
-	}
-	if( memory_set(
-	     initialization_vector,
-	     0,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear initialization vector.",
-		 function );
-
-		return( -1 );
-	}
-	if( memory_set(
-	     block_key_data,
-	     0,
-	     16 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear block key data.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid full volume encryption key.",
 		 function );
 
 		return( -1 );
 	}
-	if( memory_set(
-	     sector_key_data,
-	     0,
-	     32 ) == NULL )
+	if( tweak_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear sector key data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	if( context->fvek_evp_decryption_context == NULL )
 	{
-		byte_stream_copy_from_uint64_little_endian(
-		 block_key_data,
-		 block_key );
-
-		/* The block key for the initialization vector is encrypted
-		 * with the FVEK
-		 */
-		if( libcaes_crypt_ecb(
-		     context->fvek_encryption_context,
-		     LIBCAES_CRYPT_MODE_ENCRYPT,
-		     block_key_data,
-		     16,
-		     initialization_vector,
-		     16,
+		if( libbde_aes_evp_context_initialize(
+		     &( context->fvek_evp_decryption_context ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to encrypt initialization vector.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize FVEK EVP decryption context.",
 			 function );
 
 			return( -1 );
 		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		if( context->fvek_evp_encryption_context == NULL )
 		{
-			/* The block key for the sector key data is encrypted
-			 * with the TWEAK key
-			 */
-			if( libcaes_crypt_ecb(
-			     context->tweak_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     block_key_data,
-			     16,
-			     sector_key_data,
-			     16,
+			if( libbde_aes_evp_context_initialize(
+			     &( context->fvek_evp_encryption_context ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to encrypt sector key data.",
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize FVEK EVP encryption context.",
 				 function );
 
 				return( -1 );
 			}
-			/* Set the last byte to contain 0x80 (128)
-			 */
-			block_key_data[ 15 ] = 0x80;
+		}
+		if( libbde_aes_evp_context_set_key(
+		     context->fvek_evp_decryption_context,
+		     LIBBDE_AES_EVP_CIPHER_MODE_XTS,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     full_volume_encryption_key,
+		     key_bit_size * 2,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in FVEK EVP decryption context.",
+			 function );
 
-			if( libcaes_crypt_ecb(
-			     context->tweak_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     block_key_data,
-			     16,
-			     &( sector_key_data[ 16 ] ),
-			     16,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to encrypt sector key data.",
-				 function );
+			return( -1 );
+		}
+		if( libbde_aes_evp_context_set_key(
+		     context->fvek_evp_encryption_context,
+		     LIBBDE_AES_EVP_CIPHER_MODE_XTS,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     full_volume_encryption_key,
+		     key_bit_size * 2,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in FVEK EVP encryption context.",
+			 function );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
+		return( 1 );
 	}
-	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-	      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	if( context->fvek_evp_ecb_context == NULL )
 	{
-		byte_stream_copy_from_uint64_little_endian(
-		 initialization_vector,
-		 block_key );
+		if( libbde_aes_evp_context_initialize(
+		     &( context->fvek_evp_ecb_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize FVEK EVP ECB context.",
+			 function );
 
-/* TODO: implement */
+			return( -1 );
+		}
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( libbde_aes_evp_context_set_key(
+	     context->fvek_evp_ecb_context,
+	     LIBBDE_AES_EVP_CIPHER_MODE_ECB,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     full_volume_encryption_key,
+	     key_bit_size,
+	     error ) != 1 )
 	{
-		libcnotify_printf(
-		 "%s: initialization vector:\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in FVEK EVP ECB context.",
 		 function );
-		libcnotify_print_data(
-		 initialization_vector,
+
+		return( -1 );
+	}
+	if( libbde_aes_evp_context_set_key(
+	     context->fvek_evp_decryption_context,
+	     LIBBDE_AES_EVP_CIPHER_MODE_CBC,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     full_volume_encryption_key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in FVEK EVP decryption context.",
+		 function );
+
+		return( -1 );
+	}
+	/* The TWEAK key is only used with diffuser
+	 */
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		if( context->tweak_evp_ecb_context == NULL )
+		{
+			if( libbde_aes_evp_context_initialize(
+			     &( context->tweak_evp_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize TWEAK EVP ECB context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbde_aes_evp_context_set_key(
+		     context->tweak_evp_ecb_context,
+		     LIBBDE_AES_EVP_CIPHER_MODE_ECB,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in TWEAK EVP ECB context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the keys in the Linux kernel crypto API (AF_ALG) contexts
+ * The key bit size is the size of a single AES key, for AES-XTS the full volume
+ * encryption key consists of the data key followed by the tweak key
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_set_af_alg_keys(
+     libbde_encryption_context_t *context,
+     const uint8_t *full_volume_encryption_key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_set_af_alg_keys";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( full_volume_encryption_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid full volume encryption key.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
+		 function );
+
+		return( -1 );
+	}
+	/* The operation is set per request, hence a single AES-CBC or AES-XTS
+	 * context is used to both de- and encrypt
+	 */
+	if( context->fvek_af_alg_context == NULL )
+	{
+		if( libbde_aes_af_alg_context_initialize(
+		     &( context->fvek_af_alg_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize FVEK AF_ALG context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		if( libbde_aes_af_alg_context_set_key(
+		     context->fvek_af_alg_context,
+		     LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS,
+		     full_volume_encryption_key,
+		     key_bit_size * 2,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in FVEK AF_ALG context.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	if( context->fvek_af_alg_ecb_context == NULL )
+	{
+		if( libbde_aes_af_alg_context_initialize(
+		     &( context->fvek_af_alg_ecb_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize FVEK AF_ALG ECB context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbde_aes_af_alg_context_set_key(
+	     context->fvek_af_alg_ecb_context,
+	     LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB,
+	     full_volume_encryption_key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in FVEK AF_ALG ECB context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_aes_af_alg_context_set_key(
+	     context->fvek_af_alg_context,
+	     LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC,
+	     full_volume_encryption_key,
+	     key_bit_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key in FVEK AF_ALG context.",
+		 function );
+
+		return( -1 );
+	}
+	/* The TWEAK key is only used with diffuser
+	 */
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		if( context->tweak_af_alg_ecb_context == NULL )
+		{
+			if( libbde_aes_af_alg_context_initialize(
+			     &( context->tweak_af_alg_ecb_context ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize TWEAK AF_ALG ECB context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( libbde_aes_af_alg_context_set_key(
+		     context->tweak_af_alg_ecb_context,
+		     LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB,
+		     tweak_key,
+		     key_bit_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set key in TWEAK AF_ALG ECB context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a block of data
+ * For AES-CBC the block key is the offset of the block and for AES-XTS
+ * the sector number
+ * This function handles every method and mode and is used by the generic engine
+ * to verify the method specific decrypt functions
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	uint8_t block_key_data[ 16 ];
+	uint8_t initialization_vector[ 16 ];
+	uint8_t sector_key_data[ 32 ];
+
+	static char *function        = "libbde_encryption_crypt";
+	size_t data_index            = 0;
+	size_t sector_key_data_index = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     initialization_vector,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     block_key_data,
+	     0,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     sector_key_data,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 block_key_data,
+		 block_key );
+
+		/* The block key for the initialization vector is encrypted
+		 * with the FVEK
+		 */
+		if( libcaes_crypt_ecb(
+		     context->fvek_encryption_context,
+		     LIBCAES_CRYPT_MODE_ENCRYPT,
+		     block_key_data,
+		     16,
+		     initialization_vector,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to encrypt initialization vector.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		{
+			/* The block key for the sector key data is encrypted
+			 * with the TWEAK key
+			 */
+			if( libcaes_crypt_ecb(
+			     context->tweak_encryption_context,
+			     LIBCAES_CRYPT_MODE_ENCRYPT,
+			     block_key_data,
+			     16,
+			     sector_key_data,
+			     16,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to encrypt sector key data.",
+				 function );
+
+				return( -1 );
+			}
+			/* Set the last byte to contain 0x80 (128)
+			 */
+			block_key_data[ 15 ] = 0x80;
+
+			if( libcaes_crypt_ecb(
+			     context->tweak_encryption_context,
+			     LIBCAES_CRYPT_MODE_ENCRYPT,
+			     block_key_data,
+			     16,
+			     &( sector_key_data[ 16 ] ),
+			     16,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to encrypt sector key data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		/* The initialization vector is the 128-bit little-endian sector number
+		 */
+		byte_stream_copy_from_uint64_little_endian(
+		 initialization_vector,
+		 block_key );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: initialization vector:\n",
+		 function );
+		libcnotify_print_data(
+		 initialization_vector,
 		 16,
 		 0 );
 	}
-#endif
-	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+#endif
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+/* TODO safe guard input data ? */
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		{
+			sector_key_data_index = 0;
+
+			for( data_index = 0;
+			     data_index < input_data_size;
+			     data_index++ )
+			{
+				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
+
+				sector_key_data_index++;
+
+				if( sector_key_data_index >= 32 )
+				{
+					sector_key_data_index -= 32;
+				}
+			}
+			if( libbde_diffuser_encrypt(
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+				 "%s: unable to encrypt data using Diffuser.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		{
+			if( libcaes_crypt_cbc(
+			     context->fvek_encryption_context,
+			     LIBCAES_CRYPT_MODE_ENCRYPT,
+			     initialization_vector,
+			     16,
+			     input_data,
+			     input_data_size,
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to AES-CBC encrypt output data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+		{
+			if( libcaes_crypt_xts(
+			     context->fvek_decryption_tweaked_context,
+			     LIBCAES_CRYPT_MODE_ENCRYPT,
+			     initialization_vector,
+			     16,
+			     input_data,
+			     input_data_size,
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to AES-XTS decrypt output data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else if( ( context->engine == LIBBDE_ENCRYPTION_ENGINE_FUSED )
+	      && ( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	       || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) ) )
+	{
+		if( output_data_size < input_data_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid output data size value too small.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbde_encryption_decrypt_diffuser_sector(
+		     context,
+		     initialization_vector,
+		     sector_key_data,
+		     input_data,
+		     output_data,
+		     input_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to decrypt Diffuser sector.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		{
+			if( libcaes_crypt_cbc(
+			     context->fvek_decryption_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     initialization_vector,
+			     16,
+			     input_data,
+			     input_data_size,
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to AES-CBC decrypt output data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+		{
+			if( libcaes_crypt_xts(
+			     context->fvek_decryption_tweaked_context,
+			     LIBCAES_CRYPT_MODE_DECRYPT,
+			     initialization_vector,
+			     16,
+			     input_data,
+			     input_data_size,
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to AES-XTS decrypt output data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		{
+			if( libbde_diffuser_decrypt(
+			     output_data,
+			     output_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+				 "%s: unable to decrypt data using Diffuser.",
+				 function );
+
+				return( -1 );
+			}
+			sector_key_data_index = 0;
+
+			for( data_index = 0;
+			     data_index < input_data_size;
+			     data_index++ )
+			{
+				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
+
+				sector_key_data_index++;
+
+				if( sector_key_data_index >= 32 )
+				{
+					sector_key_data_index -= 32;
+				}
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Decrypts a single sector using the method specific decrypt function
+ * For AES-CBC the block key is the offset of the sector and for AES-XTS
+ * the sector number
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_decrypt_sector";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->decrypt_sector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing decrypt sector function.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->decrypt_sector(
+	     context,
+	     input_data,
+	     input_data_size,
+	     output_data,
+	     output_data_size,
+	     block_key,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt sector.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts a single AES-CBC sector
+ * The block key is the offset of the sector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_aes_cbc_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	uint8_t block_key_data[ 16 ];
+	uint8_t initialization_vector[ 16 ];
+
+	static char *function = "libbde_encryption_decrypt_aes_cbc_sector";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 block_key_data,
+	 block_key );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( block_key_data[ 8 ] ),
+	 (uint64_t) 0 );
+
+	/* The block key for the initialization vector is encrypted
+	 * with the FVEK
+	 */
+	if( libcaes_crypt_ecb(
+	     context->fvek_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     block_key_data,
+	     16,
+	     initialization_vector,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcaes_crypt_cbc(
+	     context->fvek_decryption_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     initialization_vector,
+	     16,
+	     input_data,
+	     input_data_size,
+	     output_data,
+	     output_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to AES-CBC decrypt output data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts a single AES-CBC Diffuser sector
+ * The block key is the offset of the sector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_aes_cbc_diffuser_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	uint8_t block_key_data[ 16 ];
+	uint8_t initialization_vector[ 16 ];
+	uint8_t sector_key_data[ 32 ];
+
+	static char *function = "libbde_encryption_decrypt_aes_cbc_diffuser_sector";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data_size < input_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid output data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_little_endian(
+	 block_key_data,
+	 block_key );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( block_key_data[ 8 ] ),
+	 (uint64_t) 0 );
+
+	/* The block key for the initialization vector is encrypted
+	 * with the FVEK
+	 */
+	if( libcaes_crypt_ecb(
+	     context->fvek_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     block_key_data,
+	     16,
+	     initialization_vector,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block key for the sector key data is encrypted with the TWEAK key,
+	 * where the last byte of the second block key contains 0x80 (128)
+	 */
+	if( libcaes_crypt_ecb(
+	     context->tweak_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     block_key_data,
+	     16,
+	     sector_key_data,
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt sector key data.",
+		 function );
+
+		return( -1 );
+	}
+	block_key_data[ 15 ] = 0x80;
+
+	if( libcaes_crypt_ecb(
+	     context->tweak_encryption_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     block_key_data,
+	     16,
+	     &( sector_key_data[ 16 ] ),
+	     16,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt sector key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_encryption_decrypt_diffuser_sector(
+	     context,
+	     initialization_vector,
+	     sector_key_data,
+	     input_data,
+	     output_data,
+	     input_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt Diffuser sector.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts a single AES-XTS sector
+ * The block key is the sector number
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_aes_xts_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error )
+{
+	uint8_t initialization_vector[ 16 ];
+
+	static char *function = "libbde_encryption_decrypt_aes_xts_sector";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	/* The initialization vector is the 128-bit little-endian sector number
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 initialization_vector,
+	 block_key );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 &( initialization_vector[ 8 ] ),
+	 (uint64_t) 0 );
+
+	if( libcaes_crypt_xts(
+	     context->fvek_decryption_tweaked_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     initialization_vector,
+	     16,
+	     input_data,
+	     input_data_size,
+	     output_data,
+	     output_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to AES-XTS decrypt output data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Encrypts block keys using AES-ECB with the FVEK or the TWEAK key
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_encrypt_block_keys(
+     libbde_encryption_context_t *context,
+     uint8_t use_tweak_key,
+     const uint8_t *block_keys_data,
+     size_t block_keys_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	libbde_aes_af_alg_context_t *af_alg_context = NULL;
+	libbde_aes_ni_key_schedule_t *key_schedule   = NULL;
+	libbde_aes_evp_context_t *evp_context        = NULL;
+	libcaes_context_t *caes_context              = NULL;
+	static char *function                        = "libbde_encryption_encrypt_block_keys";
+	size_t data_offset                           = 0;
+	int result                                   = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( use_tweak_key != 0 )
+	{
+		key_schedule   = &( context->tweak_key_schedule );
+		evp_context    = context->tweak_evp_ecb_context;
+		af_alg_context = context->tweak_af_alg_ecb_context;
+		caes_context   = context->tweak_encryption_context;
+	}
+	else
+	{
+		key_schedule   = &( context->fvek_key_schedule );
+		evp_context    = context->fvek_evp_ecb_context;
+		af_alg_context = context->fvek_af_alg_ecb_context;
+		caes_context   = context->fvek_encryption_context;
+	}
+	switch( context->crypto_backend )
+	{
+		case LIBBDE_CRYPTO_BACKEND_PORTABLE:
+			if( ( ( block_keys_data_size % 16 ) != 0 )
+			 || ( output_data_size < block_keys_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid block keys data size value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			result = 1;
+
+			for( data_offset = 0;
+			     data_offset < block_keys_data_size;
+			     data_offset += 16 )
+			{
+				result = libcaes_crypt_ecb(
+				          caes_context,
+				          LIBCAES_CRYPT_MODE_ENCRYPT,
+				          &( block_keys_data[ data_offset ] ),
+				          16,
+				          &( output_data[ data_offset ] ),
+				          16,
+				          error );
+
+				if( result != 1 )
+				{
+					break;
+				}
+			}
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AES_NI:
+			result = libbde_aes_ni_encrypt_ecb(
+			          key_schedule,
+			          block_keys_data,
+			          block_keys_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_VAES:
+			result = libbde_aes_vaes_encrypt_ecb(
+			          key_schedule,
+			          block_keys_data,
+			          block_keys_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_OPENSSL:
+			result = libbde_aes_evp_encrypt_ecb(
+			          evp_context,
+			          block_keys_data,
+			          block_keys_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AF_ALG:
+			result = libbde_aes_af_alg_encrypt_ecb(
+			          af_alg_context,
+			          block_keys_data,
+			          block_keys_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported crypto backend.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to AES-ECB encrypt block keys.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts consecutive AES-CBC sectors, each with its own initialization vector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_cbc_sectors(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_decrypt_cbc_sectors";
+	size_t sector_offset  = 0;
+	size_t vector_offset  = 0;
+	int result            = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( context->crypto_backend )
+	{
+		case LIBBDE_CRYPTO_BACKEND_PORTABLE:
+			/* libcaes has no batched AES-CBC hence the sectors
+			 * are decrypted one at a time
+			 */
+			if( ( bytes_per_sector == 0 )
+			 || ( ( input_data_size % bytes_per_sector ) != 0 )
+			 || ( initialization_vectors_size < ( ( input_data_size / bytes_per_sector ) * 16 ) )
+			 || ( output_data_size < input_data_size ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid input data size value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			result = 1;
+
+			for( sector_offset = 0;
+			     sector_offset < input_data_size;
+			     sector_offset += bytes_per_sector )
+			{
+				result = libcaes_crypt_cbc(
+				          context->fvek_decryption_context,
+				          LIBCAES_CRYPT_MODE_DECRYPT,
+				          &( initialization_vectors[ vector_offset ] ),
+				          16,
+				          &( input_data[ sector_offset ] ),
+				          bytes_per_sector,
+				          &( output_data[ sector_offset ] ),
+				          bytes_per_sector,
+				          error );
+
+				if( result != 1 )
+				{
+					break;
+				}
+				vector_offset += 16;
+			}
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AES_NI:
+			result = libbde_aes_ni_decrypt_cbc(
+			          &( context->fvek_key_schedule ),
+			          initialization_vectors,
+			          initialization_vectors_size,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_VAES:
+			result = libbde_aes_vaes_decrypt_cbc(
+			          &( context->fvek_key_schedule ),
+			          initialization_vectors,
+			          initialization_vectors_size,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_OPENSSL:
+			result = libbde_aes_evp_decrypt_cbc(
+			          context->fvek_evp_decryption_context,
+			          initialization_vectors,
+			          initialization_vectors_size,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AF_ALG:
+			result = libbde_aes_af_alg_decrypt_cbc(
+			          context->fvek_af_alg_context,
+			          initialization_vectors,
+			          initialization_vectors_size,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported crypto backend.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to AES-CBC decrypt sectors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts consecutive AES-XTS sectors
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_xts_sectors(
+     libbde_encryption_context_t *context,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	libbde_aes_evp_context_t *evp_context = NULL;
+	static char *function                 = "libbde_encryption_crypt_xts_sectors";
+	int result                            = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	switch( context->crypto_backend )
+	{
+		case LIBBDE_CRYPTO_BACKEND_AES_NI:
+			result = libbde_aes_ni_crypt_xts(
+			          &( context->fvek_key_schedule ),
+			          &( context->tweak_key_schedule ),
+			          mode,
+			          sector_number,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_VAES:
+			result = libbde_aes_vaes_crypt_xts(
+			          &( context->fvek_key_schedule ),
+			          &( context->tweak_key_schedule ),
+			          mode,
+			          sector_number,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_OPENSSL:
+			if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+			{
+				evp_context = context->fvek_evp_encryption_context;
+			}
+			else
+			{
+				evp_context = context->fvek_evp_decryption_context;
+			}
+			result = libbde_aes_evp_crypt_xts(
+			          evp_context,
+			          sector_number,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		case LIBBDE_CRYPTO_BACKEND_AF_ALG:
+			result = libbde_aes_af_alg_crypt_xts(
+			          context->fvek_af_alg_context,
+			          mode,
+			          sector_number,
+			          bytes_per_sector,
+			          input_data,
+			          input_data_size,
+			          output_data,
+			          output_data_size,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported crypto backend.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to AES-XTS de- or encrypt sectors.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts an AES-CBC Diffuser sector
+ * The sector is AES-CBC decrypted, Diffuser decrypted and XOR-ed with the sector
+ * key data while it still resides in the CPU cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_diffuser_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t sector_size,
+     libcerror_error_t **error )
+{
+	uint64_t sector_key_values[ 4 ];
+
+	uint64_t *values_64bit  = NULL;
+	static char *function   = "libbde_encryption_decrypt_diffuser_sector";
+	size_t data_index       = 0;
+	size_t number_of_values = 0;
+	size_t value_index      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_key_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( sector_size > (size_t) SSIZE_MAX )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->crypto_backend != LIBBDE_CRYPTO_BACKEND_PORTABLE )
+	{
+		if( libbde_encryption_decrypt_cbc_sectors(
+		     context,
+		     initialization_vector,
+		     16,
+		     sector_size,
+		     input_data,
+		     sector_size,
+		     output_data,
+		     sector_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to AES-CBC decrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		if( libcaes_crypt_cbc(
+		     context->fvek_decryption_context,
+		     LIBCAES_CRYPT_MODE_DECRYPT,
+		     initialization_vector,
+		     16,
+		     input_data,
+		     sector_size,
+		     output_data,
+		     sector_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to AES-CBC decrypt sector.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbde_diffuser_decrypt(
+	     output_data,
+	     sector_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data using Diffuser.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sector key data is XOR-ed 64-bit at a time, its byte order
+	 * is the same as that of the sector data
+	 */
+	if( ( ( (intptr_t) output_data % sizeof( uint64_t ) ) == 0 )
+	 && ( ( sector_size % 32 ) == 0 ) )
+	{
+		if( memory_copy(
+		     sector_key_values,
+		     sector_key_data,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy sector key data.",
+			 function );
+
+			return( -1 );
+		}
+		values_64bit     = (uint64_t *) output_data;
+		number_of_values = sector_size / sizeof( uint64_t );
+
+		for( value_index = 0;
+		     value_index < number_of_values;
+		     value_index += 4 )
+		{
+			values_64bit[ value_index ]     ^= sector_key_values[ 0 ];
+			values_64bit[ value_index + 1 ] ^= sector_key_values[ 1 ];
+			values_64bit[ value_index + 2 ] ^= sector_key_values[ 2 ];
+			values_64bit[ value_index + 3 ] ^= sector_key_values[ 3 ];
+		}
+	}
+	else
 	{
-/* TODO safe guard input data ? */
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		for( data_index = 0;
+		     data_index < sector_size;
+		     data_index++ )
 		{
-			sector_key_data_index = 0;
+			output_data[ data_index ] ^= sector_key_data[ data_index % 32 ];
+		}
+	}
+	return( 1 );
+}
 
-			for( data_index = 0;
-			     data_index < input_data_size;
-			     data_index++ )
-			{
-				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
+/* De- or encrypts consecutive sectors
+ * The sectors offset is the offset of the first sector relative to the start
+ * of the volume. AES-XTS sectors are de- or encrypted in a single pass using
+ * the crypto backend, unless it is the portable crypto backend, in which case
+ * the sectors are de- or encrypted one at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_sectors(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t sectors_offset,
+     size_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	uint8_t block_keys_data[ LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ];
+	uint8_t initialization_vectors[ LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16 ];
+	uint8_t sector_keys_data[ LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ];
+
+	static char *function     = "libbde_encryption_crypt_sectors";
+	size_t batch_size         = 0;
+	size_t data_index         = 0;
+	size_t data_offset        = 0;
+	size_t sector_data_offset = 0;
+	size_t sector_index       = 0;
+	uint64_t block_key        = 0;
+	uint8_t is_diffuser       = 0;
+	uint8_t is_xts            = 0;
+	int result                = 0;
 
-				sector_key_data_index++;
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
 
-				if( sector_key_data_index >= 32 )
-				{
-					sector_key_data_index -= 32;
-				}
-			}
-			if( libbde_diffuser_encrypt(
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
-				 "%s: unable to encrypt data using Diffuser.",
-				 function );
+		return( -1 );
+	}
+	if( ( bytes_per_sector == 0 )
+	 || ( ( sectors_offset % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sectors offset value out of bounds.",
+		 function );
 
-				return( -1 );
-			}
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		is_xts = 1;
+	}
+	if( ( is_xts != 0 )
+	 && ( context->crypto_backend != LIBBDE_CRYPTO_BACKEND_PORTABLE )
+	 && ( context->engine != LIBBDE_ENCRYPTION_ENGINE_GENERIC )
+	 && ( ( bytes_per_sector % 16 ) == 0 ) )
+	{
+		if( libbde_encryption_crypt_xts_sectors(
+		     context,
+		     mode,
+		     sectors_offset / bytes_per_sector,
+		     bytes_per_sector,
+		     input_data,
+		     input_data_size,
+		     output_data,
+		     output_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to AES-XTS de- or encrypt sectors.",
+			 function );
+
+			return( -1 );
 		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		return( 1 );
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		is_diffuser = 1;
+	}
+	/* The portable crypto backend has no batched AES, hence it only uses
+	 * the batch passes for the staged engine
+	 */
+	if( ( is_xts == 0 )
+	 && ( ( context->crypto_backend != LIBBDE_CRYPTO_BACKEND_PORTABLE )
+	  || ( context->engine == LIBBDE_ENCRYPTION_ENGINE_STAGED ) )
+	 && ( context->engine != LIBBDE_ENCRYPTION_ENGINE_GENERIC )
+	 && ( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( ( bytes_per_sector % 16 ) == 0 ) )
+	{
+		/* The initialization vectors and sector keys of a batch of sectors
+		 * are computed in a single AES-ECB pass, after which all the blocks
+		 * of the batch are AES-CBC decrypted in a single pass
+		 */
+		while( data_offset < input_data_size )
 		{
-			if( libcaes_crypt_cbc(
-			     context->fvek_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
+			batch_size = input_data_size - data_offset;
+
+			if( batch_size > ( LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * bytes_per_sector ) )
+			{
+				batch_size = LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * bytes_per_sector;
+			}
+			if( memory_set(
+			     block_keys_data,
+			     0,
+			     LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-CBC encrypt output data.",
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear block keys data.",
 				 function );
 
 				return( -1 );
 			}
-		}
-		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
-		{
-			if( libcaes_crypt_xts(
-			     context->fvek_decryption_tweaked_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
+			for( sector_index = 0;
+			     ( sector_index * bytes_per_sector ) < batch_size;
+			     sector_index++ )
+			{
+				byte_stream_copy_from_uint64_little_endian(
+				 &( block_keys_data[ sector_index * 16 ] ),
+				 sectors_offset + (uint64_t) ( data_offset + ( sector_index * bytes_per_sector ) ) );
+			}
+			/* The block keys for the initialization vectors are encrypted
+			 * with the FVEK
+			 */
+			if( libbde_encryption_encrypt_block_keys(
+			     context,
+			     0,
+			     block_keys_data,
+			     sector_index * 16,
+			     initialization_vectors,
+			     LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
 				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-XTS decrypt output data.",
+				 "%s: unable to encrypt initialization vectors.",
 				 function );
 
 				return( -1 );
 			}
-		}
-	}
-	else
-	{
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
-		{
-			if( libcaes_crypt_cbc(
-			     context->fvek_decryption_context,
-			     LIBCAES_CRYPT_MODE_DECRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
+			if( is_diffuser != 0 )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-CBC decrypt output data.",
-				 function );
+				/* The block keys for the sector key data are encrypted
+				 * with the TWEAK key, where the last byte of the second
+				 * block key contains 0x80 (128)
+				 */
+				if( memory_set(
+				     block_keys_data,
+				     0,
+				     LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear block keys data.",
+					 function );
+
+					return( -1 );
+				}
+				for( sector_index = 0;
+				     ( sector_index * bytes_per_sector ) < batch_size;
+				     sector_index++ )
+				{
+					byte_stream_copy_from_uint64_little_endian(
+					 &( block_keys_data[ sector_index * 32 ] ),
+					 sectors_offset + (uint64_t) ( data_offset + ( sector_index * bytes_per_sector ) ) );
 
-				return( -1 );
+					byte_stream_copy_from_uint64_little_endian(
+					 &( block_keys_data[ ( sector_index * 32 ) + 16 ] ),
+					 sectors_offset + (uint64_t) ( data_offset + ( sector_index * bytes_per_sector ) ) );
+
+					block_keys_data[ ( sector_index * 32 ) + 31 ] = 0x80;
+				}
+				if( libbde_encryption_encrypt_block_keys(
+				     context,
+				     1,
+				     block_keys_data,
+				     sector_index * 32,
+				     sector_keys_data,
+				     LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+					 "%s: unable to encrypt sector key data.",
+					 function );
+
+					return( -1 );
+				}
 			}
-		}
-		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
-		{
-			if( libcaes_crypt_xts(
-			     context->fvek_decryption_tweaked_context,
-			     LIBCAES_CRYPT_MODE_DECRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
+			if( ( is_diffuser != 0 )
+			 && ( context->engine == LIBBDE_ENCRYPTION_ENGINE_FUSED ) )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-XTS decrypt output data.",
-				 function );
+				for( sector_index = 0;
+				     ( sector_index * bytes_per_sector ) < batch_size;
+				     sector_index++ )
+				{
+					sector_data_offset = data_offset + ( sector_index * bytes_per_sector );
+
+					if( libbde_encryption_decrypt_diffuser_sector(
+					     context,
+					     &( initialization_vectors[ sector_index * 16 ] ),
+					     &( sector_keys_data[ sector_index * 32 ] ),
+					     &( input_data[ sector_data_offset ] ),
+					     &( output_data[ sector_data_offset ] ),
+					     bytes_per_sector,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+						 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+						 "%s: unable to decrypt Diffuser sector at offset: %" PRIu64 ".",
+						 function,
+						 sectors_offset + (uint64_t) sector_data_offset );
+
+						return( -1 );
+					}
+				}
+				data_offset += batch_size;
 
-				return( -1 );
+				continue;
 			}
-		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
-		{
-			if( libbde_diffuser_decrypt(
-			     output_data,
-			     output_data_size,
+			if( libbde_encryption_decrypt_cbc_sectors(
+			     context,
+			     initialization_vectors,
+			     LIBBDE_ENCRYPTION_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16,
+			     bytes_per_sector,
+			     &( input_data[ data_offset ] ),
+			     batch_size,
+			     &( output_data[ data_offset ] ),
+			     batch_size,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-				 "%s: unable to decrypt data using Diffuser.",
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to AES-CBC decrypt sectors.",
 				 function );
 
 				return( -1 );
 			}
-			sector_key_data_index = 0;
-
-			for( data_index = 0;
-			     data_index < input_data_size;
-			     data_index++ )
+			if( is_diffuser != 0 )
 			{
-				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
-
-				sector_key_data_index++;
-
-				if( sector_key_data_index >= 32 )
+				for( sector_index = 0;
+				     ( sector_index * bytes_per_sector ) < batch_size;
+				     sector_index++ )
 				{
-					sector_key_data_index -= 32;
+					sector_data_offset = data_offset + ( sector_index * bytes_per_sector );
+
+					if( libbde_diffuser_decrypt(
+					     &( output_data[ sector_data_offset ] ),
+					     bytes_per_sector,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+						 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+						 "%s: unable to decrypt data using Diffuser.",
+						 function );
+
+						return( -1 );
+					}
+					for( data_index = 0;
+					     data_index < bytes_per_sector;
+					     data_index++ )
+					{
+						output_data[ sector_data_offset + data_index ] ^= sector_keys_data[ ( sector_index * 32 ) + ( data_index % 32 ) ];
+					}
 				}
 			}
+			data_offset += batch_size;
+		}
+		return( 1 );
+	}
+	for( data_offset = 0;
+	     data_offset < input_data_size;
+	     data_offset += bytes_per_sector )
+	{
+		block_key = sectors_offset + (uint64_t) data_offset;
+
+		if( is_xts != 0 )
+		{
+			block_key /= bytes_per_sector;
+		}
+		/* The generic engine uses libbde_encryption_crypt to verify
+		 * the method specific decrypt functions
+		 */
+		if( ( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+		 && ( context->engine != LIBBDE_ENCRYPTION_ENGINE_GENERIC ) )
+		{
+			result = libbde_encryption_decrypt_sector(
+			          context,
+			          &( input_data[ data_offset ] ),
+			          bytes_per_sector,
+			          &( output_data[ data_offset ] ),
+			          bytes_per_sector,
+			          block_key,
+			          error );
+		}
+		else
+		{
+			result = libbde_encryption_crypt(
+			          context,
+			          mode,
+			          &( input_data[ data_offset ] ),
+			          bytes_per_sector,
+			          &( output_data[ data_offset ] ),
+			          bytes_per_sector,
+			          block_key,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to de- or encrypt sector at offset: %" PRIu64 ".",
+			 function,
+			 sectors_offset + (uint64_t) data_offset );
+
+			return( -1 );
 		}
 	}
 	return( 1 );
@@ -25,6 +25,9 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbde_aes_af_alg.h"
+#include "libbde_aes_evp.h"
+#include "libbde_aes_ni.h"
 #include "libbde_libcaes.h"
 #include "libbde_libcerror.h"
 
@@ -32,6 +35,8 @@
 extern "C" {
 #endif
 
+extern int libbde_encryption_crypto_backend;
+
 typedef struct libbde_encryption_context libbde_encryption_context_t;
 
 struct libbde_encryption_context
@@ -63,8 +68,90 @@ struct libbde_encryption_context
 	/* The FVEK (AES) encryption tweaked context
 	 */
 	libcaes_tweaked_context_t *fvek_encryption_tweaked_context;
+
+	/* The full volume encryption key, used to clone the context
+	 */
+	uint8_t full_volume_encryption_key[ 64 ];
+
+	/* The size of the full volume encryption key
+	 */
+	size_t full_volume_encryption_key_size;
+
+	/* The tweak key, used to clone the context
+	 */
+	uint8_t tweak_key[ 64 ];
+
+	/* The size of the tweak key
+	 */
+	size_t tweak_key_size;
+
+	/* The FVEK AES-NI key schedule
+	 */
+	libbde_aes_ni_key_schedule_t fvek_key_schedule;
+
+	/* The TWEAK key AES-NI key schedule
+	 */
+	libbde_aes_ni_key_schedule_t tweak_key_schedule;
+
+	/* The FVEK OpenSSL EVP AES-ECB encryption context
+	 */
+	libbde_aes_evp_context_t *fvek_evp_ecb_context;
+
+	/* The TWEAK key OpenSSL EVP AES-ECB encryption context
+	 */
+	libbde_aes_evp_context_t *tweak_evp_ecb_context;
+
+	/* The FVEK OpenSSL EVP AES-CBC or AES-XTS decryption context
+	 */
+	libbde_aes_evp_context_t *fvek_evp_decryption_context;
+
+	/* The FVEK OpenSSL EVP AES-XTS encryption context
+	 */
+	libbde_aes_evp_context_t *fvek_evp_encryption_context;
+
+	/* The FVEK Linux kernel crypto API (AF_ALG) AES-ECB context
+	 */
+	libbde_aes_af_alg_context_t *fvek_af_alg_ecb_context;
+
+	/* The TWEAK key Linux kernel crypto API (AF_ALG) AES-ECB context
+	 */
+	libbde_aes_af_alg_context_t *tweak_af_alg_ecb_context;
+
+	/* The FVEK Linux kernel crypto API (AF_ALG) AES-CBC or AES-XTS context
+	 */
+	libbde_aes_af_alg_context_t *fvek_af_alg_context;
+
+	/* The crypto backend
+	 */
+	int crypto_backend;
+
+	/* The engine used to decrypt AES-CBC Diffuser sectors
+	 */
+	int engine;
+
+	/* The method specific function used to decrypt a single sector
+	 */
+	int (*decrypt_sector)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *input_data,
+	       size_t input_data_size,
+	       uint8_t *output_data,
+	       size_t output_data_size,
+	       uint64_t block_key,
+	       libcerror_error_t **error );
 };
 
+int libbde_encryption_crypto_backend_is_supported(
+     int crypto_backend );
+
+int libbde_encryption_get_crypto_backend(
+     int *crypto_backend,
+     libcerror_error_t **error );
+
+int libbde_encryption_set_crypto_backend(
+     int crypto_backend,
+     libcerror_error_t **error );
+
 int libbde_encryption_initialize(
      libbde_encryption_context_t **context,
      uint16_t method,
@@ -74,6 +161,16 @@ int libbde_encryption_free(
      libbde_encryption_context_t **context,
      libcerror_error_t **error );
 
+int libbde_encryption_clone(
+     libbde_encryption_context_t **destination_context,
+     libbde_encryption_context_t *source_context,
+     libcerror_error_t **error );
+
+int libbde_encryption_set_engine(
+     libbde_encryption_context_t *context,
+     int engine,
+     libcerror_error_t **error );
+
 int libbde_encryption_set_keys(
      libbde_encryption_context_t *context,
      const uint8_t *full_volume_encryption_key,
@@ -82,6 +179,20 @@ int libbde_encryption_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error );
 
+int libbde_encryption_set_evp_keys(
+     libbde_encryption_context_t *context,
+     const uint8_t *full_volume_encryption_key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_set_af_alg_keys(
+     libbde_encryption_context_t *context,
+     const uint8_t *full_volume_encryption_key,
+     const uint8_t *tweak_key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
 int libbde_encryption_crypt(
      libbde_encryption_context_t *context,
      int mode,
@@ -92,6 +203,93 @@ int libbde_encryption_crypt(
      uint64_t block_key,
      libcerror_error_t **error );
 
+int libbde_encryption_decrypt_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_aes_cbc_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_aes_cbc_diffuser_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_aes_xts_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_block_keys(
+     libbde_encryption_context_t *context,
+     uint8_t use_tweak_key,
+     const uint8_t *block_keys_data,
+     size_t block_keys_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_cbc_sectors(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_xts_sectors(
+     libbde_encryption_context_t *context,
+     int mode,
+     uint64_t sector_number,
+     size_t bytes_per_sector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_diffuser_sector(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t sector_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_sectors(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t sectors_offset,
+     size_t bytes_per_sector,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -98,20 +98,6 @@ int libbde_external_key_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_array_initialize(
-	     &( ( *external_key )->entries_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create entries array.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -164,19 +150,10 @@ int libbde_external_key_free(
 				result = -1;
 			}
 		}
-		if( libcdata_array_free(
-		     &( ( *external_key )->entries_array ),
-		     (int(*)(intptr_t **, libcerror_error_t **)) &libbde_metadata_entry_free,
-		     error ) != 1 )
+		if( ( *external_key )->entries != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free entries array.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *external_key )->entries );
 		}
 		memory_free(
 		 *external_key );
@@ -196,11 +173,12 @@ int libbde_external_key_read(
 {
 	libbde_key_t *key                                = NULL;
 	libbde_metadata_entry_t *property_metadata_entry = NULL;
-	uint8_t *value_data                              = NULL;
+	const uint8_t *value_data                        = NULL;
 	static char *function                            = "libbde_external_key_read";
 	size_t value_data_size                           = 0;
 	ssize_t read_count                               = 0;
 	int property_metadata_entry_index                = 0;
+	int number_of_entries                            = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	system_character_t filetime_string[ 32 ];
@@ -430,6 +408,24 @@ int libbde_external_key_read(
 	value_data      += sizeof( bde_metadata_entry_external_key_header_t );
 	value_data_size -= sizeof( bde_metadata_entry_external_key_header_t );
 
+	if( libbde_metadata_entry_initialize_entries(
+	     &( external_key->entries ),
+	     &number_of_entries,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create property metadata entries.",
+		 function );
+
+		goto on_error;
+	}
+	external_key->number_of_entries = number_of_entries;
+
 	while( value_data_size >= sizeof( bde_metadata_entry_v1_t ) )
 	{
 		if( memory_compare(
@@ -439,19 +435,19 @@ int libbde_external_key_read(
 		{
 			break;
 		}
-		if( libbde_metadata_entry_initialize(
-		     &property_metadata_entry,
-		     error ) != 1 )
+		if( property_metadata_entry_index >= number_of_entries )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create property metadata entry.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid property metadata entry index value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
+		property_metadata_entry = &( external_key->entries[ property_metadata_entry_index ] );
+
 		read_count = libbde_metadata_entry_read(
 			      property_metadata_entry,
 			      value_data,
@@ -546,22 +542,7 @@ int libbde_external_key_read(
 				external_key->string_entry = property_metadata_entry;
 			}
 		}
-		if( libcdata_array_append_entry(
-		     external_key->entries_array,
-		     &property_metadata_entry_index,
-		     (intptr_t *) property_metadata_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to append property metadata entry to entries array.",
-			 function );
-
-			goto on_error;
-		}
-		property_metadata_entry = NULL;
+		property_metadata_entry_index++;
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -601,12 +582,6 @@ on_error:
 		 &key,
 		 NULL );
 	}
-	if( property_metadata_entry != NULL )
-	{
-		libbde_metadata_entry_free(
-		 &property_metadata_entry,
-		 NULL );
-	}
 	return( -1 );
 }
 
@@ -44,6 +44,7 @@ struct libbde_external_key
 	uint8_t identifier[ 16 ];
 
 	/* The string metadata entry
+	 * references one of the entries
 	 */
 	libbde_metadata_entry_t *string_entry;
 
@@ -51,9 +52,14 @@ struct libbde_external_key
 	 */
 	libbde_key_t *key;
 
-	/* The metadata entries array
+	/* The property metadata entries
+	 * stored as a single contiguous block
 	 */
-	libcdata_array_t *entries_array;
+	libbde_metadata_entry_t *entries;
+
+	/* The number of property metadata entries
+	 */
+	int number_of_entries;
 };
 
 int libbde_external_key_initialize(
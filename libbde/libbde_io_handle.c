@@ -31,11 +31,9 @@
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
+#include "libbde_libcthreads.h"
 #include "libbde_libfguid.h"
 #include "libbde_sector_data.h"
-#include "libbde_unused.h"
 
 #include "bde_volume.h"
 
@@ -106,6 +104,21 @@ int libbde_io_handle_initialize(
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->file_io_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO mutex.",
+		 function );
+
+		goto on_error;
+	}
+#endif
 	( *io_handle )->bytes_per_sector = 512;
 
 	return( 1 );
@@ -157,6 +170,21 @@ int libbde_io_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->file_io_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -230,6 +258,24 @@ int libbde_io_handle_clear(
 
 		result = -1;
 	}
+	if( memory_set(
+	     io_handle->volume_master_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear volume master key.",
+		 function );
+
+		result = -1;
+	}
+	io_handle->volume_master_key_is_set = 0;
+
+	io_handle->mapped_data      = NULL;
+	io_handle->mapped_data_size = 0;
 	io_handle->bytes_per_sector = 512;
 
 	return( result );
@@ -244,21 +290,10 @@ int libbde_io_handle_read_volume_header(
      off64_t file_offset,
      libcerror_error_t **error )
 {
-	uint8_t *volume_header_data      = NULL;
-	static char *function            = "libbde_io_handle_read_volume_header";
-	size_t read_size                 = 512;
-	ssize_t read_count               = 0;
-	uint64_t total_number_of_sectors = 0;
+	uint8_t volume_header_data[ 512 ];
 
-#if defined( HAVE_DEBUG_OUTPUT )
-	system_character_t guid_string[ 48 ];
-
-	libfguid_identifier_t *guid      = NULL;
-	uint64_t value_64bit             = 0;
-	uint32_t value_32bit             = 0;
-	uint16_t value_16bit             = 0;
-	int result                       = 0;
-#endif
+	static char *function = "libbde_io_handle_read_volume_header";
+	ssize_t read_count    = 0;
 
 	if( io_handle == NULL )
 	{
@@ -269,7 +304,7 @@ int libbde_io_handle_read_volume_header(
 		 "%s: invalid IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -295,38 +330,98 @@ int libbde_io_handle_read_volume_header(
 		 function,
 		 file_offset );
 
-		goto on_error;
+		return( -1 );
 	}
-	volume_header_data = (uint8_t *) memory_allocate(
-	                                  sizeof( uint8_t ) * read_size );
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              volume_header_data,
+	              512,
+	              error );
 
-	if( volume_header_data == NULL )
+	if( read_count != (ssize_t) 512 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create volume header data.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header data.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              volume_header_data,
-	              read_size,
-	              error );
-
-	if( read_count != (ssize_t) read_size )
+	if( libbde_io_handle_read_volume_header_data(
+	     io_handle,
+	     volume_header_data,
+	     512,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header data.",
+		 "%s: unable to read volume header.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the volume header data
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_read_volume_header_data(
+     libbde_io_handle_t *io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libbde_io_handle_read_volume_header_data";
+	uint64_t total_number_of_sectors = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	system_character_t guid_string[ 48 ];
+
+	libfguid_identifier_t *guid      = NULL;
+	uint64_t value_64bit             = 0;
+	uint32_t value_32bit             = 0;
+	uint16_t value_16bit             = 0;
+	int result                       = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < 512 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -335,32 +430,32 @@ int libbde_io_handle_read_volume_header(
 		 "%s: volume header data:\n",
 		 function );
 		libcnotify_print_data(
-		 volume_header_data,
-		 read_size,
+		 data,
+		 512,
 		 0 );
 	}
 #endif
 	if( memory_compare(
-	     volume_header_data,
+	     data,
 	     bde_boot_entry_point_vista,
 	     3 ) == 0 )
 	{
 		io_handle->version = LIBBDE_VERSION_WINDOWS_VISTA;
 	}
 	else if( memory_compare(
-	          volume_header_data,
+	          data,
 	          bde_boot_entry_point_win7,
 	          3 ) == 0 )
 	{
 		if( memory_compare(
-		     ( (bde_volume_header_windows_7_t *) volume_header_data )->identifier,
+		     ( (bde_volume_header_windows_7_t *) data )->identifier,
 		     bde_identifier,
 		     16 ) == 0 )
 		{
 			io_handle->version = LIBBDE_VERSION_WINDOWS_7;
 		}
 		else if( memory_compare(
-		          ( (bde_volume_header_to_go_t *) volume_header_data )->identifier,
+		          ( (bde_volume_header_to_go_t *) data )->identifier,
 		          bde_identifier,
 		          16 ) == 0 )
 		{
@@ -393,7 +488,7 @@ int libbde_io_handle_read_volume_header(
 	 || ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 ) )
 	{
 		if( memory_compare(
-		     &( volume_header_data[ 3 ] ),
+		     &( data[ 3 ] ),
 		     bde_signature,
 		     8 ) != 0 )
 		{
@@ -408,60 +503,60 @@ int libbde_io_handle_read_volume_header(
 		}
 	}
 	byte_stream_copy_to_uint16_little_endian(
-	 ( (bde_volume_header_windows_vista_t *) volume_header_data )->bytes_per_sector,
+	 ( (bde_volume_header_windows_vista_t *) data )->bytes_per_sector,
 	 io_handle->bytes_per_sector );
 
-	io_handle->sectors_per_cluster_block = ( (bde_volume_header_windows_vista_t *) volume_header_data )->sectors_per_cluster_block;
+	io_handle->sectors_per_cluster_block = ( (bde_volume_header_windows_vista_t *) data )->sectors_per_cluster_block;
 
 	byte_stream_copy_to_uint16_little_endian(
-	 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_16bit,
+	 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_16bit,
 	 total_number_of_sectors );
 
 	if( total_number_of_sectors == 0 )
 	{
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_32bit,
+		 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_32bit,
 		 total_number_of_sectors );
 	}
 	if( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
 	{
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->first_metadata_cluster_block_number,
+		 ( (bde_volume_header_windows_vista_t *) data )->first_metadata_cluster_block_number,
 		 io_handle->first_metadata_offset );
 
 		if( total_number_of_sectors == 0 )
 		{
 			byte_stream_copy_to_uint64_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_64bit,
+			 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_64bit,
 			 total_number_of_sectors );
 		}
 	}
 	else if( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
 	{
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_windows_7_t *) volume_header_data )->first_metadata_offset,
+		 ( (bde_volume_header_windows_7_t *) data )->first_metadata_offset,
 		 io_handle->first_metadata_offset );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_windows_7_t *) volume_header_data )->second_metadata_offset,
+		 ( (bde_volume_header_windows_7_t *) data )->second_metadata_offset,
 		 io_handle->second_metadata_offset );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_windows_7_t *) volume_header_data )->third_metadata_offset,
+		 ( (bde_volume_header_windows_7_t *) data )->third_metadata_offset,
 		 io_handle->third_metadata_offset );
 	}
 	else if( io_handle->version == LIBBDE_VERSION_TO_GO )
 	{
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_to_go_t *) volume_header_data )->first_metadata_offset,
+		 ( (bde_volume_header_to_go_t *) data )->first_metadata_offset,
 		 io_handle->first_metadata_offset );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_to_go_t *) volume_header_data )->second_metadata_offset,
+		 ( (bde_volume_header_to_go_t *) data )->second_metadata_offset,
 		 io_handle->second_metadata_offset );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_volume_header_to_go_t *) volume_header_data )->third_metadata_offset,
+		 ( (bde_volume_header_to_go_t *) data )->third_metadata_offset,
 		 io_handle->third_metadata_offset );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -471,21 +566,21 @@ int libbde_io_handle_read_volume_header(
 		 "%s: boot entry point:\n",
 		 function );
 		libcnotify_print_data(
-		 volume_header_data,
+		 data,
 		 3,
 		 0 );
 
 		libcnotify_printf(
 		 "%s: signature\t\t\t\t: %c%c%c%c%c%c%c%c\n",
 		 function,
-		 volume_header_data[ 3 ],
-		 volume_header_data[ 4 ],
-		 volume_header_data[ 5 ],
-		 volume_header_data[ 6 ],
-		 volume_header_data[ 7 ],
-		 volume_header_data[ 8 ],
-		 volume_header_data[ 9 ],
-		 volume_header_data[ 10 ] );
+		 data[ 3 ],
+		 data[ 4 ],
+		 data[ 5 ],
+		 data[ 6 ],
+		 data[ 7 ],
+		 data[ 8 ],
+		 data[ 9 ],
+		 data[ 10 ] );
 
 		libcnotify_printf(
 		 "%s: bytes per sector\t\t\t: %" PRIu16 "\n",
@@ -501,12 +596,12 @@ int libbde_io_handle_read_volume_header(
 		 "%s: unknown1\n",
 		 function );
 		libcnotify_print_data(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->unknown1,
+		 ( (bde_volume_header_windows_vista_t *) data )->unknown1,
 		 5,
 		 0 );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_16bit,
+		 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_16bit,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: total number of sectors (16-bit)\t: %" PRIu16 "\n",
@@ -516,10 +611,10 @@ int libbde_io_handle_read_volume_header(
 		libcnotify_printf(
 		 "%s: media descriptor\t\t\t: 0x%02" PRIx8 "\n",
 		 function,
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->media_descriptor );
+		 ( (bde_volume_header_windows_vista_t *) data )->media_descriptor );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->unknown2,
+		 ( (bde_volume_header_windows_vista_t *) data )->unknown2,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: unknown2\t\t\t\t: %" PRIu16 "\n",
@@ -527,7 +622,7 @@ int libbde_io_handle_read_volume_header(
 		 value_16bit );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->sectors_per_track,
+		 ( (bde_volume_header_windows_vista_t *) data )->sectors_per_track,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: sectors per track\t\t\t: %" PRIu16 "\n",
@@ -535,7 +630,7 @@ int libbde_io_handle_read_volume_header(
 		 value_16bit );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->number_of_heads,
+		 ( (bde_volume_header_windows_vista_t *) data )->number_of_heads,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: number of heads\t\t\t: %" PRIu16 "\n",
@@ -543,7 +638,7 @@ int libbde_io_handle_read_volume_header(
 		 value_16bit );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->number_of_hidden_sectors,
+		 ( (bde_volume_header_windows_vista_t *) data )->number_of_hidden_sectors,
 		 value_32bit );
 		libcnotify_printf(
 		 "%s: number of hidden sectors\t\t: %" PRIu32 "\n",
@@ -551,7 +646,7 @@ int libbde_io_handle_read_volume_header(
 		 value_32bit );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_32bit,
+		 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_32bit,
 		 value_32bit );
 		libcnotify_printf(
 		 "%s: total number of sectors (32-bit)\t: %" PRIu32 "\n",
@@ -561,7 +656,7 @@ int libbde_io_handle_read_volume_header(
 		if( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
 		{
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->unknown4,
+			 ( (bde_volume_header_windows_vista_t *) data )->unknown4,
 			 value_32bit );
 			libcnotify_printf(
 			 "%s: unknown4\t\t\t\t: 0x%08" PRIx32 " (%" PRIu32 ")\n",
@@ -570,7 +665,7 @@ int libbde_io_handle_read_volume_header(
 			 value_32bit );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->total_number_of_sectors_64bit,
+			 ( (bde_volume_header_windows_vista_t *) data )->total_number_of_sectors_64bit,
 			 value_64bit );
 			libcnotify_printf(
 			 "%s: total number of sectors (64-bit)\t: %" PRIu64 "\n",
@@ -578,7 +673,7 @@ int libbde_io_handle_read_volume_header(
 			 value_64bit );
 
 			byte_stream_copy_to_uint64_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->mft_cluster_block_number,
+			 ( (bde_volume_header_windows_vista_t *) data )->mft_cluster_block_number,
 			 value_64bit );
 			libcnotify_printf(
 			 "%s: MFT cluster block number\t\t: %" PRIu64 "\n",
@@ -591,7 +686,7 @@ int libbde_io_handle_read_volume_header(
 			 io_handle->first_metadata_offset );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->mft_entry_size,
+			 ( (bde_volume_header_windows_vista_t *) data )->mft_entry_size,
 			 value_32bit );
 			libcnotify_printf(
 			 "%s: MFT entry size\t\t\t: %" PRIu32 "\n",
@@ -599,7 +694,7 @@ int libbde_io_handle_read_volume_header(
 			 value_32bit );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->index_entry_size,
+			 ( (bde_volume_header_windows_vista_t *) data )->index_entry_size,
 			 value_32bit );
 			libcnotify_printf(
 			 "%s: index entry size\t\t: %" PRIu32 "\n",
@@ -607,7 +702,7 @@ int libbde_io_handle_read_volume_header(
 			 value_32bit );
 
 			byte_stream_copy_to_uint64_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->volume_serial_number,
+			 ( (bde_volume_header_windows_vista_t *) data )->volume_serial_number,
 			 value_64bit );
 			libcnotify_printf(
 			 "%s: volume serial number\t\t: 0x%08" PRIx64 "\n",
@@ -615,7 +710,7 @@ int libbde_io_handle_read_volume_header(
 			 value_64bit );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->checksum,
+			 ( (bde_volume_header_windows_vista_t *) data )->checksum,
 			 value_32bit );
 			libcnotify_printf(
 			 "%s: checksum\t\t\t: 0x%08" PRIx32 "\n",
@@ -626,7 +721,7 @@ int libbde_io_handle_read_volume_header(
 			 "%s: bootcode\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_windows_vista_t *) volume_header_data )->bootcode,
+			 ( (bde_volume_header_windows_vista_t *) data )->bootcode,
 			 426,
 			 0 );
 		}
@@ -637,12 +732,12 @@ int libbde_io_handle_read_volume_header(
 			 "%s: unknown4:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->unknown4,
+			 ( (bde_volume_header_windows_7_t *) data )->unknown4,
 			 31,
 			 0 );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_serial_number,
+			 ( (bde_volume_header_windows_7_t *) data )->volume_serial_number,
 			 value_64bit );
 			libcnotify_printf(
 			 "%s: volume serial number\t\t: 0x%08" PRIx32 "\n",
@@ -652,29 +747,29 @@ int libbde_io_handle_read_volume_header(
 			libcnotify_printf(
 			 "%s: volume label\t\t\t: %c%c%c%c%c%c%c%c%c%c%c\n",
 			 function,
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 0 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 1 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 2 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 3 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 4 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 5 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 6 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 7 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 8 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 9 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->volume_label[ 10 ] );
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 0 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 1 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 2 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 3 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 4 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 5 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 6 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 7 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 8 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 9 ],
+			 ( (bde_volume_header_windows_7_t *) data )->volume_label[ 10 ] );
 
 			libcnotify_printf(
 			 "%s: file system signature\t\t: %c%c%c%c%c%c%c%c\n",
 			 function,
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 0 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 1 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 2 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 3 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 4 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 5 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 6 ],
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->file_system_signature[ 7 ] );
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 0 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 1 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 2 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 3 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 4 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 5 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 6 ],
+			 ( (bde_volume_header_windows_7_t *) data )->file_system_signature[ 7 ] );
 		}
 		if( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
 		{
@@ -682,7 +777,7 @@ int libbde_io_handle_read_volume_header(
 			 "%s: bootcode\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->bootcode,
+			 ( (bde_volume_header_windows_7_t *) data )->bootcode,
 			 47,
 			 0 );
 
@@ -701,7 +796,7 @@ int libbde_io_handle_read_volume_header(
 			}
 			if( libfguid_identifier_copy_from_byte_stream(
 			     guid,
-			     ( (bde_volume_header_windows_7_t *) volume_header_data )->identifier,
+			     ( (bde_volume_header_windows_7_t *) data )->identifier,
 			     16,
 			     LIBFGUID_ENDIAN_LITTLE,
 			     error ) != 1 )
@@ -766,7 +861,7 @@ int libbde_io_handle_read_volume_header(
 			 "%s: bootcode\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_to_go_t *) volume_header_data )->bootcode,
+			 ( (bde_volume_header_to_go_t *) data )->bootcode,
 			 335,
 			 0 );
 
@@ -785,7 +880,7 @@ int libbde_io_handle_read_volume_header(
 			}
 			if( libfguid_identifier_copy_from_byte_stream(
 			     guid,
-			     ( (bde_volume_header_to_go_t *) volume_header_data )->identifier,
+			     ( (bde_volume_header_to_go_t *) data )->identifier,
 			     16,
 			     LIBFGUID_ENDIAN_LITTLE,
 			     error ) != 1 )
@@ -868,7 +963,7 @@ int libbde_io_handle_read_volume_header(
 			 "%s: unknown5:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_windows_7_t *) volume_header_data )->unknown5,
+			 ( (bde_volume_header_windows_7_t *) data )->unknown5,
 			 310,
 			 0 );
 		}
@@ -878,12 +973,12 @@ int libbde_io_handle_read_volume_header(
 			 "%s: unknown5:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_volume_header_to_go_t *) volume_header_data )->unknown5,
+			 ( (bde_volume_header_to_go_t *) data )->unknown5,
 			 46,
 			 0 );
 		}
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_volume_header_windows_vista_t *) volume_header_data )->sector_signature,
+		 ( (bde_volume_header_windows_vista_t *) data )->sector_signature,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: sector signature\t\t\t: 0x%04" PRIx16 "\n",
@@ -911,11 +1006,6 @@ int libbde_io_handle_read_volume_header(
 	{
 		io_handle->metadata_size = 65536;
 	}
-	memory_free(
-	 volume_header_data );
-
-	volume_header_data = NULL;
-
 	return( 1 );
 
 on_error:
@@ -927,38 +1017,21 @@ on_error:
 		 NULL );
 	}
 #endif
-	if( volume_header_data != NULL )
-	{
-		memory_free(
-		 volume_header_data );
-	}
 	return( -1 );
 }
 
-/* Reads a sector
- * Callback function for the volume vector
+/* Determines the storage of the sector at a specific offset
  * Returns 1 if successful or -1 on error
  */
-int libbde_io_handle_read_sector(
+int libbde_io_handle_get_sector_storage(
      libbde_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index LIBBDE_ATTRIBUTE_UNUSED,
-     off64_t element_data_offset,
-     size64_t element_data_size LIBBDE_ATTRIBUTE_UNUSED,
-     uint32_t element_data_flags LIBBDE_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBBDE_ATTRIBUTE_UNUSED,
+     off64_t sector_offset,
+     uint8_t zero_metadata,
+     off64_t *physical_offset,
+     uint8_t *storage_type,
      libcerror_error_t **error )
 {
-	libbde_sector_data_t *sector_data = NULL;
-	static char *function             = "libbde_io_handle_read_sector";
-
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_file_index );
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_size );
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_flags );
-	LIBBDE_UNREFERENCED_PARAMETER( read_flags );
+	static char *function = "libbde_io_handle_get_sector_storage";
 
 	if( io_handle == NULL )
 	{
@@ -971,83 +1044,114 @@ int libbde_io_handle_read_sector(
 
 		return( -1 );
 	}
-/* TODO handle virtual sectors, what about different sector sizes? */
-	if( libbde_sector_data_initialize(
-	     &sector_data,
-	     (size_t) io_handle->bytes_per_sector,
-	     error ) != 1 )
+	if( sector_offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid sector offset value less than zero.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libbde_sector_data_read(
-	     sector_data,
-	     io_handle,
-	     file_io_handle,
-	     element_data_offset,
-	     io_handle->encryption_context,
-	     1,
-	     error ) != 1 )
+	if( physical_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sector data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfdata_vector_set_element_value_by_index(
-	     vector,
-	     (intptr_t *) file_io_handle,
-	     cache,
-	     element_index,
-	     (intptr_t *) sector_data,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libbde_sector_data_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
+	if( storage_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set sector data as element value.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage type.",
 		 function );
 
 		return( -1 );
 	}
-	return( 1 );
+	*physical_offset = sector_offset;
+	*storage_type    = LIBBDE_SECTOR_STORAGE_TYPE_SPARSE;
 
-on_error:
-	if( sector_data != NULL )
+	if( zero_metadata != 0 )
 	{
-		libbde_sector_data_free(
-		 &sector_data,
-		 NULL );
+		/* The BitLocker metadata areas are represented as zero byte blocks
+		 */
+		if( ( ( sector_offset >= io_handle->first_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->first_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
+		 || ( ( sector_offset >= io_handle->second_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->second_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
+		 || ( ( sector_offset >= io_handle->third_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->third_metadata_offset + (off64_t) io_handle->metadata_size ) ) ) )
+		{
+			return( 1 );
+		}
 	}
-	return( -1 );
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
+	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
+	{
+		if( zero_metadata != 0 )
+		{
+			if( ( sector_offset >= io_handle->volume_header_offset )
+			 && ( sector_offset < ( io_handle->volume_header_offset + (off64_t) io_handle->volume_header_size ) ) )
+			{
+				return( 1 );
+			}
+		}
+		/* Normally the first 8192 bytes are stored in another location on the volume
+		 */
+		if( (size64_t) sector_offset < io_handle->volume_header_size )
+		{
+			*physical_offset += io_handle->volume_header_offset;
+		}
+	}
+	/* In Windows Vista the first 16 sectors are unencrypted
+	 */
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+	 && ( (size64_t) *physical_offset < 8192 ) )
+	{
+		*storage_type = LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED;
+	}
+	/* Check if the offset is outside the encrypted part of the volume
+	 */
+	else if( ( io_handle->encrypted_volume_size != 0 )
+	      && ( *physical_offset >= (off64_t) io_handle->encrypted_volume_size ) )
+	{
+		*storage_type = LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED;
+	}
+	else
+	{
+		*storage_type = LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED;
+	}
+	return( 1 );
 }
 
-/* Reads the unencrypted volume header
+/* Determines the run of contiguous sectors that share the same storage
+ * The run starts at the sectors offset and is at most the maximum run size
+ * The sectors offset and maximum run size must be a multiple of the bytes per sector
  * Returns 1 if successful or -1 on error
  */
-int libbde_io_handle_read_unencrypted_volume_header(
+int libbde_io_handle_get_sectors_run(
      libbde_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
+     off64_t sectors_offset,
+     size_t maximum_run_size,
+     uint8_t zero_metadata,
+     off64_t *physical_offset,
+     uint8_t *storage_type,
+     size_t *run_size,
      libcerror_error_t **error )
 {
-	libbde_sector_data_t *sector_data = NULL;
-	uint8_t *volume_header_data       = NULL;
-	static char *function             = "libbde_io_handle_read_unencrypted_volume_header";
-	off64_t volume_header_offset      = 0;
-	uint64_t total_number_of_sectors  = 0;
+	static char *function        = "libbde_io_handle_get_sectors_run";
+	size_t safe_run_size         = 0;
+	off64_t next_physical_offset = 0;
+	uint8_t next_storage_type    = 0;
 
 	if( io_handle == NULL )
 	{
@@ -1058,44 +1162,719 @@ int libbde_io_handle_read_unencrypted_volume_header(
 		 "%s: invalid IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
-	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
+	if( io_handle->bytes_per_sector == 0 )
 	{
-		volume_header_offset = io_handle->volume_header_offset;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( maximum_run_size < io_handle->bytes_per_sector )
+	 || ( maximum_run_size > (size_t) SSIZE_MAX ) )
 	{
-		libcnotify_printf(
-		 "%s: reading unencrypted volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-		 function,
-		 volume_header_offset,
-		 volume_header_offset );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum run size value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( libbde_sector_data_initialize(
-	     &sector_data,
-	     io_handle->bytes_per_sector,
-	     error ) != 1 )
+	if( physical_offset == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid physical offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libbde_sector_data_read(
-	     sector_data,
+	if( storage_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid storage type.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_io_handle_get_sector_storage(
 	     io_handle,
-	     file_io_handle,
-	     volume_header_offset,
-	     io_handle->encryption_context,
-	     0,
+	     sectors_offset,
+	     zero_metadata,
+	     physical_offset,
+	     storage_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine storage of sector at offset: %" PRIi64 ".",
+		 function,
+		 sectors_offset );
+
+		return( -1 );
+	}
+	safe_run_size = io_handle->bytes_per_sector;
+
+	while( safe_run_size < maximum_run_size )
+	{
+		if( libbde_io_handle_get_sector_storage(
+		     io_handle,
+		     sectors_offset + (off64_t) safe_run_size,
+		     zero_metadata,
+		     &next_physical_offset,
+		     &next_storage_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine storage of sector at offset: %" PRIi64 ".",
+			 function,
+			 sectors_offset + (off64_t) safe_run_size );
+
+			return( -1 );
+		}
+		if( ( next_storage_type != *storage_type )
+		 || ( next_physical_offset != ( *physical_offset + (off64_t) safe_run_size ) ) )
+		{
+			break;
+		}
+		safe_run_size += io_handle->bytes_per_sector;
+	}
+	*run_size = safe_run_size;
+
+	return( 1 );
+}
+
+/* Decrypts a run of sectors that was read from the physical offset
+ * Encrypted runs are decrypted in a single pass from the encrypted data into data,
+ * unencrypted runs are expected to be read into data already
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_decrypt_sectors_run(
+     libbde_io_handle_t *io_handle,
+     libbde_encryption_context_t *encryption_context,
+     off64_t physical_offset,
+     uint8_t storage_type,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_handle_decrypt_sectors_run";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( run_size > (size_t) SSIZE_MAX )
+	 || ( ( run_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid run size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED )
+	{
+		/* In Windows Vista the first sector is altered
+		 */
+		if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+		 && ( physical_offset < 512 ) )
+		{
+			/* Change the volume header signature "-FVE-FS-"
+			 * into "NTFS    "
+			 */
+			if( memory_copy(
+			     &( data[ 3 ] ),
+			     "NTFS    ",
+			     8 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy encrypted data.",
+				 function );
+
+				return( -1 );
+			}
+			/* Change the FVE metadatsa block 1 cluster block number
+			 * into the MFT mirror cluster block number
+			 */
+			byte_stream_copy_from_uint64_little_endian(
+			 &( data[ 56 ] ),
+			 io_handle->mft_mirror_cluster_block_number );
+		}
+	}
+	else if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED )
+	{
+		if( encrypted_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid encrypted data.",
+			 function );
+
+			return( -1 );
+		}
+		if( libbde_encryption_crypt_sectors(
+		     encryption_context,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     encrypted_data,
+		     run_size,
+		     data,
+		     run_size,
+		     (uint64_t) physical_offset,
+		     (size_t) io_handle->bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sectors data at offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Reads a run of sectors that share the same storage
+ * Sparse runs are zeroed and unencrypted runs are read directly into data,
+ * encrypted runs are read into encrypted data, except for memory mapped sectors
+ * which are not copied. The encrypted data to pass to libbde_io_handle_decrypt_sectors_run
+ * is returned in run encrypted data
+ * Seeking and reading a shared file IO handle is serialized by the file IO mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_read_sectors_run(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t physical_offset,
+     uint8_t storage_type,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     uint8_t file_io_handle_is_shared,
+     const uint8_t **run_encrypted_data,
+     libcerror_error_t **error )
+{
+	uint8_t *run_data     = NULL;
+	static char *function = "libbde_io_handle_read_sectors_run";
+	ssize_t read_count    = 0;
+	int result            = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid run size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	*run_encrypted_data = NULL;
+
+	if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_SPARSE )
+	{
+		if( memory_set(
+		     data,
+		     0,
+		     run_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear data.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* Memory mapped sectors are decrypted directly from the mapped data
+	 */
+	if( io_handle->mapped_data != NULL )
+	{
+		if( ( (size64_t) physical_offset > io_handle->mapped_data_size )
+		 || ( (size64_t) run_size > ( io_handle->mapped_data_size - (size64_t) physical_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: invalid sector data offset: %" PRIi64 " value out of bounds.",
+			 function,
+			 physical_offset );
+
+			return( -1 );
+		}
+		*run_encrypted_data = &( io_handle->mapped_data[ physical_offset ] );
+
+		if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED )
+		{
+			if( memory_copy(
+			     data,
+			     *run_encrypted_data,
+			     run_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	else
+	{
+		/* Unencrypted sectors are read directly into the data
+		 */
+		if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED )
+		{
+			run_data = data;
+		}
+		else
+		{
+			run_data = encrypted_data;
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( file_io_handle_is_shared != 0 )
+		{
+			if( libcthreads_mutex_grab(
+			     io_handle->file_io_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab file IO mutex.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+		result = 1;
+
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     physical_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek sector data offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			result = -1;
+		}
+		else
+		{
+			read_count = libbfio_handle_read_buffer(
+			              file_io_handle,
+			              run_data,
+			              run_size,
+			              error );
+
+			if( read_count != (ssize_t) run_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector data.",
+				 function );
+
+				result = -1;
+			}
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( file_io_handle_is_shared != 0 )
+		{
+			if( libcthreads_mutex_release(
+			     io_handle->file_io_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release file IO mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+		*run_encrypted_data = encrypted_data;
+	}
+	return( 1 );
+}
+
+/* Reads and decrypts sectors
+ * The sectors are read in runs of contiguous sectors that share the same storage,
+ * where every run is read with a single read and decrypted in a single pass
+ * Unencrypted runs are read directly into data, encrypted runs are read into
+ * encrypted data and decrypted into data
+ * The sectors offset and data size must be a multiple of the bytes per sector
+ * Seeking and reading a shared file IO handle is serialized by the file IO mutex
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_read_sectors(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t sectors_offset,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     uint8_t zero_metadata,
+     uint8_t file_io_handle_is_shared,
+     libcerror_error_t **error )
+{
+	const uint8_t *run_encrypted_data = NULL;
+	static char *function             = "libbde_io_handle_read_sectors";
+	size_t data_offset                = 0;
+	size_t run_size                   = 0;
+	off64_t physical_offset           = 0;
+	uint8_t storage_type              = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sectors_offset < 0 )
+	 || ( ( sectors_offset % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sectors offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size > (size_t) SSIZE_MAX )
+	 || ( ( data_size % io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		if( libbde_io_handle_get_sectors_run(
+		     io_handle,
+		     sectors_offset + (off64_t) data_offset,
+		     data_size - data_offset,
+		     zero_metadata,
+		     &physical_offset,
+		     &storage_type,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sectors run at offset: %" PRIi64 ".",
+			 function,
+			 sectors_offset + (off64_t) data_offset );
+
+			return( -1 );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %" PRIzd " bytes of sector data at offset: %" PRIi64 " (0x%08" PRIx64 ") of storage type: %" PRIu8 "\n",
+			 function,
+			 run_size,
+			 physical_offset,
+			 physical_offset,
+			 storage_type );
+		}
+#endif
+		if( libbde_io_handle_read_sectors_run(
+		     io_handle,
+		     file_io_handle,
+		     physical_offset,
+		     storage_type,
+		     &( encrypted_data[ data_offset ] ),
+		     &( data[ data_offset ] ),
+		     run_size,
+		     file_io_handle_is_shared,
+		     &run_encrypted_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sectors run at offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			return( -1 );
+		}
+		if( libbde_io_handle_decrypt_sectors_run(
+		     io_handle,
+		     encryption_context,
+		     physical_offset,
+		     storage_type,
+		     run_encrypted_data,
+		     &( data[ data_offset ] ),
+		     run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sectors run at offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			return( -1 );
+		}
+		data_offset += run_size;
+	}
+	return( 1 );
+}
+
+/* Reads the unencrypted volume header
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_read_unencrypted_volume_header(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libbde_sector_data_t *sector_data = NULL;
+	uint8_t *volume_header_data       = NULL;
+	static char *function             = "libbde_io_handle_read_unencrypted_volume_header";
+	off64_t volume_header_offset      = 0;
+	uint64_t total_number_of_sectors  = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
+	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
+	{
+		volume_header_offset = io_handle->volume_header_offset;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading unencrypted volume header at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 volume_header_offset,
+		 volume_header_offset );
+	}
+#endif
+	if( libbde_sector_data_initialize(
+	     &sector_data,
+	     io_handle->bytes_per_sector,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_sector_data_read(
+	     sector_data,
+	     io_handle,
+	     file_io_handle,
+	     volume_header_offset,
+	     io_handle->encryption_context,
+	     0,
+	     1,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -28,8 +28,7 @@
 #include "libbde_encryption.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
+#include "libbde_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -123,9 +122,32 @@ struct libbde_io_handle
 	 */
 	uint8_t keys_are_set;
 
+	/* The volume master key, which is either external provided or read from the metadata
+	 */
+	uint8_t volume_master_key[ 32 ];
+
+	/* Value to indicate the volume master key is set
+	 */
+	uint8_t volume_master_key_is_set;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
+
+	/* The memory mapped data of the volume, which is read instead of the file IO handle
+	 */
+	const uint8_t *mapped_data;
+
+	/* The size of the memory mapped data
+	 */
+	size64_t mapped_data_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The file IO mutex, which serializes seeking and reading the file IO handle
+	 * so that sectors can be read by multiple threads
+	 */
+	libcthreads_mutex_t *file_io_mutex;
+#endif
 };
 
 int libbde_io_handle_initialize(
@@ -146,17 +168,62 @@ int libbde_io_handle_read_volume_header(
      off64_t file_offset,
      libcerror_error_t **error );
 
-int libbde_io_handle_read_sector(
+int libbde_io_handle_read_volume_header_data(
+     libbde_io_handle_t *io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_io_handle_get_sector_storage(
+     libbde_io_handle_t *io_handle,
+     off64_t sector_offset,
+     uint8_t zero_metadata,
+     off64_t *physical_offset,
+     uint8_t *storage_type,
+     libcerror_error_t **error );
+
+int libbde_io_handle_get_sectors_run(
+     libbde_io_handle_t *io_handle,
+     off64_t sectors_offset,
+     size_t maximum_run_size,
+     uint8_t zero_metadata,
+     off64_t *physical_offset,
+     uint8_t *storage_type,
+     size_t *run_size,
+     libcerror_error_t **error );
+
+int libbde_io_handle_decrypt_sectors_run(
+     libbde_io_handle_t *io_handle,
+     libbde_encryption_context_t *encryption_context,
+     off64_t physical_offset,
+     uint8_t storage_type,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     libcerror_error_t **error );
+
+int libbde_io_handle_read_sectors_run(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t physical_offset,
+     uint8_t storage_type,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     uint8_t file_io_handle_is_shared,
+     const uint8_t **run_encrypted_data,
+     libcerror_error_t **error );
+
+int libbde_io_handle_read_sectors(
      libbde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index,
-     off64_t element_data_offset,
-     size64_t element_data_size,
-     uint32_t element_data_flags,
-     uint8_t read_flags,
+     off64_t sectors_offset,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     uint8_t zero_metadata,
+     uint8_t file_io_handle_is_shared,
      libcerror_error_t **error );
 
 int libbde_io_handle_read_unencrypted_volume_header(
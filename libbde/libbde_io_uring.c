@@ -0,0 +1,454 @@
+/*
+ * io_uring read functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING )
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "libbde_io_uring.h"
+#include "libbde_libcerror.h"
+
+/* Creates an io_uring for reading a file
+ * Make sure the value io_uring is referencing, is set to NULL
+ * Returns 1 if successful, 0 if io_uring is not supported or -1 on error
+ */
+int libbde_io_uring_initialize(
+     libbde_io_uring_t **io_uring,
+     const char *filename,
+     int queue_depth,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_uring_initialize";
+
+#if defined( HAVE_LIBURING )
+	int file_descriptor   = -1;
+#endif
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid io_uring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( queue_depth <= 0 )
+	 || ( queue_depth > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBURING )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	/* Fall back to the regular file IO if the file cannot be opened here
+	 */
+	if( file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	*io_uring = memory_allocate_structure(
+	             libbde_io_uring_t );
+
+	if( *io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *io_uring,
+	     0,
+	     sizeof( libbde_io_uring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear io_uring.",
+		 function );
+
+		goto on_error;
+	}
+	/* Fall back to the regular file IO if the kernel does not support io_uring
+	 * or it is not permitted, e.g. by a seccomp filter
+	 */
+	if( io_uring_queue_init(
+	     (unsigned int) queue_depth,
+	     &( ( *io_uring )->ring ),
+	     0 ) != 0 )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+
+		close(
+		 file_descriptor );
+
+		return( 0 );
+	}
+	( *io_uring )->file_descriptor = file_descriptor;
+	( *io_uring )->queue_depth     = queue_depth;
+
+	return( 1 );
+
+on_error:
+	if( *io_uring != NULL )
+	{
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	close(
+	 file_descriptor );
+
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( HAVE_LIBURING ) */
+}
+
+/* Frees an io_uring
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_uring_free(
+     libbde_io_uring_t **io_uring,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_uring_free";
+	int result            = 1;
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *io_uring != NULL )
+	{
+#if defined( HAVE_LIBURING )
+		io_uring_queue_exit(
+		 &( ( *io_uring )->ring ) );
+
+		if( close(
+		     ( *io_uring )->file_descriptor ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file descriptor.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *io_uring );
+
+		*io_uring = NULL;
+	}
+	return( result );
+}
+
+/* Reads multiple ranges, keeping up to the queue depth reads in flight
+ * Short reads are resubmitted for the remainder, so the offset, buffer and size
+ * of the reads are updated while reading
+ * The io_uring is not thread safe and should only be used by one thread at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_uring_read(
+     libbde_io_uring_t *io_uring,
+     libbde_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBURING )
+	struct io_uring_cqe *completion_queue_entry = NULL;
+	struct io_uring_sqe *submission_queue_entry = NULL;
+	libbde_io_uring_read_t *read                = NULL;
+	int number_of_reads_in_flight               = 0;
+	int read_index                              = 0;
+	int read_result                             = 0;
+	int result                                  = 1;
+#endif
+	static char *function                       = "libbde_io_uring_read";
+
+	if( io_uring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid io_uring.",
+		 function );
+
+		return( -1 );
+	}
+	if( reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid reads.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid number of reads value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBURING )
+	while( ( read_index < number_of_reads )
+	    || ( number_of_reads_in_flight > 0 ) )
+	{
+		/* Stop submitting after an error, but wait for the reads in flight
+		 * since they still write into the buffers
+		 */
+		while( ( result == 1 )
+		    && ( read_index < number_of_reads )
+		    && ( number_of_reads_in_flight < io_uring->queue_depth ) )
+		{
+			read = &( reads[ read_index ] );
+
+			if( ( read->buffer == NULL )
+			 || ( read->size == 0 )
+			 || ( read->size > (size_t) UINT32_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid read: %d.",
+				 function,
+				 read_index );
+
+				result = -1;
+
+				break;
+			}
+			submission_queue_entry = io_uring_get_sqe(
+			                          &( io_uring->ring ) );
+
+			if( submission_queue_entry == NULL )
+			{
+				break;
+			}
+			io_uring_prep_read(
+			 submission_queue_entry,
+			 io_uring->file_descriptor,
+			 read->buffer,
+			 (unsigned int) read->size,
+			 (uint64_t) read->offset );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 read );
+
+			read_index++;
+			number_of_reads_in_flight++;
+		}
+		if( number_of_reads_in_flight == 0 )
+		{
+			break;
+		}
+		if( io_uring_submit(
+		     &( io_uring->ring ) ) < 0 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to submit reads.",
+				 function );
+			}
+			/* The ring is unusable if the submission fails
+			 */
+			return( -1 );
+		}
+		read_result = io_uring_wait_cqe(
+		               &( io_uring->ring ),
+		               &completion_queue_entry );
+
+		if( read_result == -EINTR )
+		{
+			continue;
+		}
+		else if( read_result != 0 )
+		{
+			if( result == 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to wait for read completion.",
+				 function );
+			}
+			return( -1 );
+		}
+		read        = (libbde_io_uring_read_t *) io_uring_cqe_get_data(
+		                                          completion_queue_entry );
+		read_result = completion_queue_entry->res;
+
+		io_uring_cqe_seen(
+		 &( io_uring->ring ),
+		 completion_queue_entry );
+
+		number_of_reads_in_flight--;
+
+		if( result != 1 )
+		{
+			continue;
+		}
+		if( ( read_result == -EAGAIN )
+		 || ( read_result == -EINTR ) )
+		{
+			read_result = 0;
+		}
+		else if( read_result <= 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read: %" PRIzd " bytes at offset: %" PRIi64 ".",
+			 function,
+			 read->size,
+			 read->offset );
+
+			result = -1;
+
+			continue;
+		}
+		read->offset += (off64_t) read_result;
+		read->buffer += read_result;
+		read->size   -= (size_t) read_result;
+
+		/* Resubmit the remainder of a short or interrupted read
+		 */
+		if( read->size > 0 )
+		{
+			submission_queue_entry = io_uring_get_sqe(
+			                          &( io_uring->ring ) );
+
+			if( submission_queue_entry == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve submission queue entry.",
+				 function );
+
+				result = -1;
+
+				continue;
+			}
+			io_uring_prep_read(
+			 submission_queue_entry,
+			 io_uring->file_descriptor,
+			 read->buffer,
+			 (unsigned int) read->size,
+			 (uint64_t) read->offset );
+
+			io_uring_sqe_set_data(
+			 submission_queue_entry,
+			 read );
+
+			number_of_reads_in_flight++;
+		}
+	}
+	return( result );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: io_uring is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBURING ) */
+}
+
@@ -0,0 +1,95 @@
+/*
+ * io_uring read functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBBDE_IO_URING_H )
+#define _LIBBDE_IO_URING_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( HAVE_LIBURING )
+#include <liburing.h>
+#endif
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_io_uring libbde_io_uring_t;
+
+struct libbde_io_uring
+{
+#if defined( HAVE_LIBURING )
+	/* The submission and completion ring
+	 */
+	struct io_uring ring;
+#endif
+	/* The file descriptor
+	 */
+	int file_descriptor;
+
+	/* The queue depth
+	 */
+	int queue_depth;
+};
+
+typedef struct libbde_io_uring_read libbde_io_uring_read_t;
+
+struct libbde_io_uring_read
+{
+	/* The offset to read from
+	 */
+	off64_t offset;
+
+	/* The buffer to read into
+	 */
+	uint8_t *buffer;
+
+	/* The number of bytes to read
+	 */
+	size_t size;
+};
+
+int libbde_io_uring_initialize(
+     libbde_io_uring_t **io_uring,
+     const char *filename,
+     int queue_depth,
+     libcerror_error_t **error );
+
+int libbde_io_uring_free(
+     libbde_io_uring_t **io_uring,
+     libcerror_error_t **error );
+
+int libbde_io_uring_read(
+     libbde_io_uring_t *io_uring,
+     libbde_io_uring_read_t *reads,
+     int number_of_reads,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_IO_URING_H ) */
+
@@ -128,11 +128,6 @@ int libbde_key_free(
 	}
 	if( *key != NULL )
 	{
-		if( ( *key )->data != NULL )
-		{
-			memory_free(
-			 ( *key )->data );
-		}
 		memory_free(
 		 *key );
 
@@ -149,9 +144,9 @@ int libbde_key_read(
      libbde_metadata_entry_t *metadata_entry,
      libcerror_error_t **error )
 {
-	uint8_t *value_data    = NULL;
-	static char *function  = "libbde_key_read";
-	size_t value_data_size = 0;
+	const uint8_t *value_data = NULL;
+	static char *function     = "libbde_key_read";
+	size_t value_data_size    = 0;
 
 	if( key == NULL )
 	{
@@ -242,46 +237,9 @@ int libbde_key_read(
 		 0 );
 	}
 #endif
-	key->data = (uint8_t *) memory_allocate(
-	                         sizeof( uint8_t ) * value_data_size );
-
-	if( key->data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_copy(
-	     key->data,
-	     value_data,
-	     value_data_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy data to key.",
-		 function );
-
-		goto on_error;
-	}
+	key->data      = value_data;
 	key->data_size = value_data_size;
-	
-	return( 1 );
 
-on_error:
-	if( key->data != NULL )
-	{
-		memory_free(
-		 key->data );
-
-		key->data = NULL;
-	}
-	return( -1 );
+	return( 1 );
 }
 
@@ -41,8 +41,9 @@ struct libbde_key
 	uint32_t encryption_method;
 
 	/* The (key) data
+	 * references the metadata entry value data
 	 */
-	uint8_t *data;
+	const uint8_t *data;
 
 	/* The (key) data size
 	 */
@@ -0,0 +1,633 @@
+/*
+ * Process-wide stretched key memo functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_key_memo.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+
+/* The process-wide stretched key memo, which is shared by all volumes
+ * and allows volumes that are unlocked with the same password or recovery
+ * password and salt to stretch the key only once
+ */
+libbde_key_memo_t libbde_key_memo;
+
+/* Retrieves the key memo size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_key_memo_get_size(
+     int *maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_key_memo_get_size";
+
+	if( maximum_number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_number_of_entries = libbde_key_memo.maximum_number_of_entries;
+
+	return( 1 );
+}
+
+/* Sets the key memo size
+ * A size of 0 disables the key memo. Changing the size removes the entries
+ * This function cannot be used while volumes are using the key memo
+ * The mutex is created by the first call and kept for the lifetime of the process
+ * hence the first call should not be made concurrently with creating volumes
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_key_memo_set_size(
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_key_memo_set_size";
+
+	if( ( maximum_number_of_entries < 0 )
+	 || ( maximum_number_of_entries > LIBBDE_MAXIMUM_KEY_MEMO_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_key_memo.mutex == NULL )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( libbde_key_memo.mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_grab(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_key_memo.number_of_users != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid key memo - key memo in use.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     libbde_key_memo.entries,
+	     0,
+	     sizeof( libbde_key_memo_entry_t ) * LIBBDE_MAXIMUM_KEY_MEMO_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key memo entries.",
+		 function );
+
+		goto on_error;
+	}
+	libbde_key_memo.number_of_entries         = 0;
+	libbde_key_memo.next_entry_index          = 0;
+	libbde_key_memo.maximum_number_of_entries = maximum_number_of_entries;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 libbde_key_memo.mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Registers a volume as user of the key memo
+ * Returns 1 if successful, 0 if the key memo is disabled or -1 on error
+ */
+int libbde_key_memo_register_user(
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_key_memo_register_user";
+	int result            = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The mutex is only created when the key memo size was set
+	 */
+	if( libbde_key_memo.mutex == NULL )
+	{
+		return( 0 );
+	}
+	if( libcthreads_mutex_grab(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_key_memo.number_of_users == INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid key memo - number of users value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_key_memo.maximum_number_of_entries != 0 )
+	{
+		libbde_key_memo.number_of_users += 1;
+
+		result = 1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 libbde_key_memo.mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Unregisters a volume as user of the key memo
+ * The entries are wiped when the last user is unregistered
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_key_memo_unregister_user(
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_key_memo_unregister_user";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_key_memo.mutex == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid key memo - missing mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_key_memo.number_of_users <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key memo - number of users value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	libbde_key_memo.number_of_users -= 1;
+
+	if( libbde_key_memo.number_of_users == 0 )
+	{
+		if( memory_set(
+		     libbde_key_memo.entries,
+		     0,
+		     sizeof( libbde_key_memo_entry_t ) * LIBBDE_MAXIMUM_KEY_MEMO_SIZE ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear key memo entries.",
+			 function );
+
+			goto on_error;
+		}
+		libbde_key_memo.number_of_entries = 0;
+		libbde_key_memo.next_entry_index  = 0;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 libbde_key_memo.mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the stretched key of a specific password hash and salt
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_key_memo_get_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint8_t *key,
+     libcerror_error_t **error )
+{
+	libbde_key_memo_entry_t *entry = NULL;
+	static char *function          = "libbde_key_memo_get_key";
+	int entry_index                = 0;
+	int result                     = 0;
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_key_memo.mutex == NULL )
+	{
+		return( 0 );
+	}
+	if( libcthreads_mutex_grab(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < libbde_key_memo.number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( libbde_key_memo.entries[ entry_index ] );
+
+		if( ( memory_compare(
+		       entry->password_hash,
+		       password_hash,
+		       32 ) == 0 )
+		 && ( memory_compare(
+		       entry->salt,
+		       salt,
+		       16 ) == 0 ) )
+		{
+			if( memory_copy(
+			     key,
+			     entry->key,
+			     32 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy key.",
+				 function );
+
+				goto on_error;
+			}
+			result = 1;
+
+			break;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 libbde_key_memo.mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Appends the stretched key of a specific password hash and salt
+ * When all entries are used the oldest entry is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_key_memo_append_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     const uint8_t *key,
+     libcerror_error_t **error )
+{
+	libbde_key_memo_entry_t *entry = NULL;
+	static char *function          = "libbde_key_memo_append_key";
+	int entry_index                = 0;
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_key_memo.mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	for( entry_index = 0;
+	     entry_index < libbde_key_memo.number_of_entries;
+	     entry_index++ )
+	{
+		entry = &( libbde_key_memo.entries[ entry_index ] );
+
+		if( ( memory_compare(
+		       entry->password_hash,
+		       password_hash,
+		       32 ) == 0 )
+		 && ( memory_compare(
+		       entry->salt,
+		       salt,
+		       16 ) == 0 ) )
+		{
+			break;
+		}
+	}
+	if( ( libbde_key_memo.maximum_number_of_entries > 0 )
+	 && ( entry_index >= libbde_key_memo.number_of_entries ) )
+	{
+		if( libbde_key_memo.number_of_entries < libbde_key_memo.maximum_number_of_entries )
+		{
+			entry_index = libbde_key_memo.number_of_entries;
+
+			libbde_key_memo.number_of_entries += 1;
+		}
+		else
+		{
+			entry_index = libbde_key_memo.next_entry_index;
+
+			libbde_key_memo.next_entry_index = ( entry_index + 1 ) % libbde_key_memo.maximum_number_of_entries;
+		}
+		entry = &( libbde_key_memo.entries[ entry_index ] );
+
+		if( memory_copy(
+		     entry->password_hash,
+		     password_hash,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy password hash.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     entry->salt,
+		     salt,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy salt.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     entry->key,
+		     key,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     libbde_key_memo.mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 libbde_key_memo.mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
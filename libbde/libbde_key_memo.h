@@ -0,0 +1,117 @@
+/*
+ * Process-wide stretched key memo functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_KEY_MEMO_H )
+#define _LIBBDE_KEY_MEMO_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_key_memo_entry libbde_key_memo_entry_t;
+
+struct libbde_key_memo_entry
+{
+	/* The SHA-256 hash of the password
+	 */
+	uint8_t password_hash[ 32 ];
+
+	/* The salt
+	 */
+	uint8_t salt[ 16 ];
+
+	/* The stretched key
+	 */
+	uint8_t key[ 32 ];
+};
+
+typedef struct libbde_key_memo libbde_key_memo_t;
+
+struct libbde_key_memo
+{
+	/* The entries
+	 */
+	libbde_key_memo_entry_t entries[ LIBBDE_MAXIMUM_KEY_MEMO_SIZE ];
+
+	/* The maximum number of entries, where 0 represents the key memo is disabled
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The index of the next entry to replace when all entries are used
+	 */
+	int next_entry_index;
+
+	/* The number of volumes using the key memo
+	 */
+	int number_of_users;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The mutex
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+extern libbde_key_memo_t libbde_key_memo;
+
+int libbde_key_memo_get_size(
+     int *maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_key_memo_set_size(
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_key_memo_register_user(
+     libcerror_error_t **error );
+
+int libbde_key_memo_unregister_user(
+     libcerror_error_t **error );
+
+int libbde_key_memo_get_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint8_t *key,
+     libcerror_error_t **error );
+
+int libbde_key_memo_append_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     const uint8_t *key,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_KEY_MEMO_H ) */
+
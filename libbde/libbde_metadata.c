@@ -41,7 +41,6 @@
 #include "libbde_libuna.h"
 #include "libbde_metadata.h"
 #include "libbde_metadata_entry.h"
-#include "libbde_password.h"
 #include "libbde_password_keep.h"
 #include "libbde_volume_master_key.h"
 
@@ -107,20 +106,6 @@ int libbde_metadata_initialize(
 
 		goto on_error;
 	}
-	if( libcdata_array_initialize(
-	     &( ( *metadata )->entries_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create entries array.",
-		 function );
-
-		goto on_error;
-	}
 	if( libcdata_array_initialize(
 	     &( ( *metadata )->volume_master_keys_array ),
 	     0,
@@ -140,13 +125,6 @@ int libbde_metadata_initialize(
 on_error:
 	if( *metadata != NULL )
 	{
-		if( ( *metadata )->entries_array != NULL )
-		{
-			libcdata_array_free(
-			 &( ( *metadata )->entries_array ),
-			 (int(*)(intptr_t **, libcerror_error_t **)) &libbde_metadata_entry_free,
-			 NULL );
-		}
 		memory_free(
 		 *metadata );
 
@@ -178,11 +156,6 @@ int libbde_metadata_free(
 	}
 	if( *metadata != NULL )
 	{
-		if( ( *metadata )->description != NULL )
-		{
-			memory_free(
-			 ( *metadata )->description );
-		}
 		if( ( *metadata )->full_volume_encryption_key != NULL )
 		{
 			if( libbde_aes_ccm_encrypted_key_free(
@@ -199,19 +172,21 @@ int libbde_metadata_free(
 				result = -1;
 			}
 		}
-		if( libcdata_array_free(
-		     &( ( *metadata )->entries_array ),
-		     (int(*)(intptr_t **, libcerror_error_t **)) &libbde_metadata_entry_free,
-		     error ) != 1 )
+		if( ( *metadata )->startup_key_external_key != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free entries array.",
-			 function );
+			if( libbde_external_key_free(
+			     &( ( *metadata )->startup_key_external_key ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free startup key external key.",
+				 function );
 
-			result = -1;
+				result = -1;
+			}
 		}
 		if( libcdata_array_free(
 		     &( ( *metadata )->volume_master_keys_array ),
@@ -227,6 +202,19 @@ int libbde_metadata_free(
 
 			result = -1;
 		}
+		/* The entries, keys and description reference the data
+		 * and therefore it must be freed last
+		 */
+		if( ( *metadata )->entries != NULL )
+		{
+			memory_free(
+			 ( *metadata )->entries );
+		}
+		if( ( *metadata )->data != NULL )
+		{
+			memory_free(
+			 ( *metadata )->data );
+		}
 		memory_free(
 		 *metadata );
 
@@ -247,22 +235,13 @@ int libbde_metadata_read_block(
      size_t startup_key_identifier_size,
      libcerror_error_t **error )
 {
-	uint8_t *fve_metadata_block              = NULL;
-	void *reallocation                       = NULL;
-	static char *function                    = "libbde_metadata_read_block";
-	size_t fve_metadata_block_offset         = 0;
-	size_t read_size                         = 8192;
-	ssize_t read_count                       = 0;
-	uint64_t first_metadata_offset           = 0;
-	uint64_t second_metadata_offset          = 0;
-	uint64_t third_metadata_offset           = 0;
-	uint32_t metadata_size                   = 0;
-	uint32_t number_of_volume_header_sectors = 0;
-
-#if defined( HAVE_DEBUG_OUTPUT )
-	uint32_t value_32bit                     = 0;
-	uint16_t value_16bit                     = 0;
-#endif
+	uint8_t *fve_metadata_block    = NULL;
+	void *reallocation             = NULL;
+	static char *function          = "libbde_metadata_read_block";
+	size_t fve_metadata_block_size = 8192;
+	size_t read_size               = 8192;
+	ssize_t read_count             = 0;
+	uint32_t metadata_size         = 0;
 
 	if( metadata == NULL )
 	{
@@ -313,7 +292,7 @@ int libbde_metadata_read_block(
 		goto on_error;
 	}
 	fve_metadata_block = (uint8_t *) memory_allocate(
-	                                  sizeof( uint8_t ) * read_size );
+	                                  sizeof( uint8_t ) * fve_metadata_block_size );
 
 	if( fve_metadata_block == NULL )
 	{
@@ -343,6 +322,157 @@ int libbde_metadata_read_block(
 
 		goto on_error;
 	}
+	/* The metadata can be larger than the initial read, in which case read
+	 * the remainder as long as it fits within the metadata area
+	 */
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (bde_metadata_header_v1_t *) &( fve_metadata_block[ sizeof( bde_metadata_block_header_v1_t ) ] ) )->metadata_size,
+	 metadata_size );
+
+	if( ( ( sizeof( bde_metadata_block_header_v1_t ) + (size_t) metadata_size ) > fve_metadata_block_size )
+	 && ( ( sizeof( bde_metadata_block_header_v1_t ) + (size64_t) metadata_size ) <= io_handle->metadata_size ) )
+	{
+		read_size               = sizeof( bde_metadata_block_header_v1_t ) + (size_t) metadata_size - fve_metadata_block_size;
+		fve_metadata_block_size = sizeof( bde_metadata_block_header_v1_t ) + (size_t) metadata_size;
+
+		reallocation = memory_reallocate(
+		                fve_metadata_block,
+		                sizeof( uint8_t ) * fve_metadata_block_size );
+
+		if( reallocation == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to resize FVE metadata block.",
+			 function );
+
+			goto on_error;
+		}
+		fve_metadata_block = (uint8_t *) reallocation;
+
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( fve_metadata_block[ fve_metadata_block_size - read_size ] ),
+		              read_size,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read FVE metadata block.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbde_metadata_read_block_data(
+	     metadata,
+	     io_handle,
+	     fve_metadata_block,
+	     fve_metadata_block_size,
+	     startup_key_identifier,
+	     startup_key_identifier_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read FVE metadata block.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 fve_metadata_block );
+
+	return( 1 );
+
+on_error:
+	if( fve_metadata_block != NULL )
+	{
+		memory_free(
+		 fve_metadata_block );
+	}
+	return( -1 );
+}
+
+/* Reads a metadata block from data
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_metadata_read_block_data(
+     libbde_metadata_t *metadata,
+     libbde_io_handle_t *io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *startup_key_identifier,
+     size_t startup_key_identifier_size,
+     libcerror_error_t **error )
+{
+	static char *function                    = "libbde_metadata_read_block_data";
+	size_t data_offset                       = 0;
+	ssize_t read_count                       = 0;
+	uint64_t first_metadata_offset           = 0;
+	uint64_t second_metadata_offset          = 0;
+	uint64_t third_metadata_offset           = 0;
+	uint32_t metadata_size                   = 0;
+	uint32_t number_of_volume_header_sectors = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	uint32_t value_32bit                     = 0;
+	uint16_t value_16bit                     = 0;
+#endif
+
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size < ( sizeof( bde_metadata_block_header_v1_t ) + sizeof( bde_metadata_header_v1_t ) ) )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -350,13 +480,13 @@ int libbde_metadata_read_block(
 		 "%s: FVE metadata block header:\n",
 		 function );
 		libcnotify_print_data(
-		 fve_metadata_block,
+		 data,
 		 sizeof( bde_metadata_block_header_v1_t ),
 		 0 );
 	}
 #endif
 	if( memory_compare(
-	     fve_metadata_block,
+	     data,
 	     bde_signature,
 	     8 ) != 0 )
 	{
@@ -367,10 +497,10 @@ int libbde_metadata_read_block(
 		 "%s: invalid metadata block signature.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	byte_stream_copy_to_uint16_little_endian(
-	 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->version,
+	 ( (bde_metadata_block_header_v1_t *) data )->version,
 	 metadata->version );
 
 	if( ( metadata->version != 1 )
@@ -383,38 +513,38 @@ int libbde_metadata_read_block(
 		 "%s: unsupported metadata block version.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( metadata->version == 1 )
 	{
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->mft_mirror_cluster_block,
+		 ( (bde_metadata_block_header_v1_t *) data )->mft_mirror_cluster_block,
 		 metadata->mft_mirror_cluster_block_number );
 	}
 	else if( metadata->version == 2 )
 	{
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_metadata_block_header_v2_t *) fve_metadata_block )->encrypted_volume_size,
+		 ( (bde_metadata_block_header_v2_t *) data )->encrypted_volume_size,
 		 metadata->encrypted_volume_size );
 
 		byte_stream_copy_to_uint64_little_endian(
-		 ( (bde_metadata_block_header_v2_t *) fve_metadata_block )->volume_header_offset,
+		 ( (bde_metadata_block_header_v2_t *) data )->volume_header_offset,
 		 metadata->volume_header_offset );
 
 		byte_stream_copy_to_uint32_little_endian(
-		 ( (bde_metadata_block_header_v2_t *) fve_metadata_block )->number_of_volume_header_sectors,
+		 ( (bde_metadata_block_header_v2_t *) data )->number_of_volume_header_sectors,
 		 number_of_volume_header_sectors );
 	}
 	byte_stream_copy_to_uint64_little_endian(
-	 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->first_metadata_offset,
+	 ( (bde_metadata_block_header_v1_t *) data )->first_metadata_offset,
 	 first_metadata_offset );
 
 	byte_stream_copy_to_uint64_little_endian(
-	 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->second_metadata_offset,
+	 ( (bde_metadata_block_header_v1_t *) data )->second_metadata_offset,
 	 second_metadata_offset );
 
 	byte_stream_copy_to_uint64_little_endian(
-	 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->third_metadata_offset,
+	 ( (bde_metadata_block_header_v1_t *) data )->third_metadata_offset,
 	 third_metadata_offset );
 
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -423,17 +553,17 @@ int libbde_metadata_read_block(
 		libcnotify_printf(
 		 "%s: signature\t\t\t\t\t: %c%c%c%c%c%c%c%c\n",
 		 function,
-		 fve_metadata_block[ 0 ],
-		 fve_metadata_block[ 1 ],
-		 fve_metadata_block[ 2 ],
-		 fve_metadata_block[ 3 ],
-		 fve_metadata_block[ 4 ],
-		 fve_metadata_block[ 5 ],
-		 fve_metadata_block[ 6 ],
-		 fve_metadata_block[ 7 ] );
+		 data[ 0 ],
+		 data[ 1 ],
+		 data[ 2 ],
+		 data[ 3 ],
+		 data[ 4 ],
+		 data[ 5 ],
+		 data[ 6 ],
+		 data[ 7 ] );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->size,
+		 ( (bde_metadata_block_header_v1_t *) data )->size,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: size\t\t\t\t\t: %" PRIu16 "\n",
@@ -446,7 +576,7 @@ int libbde_metadata_read_block(
 		 metadata->version );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->unknown1,
+		 ( (bde_metadata_block_header_v1_t *) data )->unknown1,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: unknown1\t\t\t\t\t: %" PRIu16 "\n",
@@ -454,7 +584,7 @@ int libbde_metadata_read_block(
 		 value_16bit );
 
 		byte_stream_copy_to_uint16_little_endian(
-		 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->unknown2,
+		 ( (bde_metadata_block_header_v1_t *) data )->unknown2,
 		 value_16bit );
 		libcnotify_printf(
 		 "%s: unknown2\t\t\t\t\t: %" PRIu16 "\n",
@@ -467,7 +597,7 @@ int libbde_metadata_read_block(
 			 "%s: unknown3:\n",
 			 function );
 			libcnotify_print_data(
-			 ( (bde_metadata_block_header_v1_t *) fve_metadata_block )->unknown3,
+			 ( (bde_metadata_block_header_v1_t *) data )->unknown3,
 			 16,
 			 0 );
 		}
@@ -479,7 +609,7 @@ int libbde_metadata_read_block(
 			 metadata->encrypted_volume_size );
 
 			byte_stream_copy_to_uint32_little_endian(
-			 ( (bde_metadata_block_header_v2_t *) fve_metadata_block )->unknown3,
+			 ( (bde_metadata_block_header_v2_t *) data )->unknown3,
 			 value_32bit );
 			libcnotify_printf(
 			 "%s: unknown3\t\t\t\t\t: %" PRIu32 "\n",
@@ -544,7 +674,7 @@ int libbde_metadata_read_block(
 		 "%s: value mismatch for first metadata offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( (uint64_t) io_handle->second_metadata_offset != second_metadata_offset )
 	{
@@ -555,7 +685,7 @@ int libbde_metadata_read_block(
 		 "%s: value mismatch for second metadata offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 	if( (uint64_t) io_handle->third_metadata_offset != third_metadata_offset )
 	{
@@ -566,15 +696,14 @@ int libbde_metadata_read_block(
 		 "%s: value mismatch for third metadata offset.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	fve_metadata_block_offset += sizeof( bde_metadata_block_header_v1_t );
-	read_size                 -= sizeof( bde_metadata_block_header_v1_t );
+	data_offset = sizeof( bde_metadata_block_header_v1_t );
 
 	read_count = libbde_metadata_read_header(
 	              metadata,
-	              &( fve_metadata_block[ fve_metadata_block_offset ] ),
-	              read_size,
+	              &( data[ data_offset ] ),
+	              data_size - data_offset,
 	              &metadata_size,
 	              error );
 
@@ -587,12 +716,12 @@ int libbde_metadata_read_block(
 		 "%s: unable to read metadata header.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	fve_metadata_block_offset += read_count;
-	read_size                 -= read_count;
+	data_offset += read_count;
 
-	if( metadata_size < ( sizeof( bde_metadata_header_v1_t ) + read_count ) )
+	if( ( metadata_size < ( sizeof( bde_metadata_header_v1_t ) + read_count ) )
+	 || ( ( (size_t) metadata_size - sizeof( bde_metadata_header_v1_t ) ) > ( data_size - data_offset ) ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -601,30 +730,11 @@ int libbde_metadata_read_block(
 		 "%s: metadata size value out of bounds.",
 		 function );
 
-		goto on_error;
-	}
-	if( metadata_size > read_size )
-	{
-		reallocation = memory_reallocate(
-		                fve_metadata_block,
-		                metadata_size );
-
-		if( reallocation == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-			 "%s: unable to resize metadata.",
-			 function );
-
-			goto on_error;
-		}
-		fve_metadata_block = (uint8_t *) reallocation;
+		return( -1 );
 	}
 	read_count = libbde_metadata_read_entries(
 	              metadata,
-	              &( fve_metadata_block[ fve_metadata_block_offset ] ),
+	              &( data[ data_offset ] ),
 	              (size_t) metadata_size - sizeof( bde_metadata_header_v1_t ),
 	              startup_key_identifier,
 	              startup_key_identifier_size,
@@ -636,25 +746,12 @@ int libbde_metadata_read_block(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read metadata header.",
+		 "%s: unable to read metadata entries.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	memory_free(
-	 fve_metadata_block );
-
-	fve_metadata_block = NULL;
-
 	return( 1 );
-
-on_error:
-	if( fve_metadata_block != NULL )
-	{
-		memory_free(
-		 fve_metadata_block );
-	}
-	return( -1 );
 }
 
 /* Reads a metadata header
@@ -662,7 +759,7 @@ on_error:
  */
 ssize_t libbde_metadata_read_header(
          libbde_metadata_t *metadata,
-         uint8_t *header_data,
+         const uint8_t *header_data,
          size_t header_data_size,
          uint32_t *metadata_size,
          libcerror_error_t **error )
@@ -1056,7 +1153,7 @@ on_error:
  */
 ssize_t libbde_metadata_read_entries(
          libbde_metadata_t *metadata,
-         uint8_t *entries_data,
+         const uint8_t *entries_data,
          size_t entries_data_size,
          const uint8_t *startup_key_identifier,
          size_t startup_key_identifier_size,
@@ -1072,6 +1169,8 @@ ssize_t libbde_metadata_read_entries(
 	uint64_t volume_header_offset                         = 0;
 	uint64_t volume_header_size                           = 0;
 	int entry_index                                       = 0;
+	int volume_master_key_index                           = 0;
+	int number_of_entries                                 = 0;
 
 	if( metadata == NULL )
 	{
@@ -1120,6 +1219,72 @@ ssize_t libbde_metadata_read_entries(
 			return( -1 );
 		}
 	}
+	if( ( metadata->data != NULL )
+	 || ( metadata->entries != NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata - entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( entries_data_size > 0 )
+	{
+		/* The entries and the keys read from them reference the metadata data
+		 * hence the entries data is copied once instead of per entry and key
+		 */
+		metadata->data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * entries_data_size );
+
+		if( metadata->data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		metadata->data_size = entries_data_size;
+
+		if( memory_copy(
+		     metadata->data,
+		     entries_data,
+		     entries_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy entries data.",
+			 function );
+
+			goto on_error;
+		}
+		entries_data = metadata->data;
+
+		if( libbde_metadata_entry_initialize_entries(
+		     &( metadata->entries ),
+		     &number_of_entries,
+		     entries_data,
+		     entries_data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create entries.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	while( entries_data_size >= sizeof( bde_metadata_entry_v1_t ) )
 	{
 		if( memory_compare(
@@ -1129,19 +1294,22 @@ ssize_t libbde_metadata_read_entries(
 		{
 			break;
 		}
-		if( libbde_metadata_entry_initialize(
-		     &metadata_entry,
-		     error ) != 1 )
+		/* The number of entries stops at the first invalid entry
+		 * which libbde_metadata_entry_read will fail on
+		 */
+		if( entry_index >= number_of_entries )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create metadata entry.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid entry index value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
+		metadata_entry = &( metadata->entries[ entry_index ] );
+
 		read_count = libbde_metadata_entry_read(
 			      metadata_entry,
 			      &( entries_data[ entries_data_offset ] ),
@@ -1232,7 +1400,7 @@ ssize_t libbde_metadata_read_entries(
 				}
 				if( libcdata_array_append_entry(
 				     metadata->volume_master_keys_array,
-				     &entry_index,
+				     &volume_master_key_index,
 				     (intptr_t *) volume_master_key,
 				     error ) != 1 )
 				{
@@ -1401,34 +1569,7 @@ ssize_t libbde_metadata_read_entries(
 				if( ( metadata_entry->value_data != NULL )
 				 && ( metadata_entry->value_data_size > 0 ) )
 				{
-					metadata->description = (uint8_t *) memory_allocate(
-					                                     metadata_entry->value_data_size );
-
-					if( metadata->description == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-						 "%s: unable to create description.",
-						 function );
-
-						goto on_error;
-					}
-					if( memory_copy(
-					     metadata->description,
-					     metadata_entry->value_data,
-					     metadata_entry->value_data_size ) == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-						 "%s: unable to copy description metadata entry value data.",
-						 function );
-
-						goto on_error;
-					}
+					metadata->description      = metadata_entry->value_data;
 					metadata->description_size = metadata_entry->value_data_size;
 				}
 				break;
@@ -1504,23 +1645,10 @@ ssize_t libbde_metadata_read_entries(
 			default:
 				break;
 		}
-		if( libcdata_array_append_entry(
-		     metadata->entries_array,
-		     &entry_index,
-		     (intptr_t *) metadata_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to append metadata entry to array.",
-			 function );
-
-			goto on_error;
-		}
-		metadata_entry = NULL;
+		entry_index++;
 	}
+	metadata->number_of_entries = entry_index;
+
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1557,25 +1685,51 @@ on_error:
 		 &volume_master_key,
 		 NULL );
 	}
-	if( metadata->description != NULL )
+	/* The keys and description read so far reference the data
+	 */
+	if( metadata->startup_key_external_key != NULL )
 	{
-		memory_free(
-		 metadata->description );
-
-		metadata->description      = NULL;
-		metadata->description_size = 0;
+		libbde_external_key_free(
+		 &( metadata->startup_key_external_key ),
+		 NULL );
 	}
-	if( metadata_entry != NULL )
+	if( metadata->full_volume_encryption_key != NULL )
 	{
-		libbde_metadata_entry_free(
-		 &metadata_entry,
+		libbde_aes_ccm_encrypted_key_free(
+		 &( metadata->full_volume_encryption_key ),
 		 NULL );
 	}
+	metadata->clear_key_volume_master_key         = NULL;
+	metadata->startup_key_volume_master_key       = NULL;
+	metadata->recovery_password_volume_master_key = NULL;
+	metadata->password_volume_master_key          = NULL;
+
 	libcdata_array_empty(
-	 metadata->entries_array,
-	 (int(*)(intptr_t **, libcerror_error_t **)) &libbde_metadata_entry_free,
+	 metadata->volume_master_keys_array,
+	 (int(*)(intptr_t **, libcerror_error_t **)) &libbde_volume_master_key_free,
 	 NULL );
 
+	metadata->description      = NULL;
+	metadata->description_size = 0;
+
+	if( metadata->entries != NULL )
+	{
+		memory_free(
+		 metadata->entries );
+
+		metadata->entries = NULL;
+	}
+	metadata->number_of_entries = 0;
+
+	if( metadata->data != NULL )
+	{
+		memory_free(
+		 metadata->data );
+
+		metadata->data = NULL;
+	}
+	metadata->data_size = 0;
+
 	return( -1 );
 }
 
@@ -2165,7 +2319,8 @@ int libbde_metadata_read_volume_master_key(
 
 				goto on_error;
 			}
-			if( libbde_password_calculate_key(
+			if( libbde_password_keep_calculate_key(
+			     password_keep,
 			     password_keep->password_hash,
 			     32,
 			     metadata->password_volume_master_key->stretch_key->salt,
@@ -2411,7 +2566,8 @@ int libbde_metadata_read_volume_master_key(
 
 				goto on_error;
 			}
-			if( libbde_password_calculate_key(
+			if( libbde_password_keep_calculate_key(
+			     password_keep,
 			     password_keep->recovery_password_hash,
 			     32,
 			     metadata->recovery_password_volume_master_key->stretch_key->salt,
@@ -2636,6 +2792,130 @@ on_error:
 	return( -1 );
 }
 
+/* Appends the stretched keys that libbde_metadata_read_volume_master_key needs
+ * to the password keep, so that they can be calculated in advance
+ * No stretched keys are needed when the volume master key can be obtained
+ * from the clear key or the startup key
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_metadata_append_stretched_keys(
+     libbde_metadata_t *metadata,
+     libbde_password_keep_t *password_keep,
+     const uint8_t *external_key,
+     size_t external_key_size,
+     libcerror_error_t **error )
+{
+	libbde_password_keep_stretched_key_t *stretched_key = NULL;
+	static char *function                               = "libbde_metadata_append_stretched_keys";
+	int result                                          = 0;
+
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata->clear_key_volume_master_key != NULL )
+	{
+		return( 1 );
+	}
+	if( ( external_key != NULL )
+	 && ( external_key_size == 32 )
+	 && ( metadata->startup_key_volume_master_key != NULL ) )
+	{
+		return( 1 );
+	}
+	if( ( password_keep->password_is_set != 0 )
+	 && ( metadata->password_volume_master_key != NULL )
+	 && ( metadata->password_volume_master_key->stretch_key != NULL ) )
+	{
+		result = libbde_password_keep_get_stretched_key(
+		          password_keep,
+		          password_keep->password_hash,
+		          32,
+		          metadata->password_volume_master_key->stretch_key->salt,
+		          16,
+		          &stretched_key,
+		          error );
+
+		if( result == 0 )
+		{
+			result = libbde_password_keep_append_stretched_key(
+			          password_keep,
+			          password_keep->password_hash,
+			          32,
+			          metadata->password_volume_master_key->stretch_key->salt,
+			          16,
+			          &stretched_key,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append password stretched key.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( password_keep->recovery_password_is_set != 0 )
+	 && ( metadata->recovery_password_volume_master_key != NULL )
+	 && ( metadata->recovery_password_volume_master_key->stretch_key != NULL ) )
+	{
+		result = libbde_password_keep_get_stretched_key(
+		          password_keep,
+		          password_keep->recovery_password_hash,
+		          32,
+		          metadata->recovery_password_volume_master_key->stretch_key->salt,
+		          16,
+		          &stretched_key,
+		          error );
+
+		if( result == 0 )
+		{
+			result = libbde_password_keep_append_stretched_key(
+			          password_keep,
+			          password_keep->recovery_password_hash,
+			          32,
+			          metadata->recovery_password_volume_master_key->stretch_key->salt,
+			          16,
+			          &stretched_key,
+			          error );
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append recovery password stretched key.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
 /* Reads the full volume encryption key from the metadata
  * Returns 1 if successful, 0 if no key could be obtained or -1 on error
  */
@@ -30,6 +30,7 @@
 #include "libbde_libbfio.h"
 #include "libbde_libcdata.h"
 #include "libbde_libcerror.h"
+#include "libbde_metadata_entry.h"
 #include "libbde_password_keep.h"
 #include "libbde_volume_master_key.h"
 
@@ -81,8 +82,9 @@ struct libbde_metadata
 	uint64_t creation_time;
 
 	/* The description
+	 * references the metadata data
 	 */
-	uint8_t *description;
+	const uint8_t *description;
 
 	/* The description size
 	 */
@@ -96,9 +98,23 @@ struct libbde_metadata
 	 */
 	libbde_aes_ccm_encrypted_key_t *full_volume_encryption_key;
 
-	/* The metadata entries array
+	/* The metadata data
+	 * contains the metadata entries data referenced by the entries and keys
 	 */
-	libcdata_array_t *entries_array;
+	uint8_t *data;
+
+	/* The metadata data size
+	 */
+	size_t data_size;
+
+	/* The metadata entries
+	 * stored as a single contiguous block
+	 */
+	libbde_metadata_entry_t *entries;
+
+	/* The number of metadata entries
+	 */
+	int number_of_entries;
 
 	/* The volume master keys array
 	 */
@@ -138,16 +154,25 @@ int libbde_metadata_read_block(
      size_t startup_key_identifier_size,
      libcerror_error_t **error );
 
+int libbde_metadata_read_block_data(
+     libbde_metadata_t *metadata,
+     libbde_io_handle_t *io_handle,
+     const uint8_t *data,
+     size_t data_size,
+     const uint8_t *startup_key_identifier,
+     size_t startup_key_identifier_size,
+     libcerror_error_t **error );
+
 ssize_t libbde_metadata_read_header(
          libbde_metadata_t *metadata,
-         uint8_t *header_data,
+         const uint8_t *header_data,
          size_t header_data_size,
          uint32_t *metadata_size,
          libcerror_error_t **error );
 
 ssize_t libbde_metadata_read_entries(
          libbde_metadata_t *metadata,
-         uint8_t *entries_data,
+         const uint8_t *entries_data,
          size_t entries_data_size,
          const uint8_t *startup_key_identifier,
          size_t startup_key_identifier_size,
@@ -163,6 +188,13 @@ int libbde_metadata_read_volume_master_key(
      size_t volume_master_key_size,
      libcerror_error_t **error );
 
+int libbde_metadata_append_stretched_keys(
+     libbde_metadata_t *metadata,
+     libbde_password_keep_t *password_keep,
+     const uint8_t *external_key,
+     size_t external_key_size,
+     libcerror_error_t **error );
+
 int libbde_metadata_read_full_volume_encryption_key(
      libbde_metadata_t *metadata,
      libbde_io_handle_t *io_handle,
@@ -133,11 +133,8 @@ int libbde_metadata_entry_free(
 	}
 	if( *metadata_entry != NULL )
 	{
-		if( ( *metadata_entry )->value_data != NULL )
-		{
-			memory_free(
-			 ( *metadata_entry )->value_data );
-		}
+		/* The value data references the metadata data and is not freed here
+		 */
 		memory_free(
 		 *metadata_entry );
 
@@ -275,57 +272,211 @@ ssize_t libbde_metadata_entry_read(
 
 	metadata_entry->value_data_size = entry_size - (uint16_t) sizeof( bde_metadata_entry_v1_t );
 
-	metadata_entry->value_data = (uint8_t *) memory_allocate(
-	                                          sizeof( uint8_t ) * metadata_entry->value_data_size );
+	metadata_entry->value_data = fve_metadata;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: FVE metadata entry data:\n",
+		 function );
+		libcnotify_print_data(
+		 metadata_entry->value_data,
+		 (size_t) metadata_entry->value_data_size,
+		 0 );
+	}
+#endif
+	return( (ssize_t) entry_size );
+}
+
+/* Retrieves the number of metadata entries in the metadata data
+ * The entries are not validated, counting stops at the empty entry or an invalid entry size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_metadata_entry_get_number_of_entries(
+     const uint8_t *fve_metadata,
+     size_t fve_metadata_size,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function      = "libbde_metadata_entry_get_number_of_entries";
+	size_t fve_metadata_offset = 0;
+	uint16_t entry_size        = 0;
+	int safe_number_of_entries = 0;
 
-	if( metadata_entry->value_data == NULL )
+	if( fve_metadata == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create value data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid FVE metadata.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_copy(
-	     metadata_entry->value_data,
-	     fve_metadata,
-	     metadata_entry->value_data_size ) == NULL )
+	if( fve_metadata_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy value data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid FVE metadata size value exceeds maximum.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( number_of_entries == NULL )
 	{
-		libcnotify_printf(
-		 "%s: FVE metadata entry data:\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
 		 function );
-		libcnotify_print_data(
-		 metadata_entry->value_data,
-		 (size_t) metadata_entry->value_data_size,
-		 0 );
+
+		return( -1 );
 	}
-#endif
-	return( (ssize_t) entry_size );
+	while( ( fve_metadata_size - fve_metadata_offset ) >= sizeof( bde_metadata_entry_v1_t ) )
+	{
+		if( memory_compare(
+		     &( fve_metadata[ fve_metadata_offset ] ),
+		     libbde_metadata_entry_empty,
+		     sizeof( bde_metadata_entry_v1_t ) ) == 0 )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint16_little_endian(
+		 ( (bde_metadata_entry_v1_t *) &( fve_metadata[ fve_metadata_offset ] ) )->size,
+		 entry_size );
 
-on_error:
-	if( metadata_entry->value_data != NULL )
+		if( ( entry_size < sizeof( bde_metadata_entry_v1_t ) )
+		 || ( entry_size > ( fve_metadata_size - fve_metadata_offset ) ) )
+		{
+			break;
+		}
+		if( safe_number_of_entries == INT_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of entries value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		fve_metadata_offset += entry_size;
+
+		safe_number_of_entries++;
+	}
+	*number_of_entries = safe_number_of_entries;
+
+	return( 1 );
+}
+
+/* Creates the metadata entries for the metadata data
+ * The entries are stored as a single contiguous block that is freed with memory_free
+ * Make sure the value entries is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_metadata_entry_initialize_entries(
+     libbde_metadata_entry_t **entries,
+     int *number_of_entries,
+     const uint8_t *fve_metadata,
+     size_t fve_metadata_size,
+     libcerror_error_t **error )
+{
+	libbde_metadata_entry_t *safe_entries = NULL;
+	static char *function                 = "libbde_metadata_entry_initialize_entries";
+	int safe_number_of_entries            = 0;
+
+	if( entries == NULL )
 	{
-		memory_free(
-		 metadata_entry->value_data );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entries.",
+		 function );
 
-		metadata_entry->value_data = NULL;
+		return( -1 );
 	}
-	return( -1 );
+	if( *entries != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid entries value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_metadata_entry_get_number_of_entries(
+	     fve_metadata,
+	     fve_metadata_size,
+	     &safe_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	if( safe_number_of_entries > 0 )
+	{
+		safe_entries = (libbde_metadata_entry_t *) memory_allocate(
+		                                            sizeof( libbde_metadata_entry_t ) * safe_number_of_entries );
+
+		if( safe_entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entries.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     safe_entries,
+		     0,
+		     sizeof( libbde_metadata_entry_t ) * safe_number_of_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear entries.",
+			 function );
+
+			memory_free(
+			 safe_entries );
+
+			return( -1 );
+		}
+	}
+	*entries           = safe_entries;
+	*number_of_entries = safe_number_of_entries;
+
+	return( 1 );
 }
 
 /* Reads a string from the metadata entry
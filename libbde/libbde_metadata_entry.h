@@ -46,8 +46,9 @@ struct libbde_metadata_entry
 	uint16_t value_type;
 
 	/* The value data
+	 * references the metadata data the entry was read from
 	 */
-	uint8_t *value_data;
+	const uint8_t *value_data;
 
 	/* The value data size
 	 */
@@ -68,6 +69,19 @@ ssize_t libbde_metadata_entry_read(
          size_t fve_metadata_size,
          libcerror_error_t **error );
 
+int libbde_metadata_entry_get_number_of_entries(
+     const uint8_t *fve_metadata,
+     size_t fve_metadata_size,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_metadata_entry_initialize_entries(
+     libbde_metadata_entry_t **entries,
+     int *number_of_entries,
+     const uint8_t *fve_metadata,
+     size_t fve_metadata_size,
+     libcerror_error_t **error );
+
 int libbde_metadata_entry_read_string(
      libbde_metadata_entry_t *metadata_entry,
      libcerror_error_t **error );
@@ -29,6 +29,7 @@
 #include "libbde_libhmac.h"
 #include "libbde_libuna.h"
 #include "libbde_password.h"
+#include "libbde_sha256.h"
 
 /* Calculates the SHA256 hash of an UTF-8 formatted password
  * Returns 1 if successful or -1 on error
@@ -350,8 +351,6 @@ int libbde_password_calculate_key(
      size_t key_size,
      libcerror_error_t **error )
 {
-	libbde_password_key_data_t password_key_data;
-
 	static char *function = "libbde_password_calculate_key";
 
 	if( password_hash == NULL )
@@ -420,74 +419,14 @@ int libbde_password_calculate_key(
 
 		return( -1 );
 	}
-	if( memory_set(
-	     &password_key_data,
-	     0,
-	     sizeof( libbde_password_key_data_t ) ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear password key data.",
-		 function );
-
-		return( -1 );
-	}
-	if( memory_copy(
-	     &( password_key_data.initial_sha256_hash ),
-	     password_hash,
-	     password_hash_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy password hash to password key data.",
-		 function );
-
-		return( -1 );
-	}
-	if( memory_copy(
-	     &( password_key_data.salt ),
-	     salt,
-	     salt_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy salt to password key data.",
-		 function );
-
-		return( -1 );
-	}
 	/* The password key is the SHA256 digest hash after 0x100000 key iterations
 	 */
-	for( password_key_data.iteration_count = 0;
-	     password_key_data.iteration_count < 0x000fffffUL;
-	     password_key_data.iteration_count += 1 )
-	{
-		if( libhmac_sha256_calculate(
-		     (uint8_t *) &password_key_data,
-		     sizeof( libbde_password_key_data_t ),
-		     password_key_data.last_sha256_hash,
-		     LIBHMAC_SHA256_HASH_SIZE,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to calculate SHA256.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( libhmac_sha256_calculate(
-	     (uint8_t *) &password_key_data,
-	     sizeof( libbde_password_key_data_t ),
+	if( libbde_sha256_stretch_key(
+	     password_hash,
+	     password_hash_size,
+	     salt,
+	     salt_size,
+	     0x00100000UL,
 	     key,
 	     key_size,
 	     error ) != 1 )
@@ -496,7 +435,7 @@ int libbde_password_calculate_key(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to calculate SHA256.",
+		 "%s: unable to calculate stretched key.",
 		 function );
 
 		return( -1 );
@@ -24,7 +24,11 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libbde_definitions.h"
+#include "libbde_key_memo.h"
 #include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+#include "libbde_password.h"
 #include "libbde_password_keep.h"
 
 /* Creates a password keep
@@ -150,3 +154,640 @@ int libbde_password_keep_free(
 	return( result );
 }
 
+/* Retrieves the stretched key of a specific password hash and salt
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_password_keep_get_stretched_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     libbde_password_keep_stretched_key_t **stretched_key,
+     libcerror_error_t **error )
+{
+	static char *function   = "libbde_password_keep_get_stretched_key";
+	int stretched_key_index = 0;
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stretched_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	for( stretched_key_index = 0;
+	     stretched_key_index < password_keep->number_of_stretched_keys;
+	     stretched_key_index++ )
+	{
+		if( ( memory_compare(
+		       password_keep->stretched_keys[ stretched_key_index ].password_hash,
+		       password_hash,
+		       32 ) == 0 )
+		 && ( memory_compare(
+		       password_keep->stretched_keys[ stretched_key_index ].salt,
+		       salt,
+		       16 ) == 0 ) )
+		{
+			*stretched_key = &( password_keep->stretched_keys[ stretched_key_index ] );
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Appends a stretched key of a specific password hash and salt
+ * The stretched key is not calculated. When all stretched keys are used
+ * the least recently appended stretched key is replaced
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_append_stretched_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     libbde_password_keep_stretched_key_t **stretched_key,
+     libcerror_error_t **error )
+{
+	libbde_password_keep_stretched_key_t *safe_stretched_key = NULL;
+	static char *function                                    = "libbde_password_keep_append_stretched_key";
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_keep->number_of_stretched_keys < 0 )
+	 || ( password_keep->number_of_stretched_keys > LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid password keep - number of stretched keys value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( stretched_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_keep->number_of_stretched_keys < LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS )
+	{
+		safe_stretched_key = &( password_keep->stretched_keys[ password_keep->number_of_stretched_keys ] );
+
+		password_keep->number_of_stretched_keys += 1;
+	}
+	else
+	{
+		safe_stretched_key = &( password_keep->stretched_keys[ password_keep->next_stretched_key_index ] );
+
+		password_keep->next_stretched_key_index += 1;
+
+		if( password_keep->next_stretched_key_index >= LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS )
+		{
+			password_keep->next_stretched_key_index = 0;
+		}
+	}
+	if( memory_set(
+	     safe_stretched_key,
+	     0,
+	     sizeof( libbde_password_keep_stretched_key_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     safe_stretched_key->password_hash,
+	     password_hash,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     safe_stretched_key->salt,
+	     salt,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy salt.",
+		 function );
+
+		return( -1 );
+	}
+	*stretched_key = safe_stretched_key;
+
+	return( 1 );
+}
+
+/* Calculates a stretched key
+ * This function is also used as a thread callback, where every thread
+ * calculates a different stretched key, hence the stretched key is passed
+ * as a generic pointer. A stretched key that cannot be calculated remains not set
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_stretched_key_calculate(
+     void *arguments )
+{
+	libbde_password_keep_stretched_key_t *stretched_key = NULL;
+	libcerror_error_t *error                            = NULL;
+
+	if( arguments == NULL )
+	{
+		return( -1 );
+	}
+	stretched_key = (libbde_password_keep_stretched_key_t *) arguments;
+
+	if( stretched_key->key_is_set != 0 )
+	{
+		return( 1 );
+	}
+	if( libbde_password_calculate_key(
+	     stretched_key->password_hash,
+	     32,
+	     stretched_key->salt,
+	     16,
+	     stretched_key->key,
+	     32,
+	     &error ) != 1 )
+	{
+		libcerror_error_free(
+		 &error );
+
+		return( -1 );
+	}
+	stretched_key->key_is_set = 1;
+
+	return( 1 );
+}
+
+/* Calculates the stretched keys that are not set
+ * When multi-thread support is available the stretched keys are
+ * calculated concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_calculate_stretched_keys(
+     libbde_password_keep_t *password_keep,
+     libcerror_error_t **error )
+{
+	libbde_password_keep_stretched_key_t *stretched_keys[ LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS ];
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t *threads[ LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS ];
+
+	int number_of_threads                               = 0;
+	int thread_index                                    = 0;
+#endif
+	libbde_password_keep_stretched_key_t *stretched_key = NULL;
+	static char *function                               = "libbde_password_keep_calculate_stretched_keys";
+	int number_of_stretched_keys                        = 0;
+	int result                                          = 1;
+	int stretched_key_index                             = 0;
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_keep->number_of_stretched_keys < 0 )
+	 || ( password_keep->number_of_stretched_keys > LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid password keep - number of stretched keys value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( stretched_key_index = 0;
+	     stretched_key_index < password_keep->number_of_stretched_keys;
+	     stretched_key_index++ )
+	{
+		stretched_key = &( password_keep->stretched_keys[ stretched_key_index ] );
+
+		if( ( stretched_key->key_is_set == 0 )
+		 && ( password_keep->use_key_memo != 0 ) )
+		{
+			result = libbde_key_memo_get_key(
+			          stretched_key->password_hash,
+			          stretched_key->salt,
+			          stretched_key->key,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve stretched key: %d from key memo.",
+				 function,
+				 stretched_key_index );
+
+				return( -1 );
+			}
+			stretched_key->key_is_set = (uint8_t) result;
+		}
+		if( stretched_key->key_is_set == 0 )
+		{
+			stretched_keys[ number_of_stretched_keys++ ] = stretched_key;
+		}
+	}
+	result = 1;
+
+	if( number_of_stretched_keys == 0 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The last stretched key is calculated by the calling thread
+	 */
+	for( stretched_key_index = 0;
+	     stretched_key_index < ( number_of_stretched_keys - 1 );
+	     stretched_key_index++ )
+	{
+		threads[ number_of_threads ] = NULL;
+
+		if( libcthreads_thread_create(
+		     &( threads[ number_of_threads ] ),
+		     NULL,
+		     &libbde_password_keep_stretched_key_calculate,
+		     (void *) stretched_keys[ stretched_key_index ],
+		     NULL ) == 1 )
+		{
+			number_of_threads += 1;
+		}
+		else
+		{
+			libbde_password_keep_stretched_key_calculate(
+			 stretched_keys[ stretched_key_index ] );
+		}
+	}
+	libbde_password_keep_stretched_key_calculate(
+	 stretched_keys[ number_of_stretched_keys - 1 ] );
+
+	for( thread_index = 0;
+	     thread_index < number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join stretched key thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+#else
+	for( stretched_key_index = 0;
+	     stretched_key_index < number_of_stretched_keys;
+	     stretched_key_index++ )
+	{
+		libbde_password_keep_stretched_key_calculate(
+		 stretched_keys[ stretched_key_index ] );
+	}
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
+
+	if( password_keep->use_key_memo != 0 )
+	{
+		for( stretched_key_index = 0;
+		     stretched_key_index < number_of_stretched_keys;
+		     stretched_key_index++ )
+		{
+			stretched_key = stretched_keys[ stretched_key_index ];
+
+			if( stretched_key->key_is_set == 0 )
+			{
+				continue;
+			}
+			if( libbde_key_memo_append_key(
+			     stretched_key->password_hash,
+			     stretched_key->salt,
+			     stretched_key->key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append stretched key: %d to key memo.",
+				 function,
+				 stretched_key_index );
+
+				result = -1;
+			}
+		}
+	}
+	return( result );
+}
+
+/* Calculates the key of a specific password hash and salt
+ * The stretched key is calculated only once per password hash and salt
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_calculate_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	libbde_password_keep_stretched_key_t *stretched_key = NULL;
+	static char *function                               = "libbde_password_keep_calculate_key";
+	int result                                          = 0;
+
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          password_hash_size,
+	          salt,
+	          salt_size,
+	          &stretched_key,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libbde_password_keep_append_stretched_key(
+		     password_keep,
+		     password_hash,
+		     password_hash_size,
+		     salt,
+		     salt_size,
+		     &stretched_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append stretched key.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( ( stretched_key->key_is_set == 0 )
+	 && ( password_keep->use_key_memo != 0 ) )
+	{
+		result = libbde_key_memo_get_key(
+		          stretched_key->password_hash,
+		          stretched_key->salt,
+		          stretched_key->key,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve stretched key from key memo.",
+			 function );
+
+			return( -1 );
+		}
+		stretched_key->key_is_set = (uint8_t) result;
+	}
+	if( stretched_key->key_is_set == 0 )
+	{
+		if( libbde_password_calculate_key(
+		     stretched_key->password_hash,
+		     32,
+		     stretched_key->salt,
+		     16,
+		     stretched_key->key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate stretched key.",
+			 function );
+
+			return( -1 );
+		}
+		stretched_key->key_is_set = 1;
+
+		if( password_keep->use_key_memo != 0 )
+		{
+			if( libbde_key_memo_append_key(
+			     stretched_key->password_hash,
+			     stretched_key->salt,
+			     stretched_key->key,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append stretched key to key memo.",
+				 function );
+
+				return( -1 );
+			}
+		}
+	}
+	if( memory_copy(
+	     key,
+	     stretched_key->key,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
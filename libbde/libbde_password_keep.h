@@ -25,12 +25,34 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbde_definitions.h"
 #include "libbde_libcerror.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libbde_password_keep_stretched_key libbde_password_keep_stretched_key_t;
+
+struct libbde_password_keep_stretched_key
+{
+	/* The SHA-256 hash of the password
+	 */
+	uint8_t password_hash[ 32 ];
+
+	/* The salt
+	 */
+	uint8_t salt[ 16 ];
+
+	/* The stretched key
+	 */
+	uint8_t key[ 32 ];
+
+	/* Value to indicate the stretched key was calculated
+	 */
+	uint8_t key_is_set;
+};
+
 typedef struct libbde_password_keep libbde_password_keep_t;
 
 struct libbde_password_keep
@@ -50,6 +72,22 @@ struct libbde_password_keep
 	/* Value to indicate the recovery password is set
 	 */
 	uint8_t recovery_password_is_set;
+
+	/* The stretched keys, which are calculated once per password hash and salt
+	 */
+	libbde_password_keep_stretched_key_t stretched_keys[ LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS ];
+
+	/* The number of stretched keys
+	 */
+	int number_of_stretched_keys;
+
+	/* The index of the next stretched key to replace when all stretched keys are used
+	 */
+	int next_stretched_key_index;
+
+	/* Value to indicate the process-wide key memo is used
+	 */
+	uint8_t use_key_memo;
 };
 
 int libbde_password_keep_initialize(
@@ -60,6 +98,41 @@ int libbde_password_keep_free(
      libbde_password_keep_t **password_keep,
      libcerror_error_t **error );
 
+int libbde_password_keep_get_stretched_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     libbde_password_keep_stretched_key_t **stretched_key,
+     libcerror_error_t **error );
+
+int libbde_password_keep_append_stretched_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     libbde_password_keep_stretched_key_t **stretched_key,
+     libcerror_error_t **error );
+
+int libbde_password_keep_stretched_key_calculate(
+     void *arguments );
+
+int libbde_password_keep_calculate_stretched_keys(
+     libbde_password_keep_t *password_keep,
+     libcerror_error_t **error );
+
+int libbde_password_keep_calculate_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -20,13 +20,13 @@
  */
 
 #include <common.h>
-#include <byte_stream.h>
 #include <memory.h>
 #include <types.h>
 
 #include "libbde_definitions.h"
 #include "libbde_encryption.h"
 #include "libbde_io_handle.h"
+#include "libbde_io_uring.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
@@ -222,10 +222,10 @@ int libbde_sector_data_read(
      off64_t sector_data_offset,
      libbde_encryption_context_t *encryption_context,
      uint8_t zero_metadata,
+     uint8_t file_io_handle_is_shared,
      libcerror_error_t **error )
 {
 	static char *function = "libbde_sector_data_read";
-	ssize_t read_count    = 0;
 
 	if( sector_data == NULL )
 	{
@@ -281,223 +281,305 @@ int libbde_sector_data_read(
 		 sector_data_offset );
 	}
 #endif
-	if( zero_metadata != 0 )
-	{
-		/* The BitLocker metadata areas are represented as zero byte blocks
-		 */
-		if( ( ( sector_data_offset >= io_handle->first_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->first_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
-		 || ( ( sector_data_offset >= io_handle->second_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->second_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
-		 || ( ( sector_data_offset >= io_handle->third_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->third_metadata_offset + (off64_t) io_handle->metadata_size ) ) ) )
-		{
-			if( memory_set(
-			     sector_data->data,
-			     0,
-			     sector_data->data_size ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear data.",
-				 function );
-
-				return( -1 );
-			}
-			return( 1 );
-		}
-	}
-	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
-	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
-	{
-		if( zero_metadata != 0 )
-		{
-			if( ( sector_data_offset >= io_handle->volume_header_offset )
-			 && ( sector_data_offset < ( io_handle->volume_header_offset + (off64_t) io_handle->volume_header_size ) ) )
-			{
-				if( memory_set(
-				     sector_data->data,
-				     0,
-				     sector_data->data_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear data.",
-					 function );
-
-					return( -1 );
-				}
-				return( 1 );
-			}
-		}
-		/* Normally the first 8192 bytes are stored in another location on the volume
-		 */
-		if( (size64_t) sector_data_offset < io_handle->volume_header_size )
-		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "%s: reading volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 io_handle->volume_header_offset,
-				 io_handle->volume_header_offset );
-			}
-#endif
-			sector_data_offset += io_handle->volume_header_offset;
-		}
-	}
-	if( libbfio_handle_seek_offset(
+	if( libbde_io_handle_read_sectors(
+	     io_handle,
 	     file_io_handle,
 	     sector_data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	     encryption_context,
+	     sector_data->encrypted_data,
+	     sector_data->data,
+	     sector_data->data_size,
+	     zero_metadata,
+	     file_io_handle_is_shared,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek sector data offset: %" PRIi64 ".",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data at offset: %" PRIi64 ".",
 		 function,
 		 sector_data_offset );
 
 		return( -1 );
 	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              sector_data->encrypted_data,
-	              sector_data->data_size,
-	              error );
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: sector data:\n",
+		 function );
+		libcnotify_print_data(
+		 sector_data->data,
+		 sector_data->data_size,
+		 0 );
+	}
+#endif
+	return( 1 );
+}
 
-	if( read_count != (ssize_t) sector_data->data_size )
+/* Reads multiple sector data using io_uring
+ * All the runs of sectors of the sector data are submitted at once, so that
+ * they are in flight in parallel, and decrypted when all reads have completed
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_read_multiple(
+     libbde_sector_data_t **sector_data,
+     off64_t *sector_data_offsets,
+     int number_of_sector_data,
+     libbde_io_handle_t *io_handle,
+     libbde_io_uring_t *io_uring,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t zero_metadata,
+     libcerror_error_t **error )
+{
+	libbde_io_uring_read_t *reads = NULL;
+	void *reallocation            = NULL;
+	static char *function         = "libbde_sector_data_read_multiple";
+	size_t data_offset            = 0;
+	size_t run_size               = 0;
+	off64_t physical_offset       = 0;
+	uint8_t storage_type          = 0;
+	int maximum_number_of_reads   = 0;
+	int number_of_reads           = 0;
+	int sector_data_index         = 0;
+
+	if( sector_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sector data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( sector_data_offsets == NULL )
 	{
-		libcnotify_printf(
-		 "%s: encrypted sector data:\n",
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data offsets.",
 		 function );
-		libcnotify_print_data(
-		 sector_data->encrypted_data,
-		 sector_data->data_size,
-		 0 );
+
+		return( -1 );
 	}
-#endif
-	/* In Windows Vista the first 16 sectors are unencrypted
-	 */
-	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
-	 && ( (size64_t) sector_data_offset < 8192 ) )
+	if( ( number_of_sector_data <= 0 )
+	 || ( number_of_sector_data > ( 1 << 16 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sector data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
 	{
-		if( memory_copy(
-		     sector_data->data,
-		     sector_data->encrypted_data,
-		     sector_data->data_size ) == NULL )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_data_index = 0;
+	     sector_data_index < number_of_sector_data;
+	     sector_data_index++ )
+	{
+		if( ( sector_data[ sector_data_index ] == NULL )
+		 || ( sector_data[ sector_data_index ]->encrypted_data == NULL )
+		 || ( sector_data[ sector_data_index ]->data == NULL ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy encrypted data.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+			 "%s: invalid sector data: %d.",
+			 function,
+			 sector_data_index );
 
 			return( -1 );
 		}
-		/* In Windows Vista the first sector is altered
-		 */
-		if( sector_data_offset < 512 )
+	}
+	/* Determine the runs of sectors that need to be read
+	 */
+	for( sector_data_index = 0;
+	     sector_data_index < number_of_sector_data;
+	     sector_data_index++ )
+	{
+		data_offset = 0;
+
+		while( data_offset < sector_data[ sector_data_index ]->data_size )
 		{
-			/* Change the volume header signature "-FVE-FS-"
-			 * into "NTFS    "
-			 */
-			if( memory_copy(
-			     &( sector_data->data[ 3 ] ),
-			     "NTFS    ",
-			     8 ) == NULL )
+			if( libbde_io_handle_get_sectors_run(
+			     io_handle,
+			     sector_data_offsets[ sector_data_index ] + (off64_t) data_offset,
+			     sector_data[ sector_data_index ]->data_size - data_offset,
+			     zero_metadata,
+			     &physical_offset,
+			     &storage_type,
+			     &run_size,
+			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy encrypted data.",
-				 function );
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine sectors run at offset: %" PRIi64 ".",
+				 function,
+				 sector_data_offsets[ sector_data_index ] + (off64_t) data_offset );
+
+				goto on_error;
+			}
+			if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_SPARSE )
+			{
+				if( memory_set(
+				     &( sector_data[ sector_data_index ]->data[ data_offset ] ),
+				     0,
+				     run_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear data.",
+					 function );
 
-				return( -1 );
+					goto on_error;
+				}
+				data_offset += run_size;
+
+				continue;
 			}
-			/* Change the FVE metadatsa block 1 cluster block number
-			 * into the MFT mirror cluster block number
+			if( number_of_reads >= maximum_number_of_reads )
+			{
+				maximum_number_of_reads += number_of_sector_data;
+
+				reallocation = memory_reallocate(
+				                reads,
+				                sizeof( libbde_io_uring_read_t ) * (size_t) maximum_number_of_reads );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize reads.",
+					 function );
+
+					goto on_error;
+				}
+				reads = (libbde_io_uring_read_t *) reallocation;
+			}
+			/* Unencrypted sectors are read directly into the data
 			 */
-			byte_stream_copy_from_uint64_little_endian(
-			 &( sector_data->data[ 56 ] ),
-			 io_handle->mft_mirror_cluster_block_number );
+			reads[ number_of_reads ].offset = physical_offset;
+			reads[ number_of_reads ].size   = run_size;
+
+			if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED )
+			{
+				reads[ number_of_reads ].buffer = &( sector_data[ sector_data_index ]->data[ data_offset ] );
+			}
+			else
+			{
+				reads[ number_of_reads ].buffer = &( sector_data[ sector_data_index ]->encrypted_data[ data_offset ] );
+			}
+			number_of_reads++;
+
+			data_offset += run_size;
 		}
 	}
-	/* Check if the offset is outside the encrypted part of the volume
-	 */
-	else if( ( io_handle->encrypted_volume_size != 0 )
-	      && ( sector_data_offset >= (off64_t) io_handle->encrypted_volume_size ) )
+	if( number_of_reads > 0 )
 	{
-		if( memory_copy(
-		     sector_data->data,
-		     sector_data->encrypted_data,
-		     sector_data->data_size ) == NULL )
+		if( libbde_io_uring_read(
+		     io_uring,
+		     reads,
+		     number_of_reads,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy encrypted data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector data.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
+		memory_free(
+		 reads );
+
+		reads = NULL;
 	}
-	else
+	/* Decrypt the runs of sectors now that all reads have completed
+	 */
+	for( sector_data_index = 0;
+	     sector_data_index < number_of_sector_data;
+	     sector_data_index++ )
 	{
-		if( libbde_encryption_crypt(
-		     encryption_context,
-		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
-		     sector_data->encrypted_data,
-		     sector_data->data_size,
-		     sector_data->data,
-		     sector_data->data_size,
-		     (uint64_t) sector_data_offset,
-		     error ) != 1 )
+		data_offset = 0;
+
+		while( data_offset < sector_data[ sector_data_index ]->data_size )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to decrypt sector data.",
-			 function );
+			if( libbde_io_handle_get_sectors_run(
+			     io_handle,
+			     sector_data_offsets[ sector_data_index ] + (off64_t) data_offset,
+			     sector_data[ sector_data_index ]->data_size - data_offset,
+			     zero_metadata,
+			     &physical_offset,
+			     &storage_type,
+			     &run_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine sectors run at offset: %" PRIi64 ".",
+				 function,
+				 sector_data_offsets[ sector_data_index ] + (off64_t) data_offset );
 
-			return( -1 );
+				goto on_error;
+			}
+			if( libbde_io_handle_decrypt_sectors_run(
+			     io_handle,
+			     encryption_context,
+			     physical_offset,
+			     storage_type,
+			     &( sector_data[ sector_data_index ]->encrypted_data[ data_offset ] ),
+			     &( sector_data[ sector_data_index ]->data[ data_offset ] ),
+			     run_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt sectors run at offset: %" PRIi64 ".",
+				 function,
+				 physical_offset );
+
+				goto on_error;
+			}
+			data_offset += run_size;
 		}
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	return( 1 );
+
+on_error:
+	if( reads != NULL )
 	{
-		libcnotify_printf(
-		 "%s: sector data:\n",
-		 function );
-		libcnotify_print_data(
-		 sector_data->data,
-		 sector_data->data_size,
-		 0 );
+		memory_free(
+		 reads );
 	}
-#endif
-	return( 1 );
+	return( -1 );
 }
 
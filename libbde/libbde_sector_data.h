@@ -27,6 +27,7 @@
 
 #include "libbde_encryption.h"
 #include "libbde_io_handle.h"
+#include "libbde_io_uring.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 
@@ -67,6 +68,17 @@ int libbde_sector_data_read(
      off64_t sector_offset,
      libbde_encryption_context_t *encryption_context,
      uint8_t zero_metadata,
+     uint8_t file_io_handle_is_shared,
+     libcerror_error_t **error );
+
+int libbde_sector_data_read_multiple(
+     libbde_sector_data_t **sector_data,
+     off64_t *sector_data_offsets,
+     int number_of_sector_data,
+     libbde_io_handle_t *io_handle,
+     libbde_io_uring_t *io_uring,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t zero_metadata,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
@@ -0,0 +1,416 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sector_data.h"
+#include "libbde_sector_data_pool.h"
+
+/* Creates a sector data pool
+ * Make sure the value sector_data_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_pool_initialize(
+     libbde_sector_data_pool_t **sector_data_pool,
+     size_t data_size,
+     int maximum_number_of_free_sector_data,
+     libcerror_error_t **error )
+{
+	static char *function        = "libbde_sector_data_pool_initialize";
+	size_t free_sector_data_size = 0;
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_free_sector_data <= 0 )
+	 || ( maximum_number_of_free_sector_data > ( 1 << 20 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of free sector data value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*sector_data_pool = memory_allocate_structure(
+	                     libbde_sector_data_pool_t );
+
+	if( *sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector data pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_data_pool,
+	     0,
+	     sizeof( libbde_sector_data_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector data pool.",
+		 function );
+
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+
+		return( -1 );
+	}
+	free_sector_data_size = sizeof( libbde_sector_data_t * ) * (size_t) maximum_number_of_free_sector_data;
+
+	( *sector_data_pool )->free_sector_data = (libbde_sector_data_t **) memory_allocate(
+	                                                                     free_sector_data_size );
+
+	if( ( *sector_data_pool )->free_sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create free sector data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sector_data_pool )->free_sector_data,
+	     0,
+	     free_sector_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear free sector data.",
+		 function );
+
+		goto on_error;
+	}
+	( *sector_data_pool )->data_size                          = data_size;
+	( *sector_data_pool )->maximum_number_of_free_sector_data = maximum_number_of_free_sector_data;
+
+	return( 1 );
+
+on_error:
+	if( *sector_data_pool != NULL )
+	{
+		if( ( *sector_data_pool )->free_sector_data != NULL )
+		{
+			memory_free(
+			 ( *sector_data_pool )->free_sector_data );
+		}
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sector data pool
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_pool_free(
+     libbde_sector_data_pool_t **sector_data_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_pool_free";
+	int result            = 1;
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data_pool != NULL )
+	{
+		while( ( *sector_data_pool )->number_of_free_sector_data > 0 )
+		{
+			( *sector_data_pool )->number_of_free_sector_data -= 1;
+
+			if( libbde_sector_data_free(
+			     &( ( *sector_data_pool )->free_sector_data[ ( *sector_data_pool )->number_of_free_sector_data ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 ( *sector_data_pool )->free_sector_data );
+
+		memory_free(
+		 *sector_data_pool );
+
+		*sector_data_pool = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves sector data from the pool
+ * Reuses free sector data if available, otherwise new sector data is created
+ * The caller takes over management of the sector data
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_pool_get_sector_data(
+     libbde_sector_data_pool_t *sector_data_pool,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_pool_get_sector_data";
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data_pool->number_of_free_sector_data > 0 )
+	{
+		sector_data_pool->number_of_free_sector_data -= 1;
+
+		*sector_data = sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ];
+
+		sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ] = NULL;
+
+		sector_data_pool->number_of_reuses += 1;
+
+		return( 1 );
+	}
+	if( libbde_sector_data_initialize(
+	     sector_data,
+	     sector_data_pool->data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data.",
+		 function );
+
+		return( -1 );
+	}
+	sector_data_pool->number_of_allocations += 1;
+
+	return( 1 );
+}
+
+/* Releases sector data into the pool
+ * The sector data is kept for reuse if it has the data size of the pool
+ * and the pool is not full, otherwise it is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_pool_release_sector_data(
+     libbde_sector_data_pool_t *sector_data_pool,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_pool_release_sector_data";
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data == NULL )
+	{
+		return( 1 );
+	}
+	if( ( ( *sector_data )->data_size == sector_data_pool->data_size )
+	 && ( sector_data_pool->number_of_free_sector_data < sector_data_pool->maximum_number_of_free_sector_data ) )
+	{
+		sector_data_pool->free_sector_data[ sector_data_pool->number_of_free_sector_data ] = *sector_data;
+
+		sector_data_pool->number_of_free_sector_data += 1;
+
+		*sector_data = NULL;
+
+		return( 1 );
+	}
+	if( libbde_sector_data_free(
+	     sector_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sector data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the sector data pool statistics
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_pool_get_statistics(
+     libbde_sector_data_pool_t *sector_data_pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_pool_get_statistics";
+
+	if( sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_allocations == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocations.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reuses == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reuses.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_allocations = sector_data_pool->number_of_allocations;
+	*number_of_reuses      = sector_data_pool->number_of_reuses;
+
+	return( 1 );
+}
+
@@ -0,0 +1,96 @@
+/*
+ * Sector data pool functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _LIBBDE_SECTOR_DATA_POOL_H )
+#define _LIBBDE_SECTOR_DATA_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sector_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_sector_data_pool libbde_sector_data_pool_t;
+
+struct libbde_sector_data_pool
+{
+	/* The data size of the pooled sector data
+	 */
+	size_t data_size;
+
+	/* The free sector data
+	 */
+	libbde_sector_data_t **free_sector_data;
+
+	/* The number of free sector data
+	 */
+	int number_of_free_sector_data;
+
+	/* The maximum number of free sector data
+	 */
+	int maximum_number_of_free_sector_data;
+
+	/* The number of sector data allocations
+	 */
+	uint64_t number_of_allocations;
+
+	/* The number of sector data reuses
+	 */
+	uint64_t number_of_reuses;
+};
+
+int libbde_sector_data_pool_initialize(
+     libbde_sector_data_pool_t **sector_data_pool,
+     size_t data_size,
+     int maximum_number_of_free_sector_data,
+     libcerror_error_t **error );
+
+int libbde_sector_data_pool_free(
+     libbde_sector_data_pool_t **sector_data_pool,
+     libcerror_error_t **error );
+
+int libbde_sector_data_pool_get_sector_data(
+     libbde_sector_data_pool_t *sector_data_pool,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libbde_sector_data_pool_release_sector_data(
+     libbde_sector_data_pool_t *sector_data_pool,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libbde_sector_data_pool_get_statistics(
+     libbde_sector_data_pool_t *sector_data_pool,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_SECTOR_DATA_POOL_H ) */
+
@@ -0,0 +1,573 @@
+/*
+ * Sectors cache functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sector_data.h"
+#include "libbde_sectors_cache.h"
+
+/* Determines the hash bucket index of an offset
+ * Uses Fibonacci hashing so that offsets that are a multiple of the sector size
+ * are evenly distributed over the buckets
+ */
+#define libbde_sectors_cache_get_bucket_index( sectors_cache, offset ) \
+	(int) ( ( (uint64_t) ( offset ) * (uint64_t) 0x9e3779b97f4a7c15ULL ) >> ( 64 - ( sectors_cache )->number_of_bucket_bits ) )
+
+/* Creates a sectors cache
+ * Make sure the value sectors_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sectors_cache_initialize(
+     libbde_sectors_cache_t **sectors_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function        = "libbde_sectors_cache_initialize";
+	size_t buckets_size          = 0;
+	uint8_t number_of_bucket_bits = 4;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sectors_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sectors cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_entries <= 0 )
+	 || ( maximum_number_of_entries > ( 1 << 30 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( ( 1 << number_of_bucket_bits ) < maximum_number_of_entries )
+	{
+		number_of_bucket_bits++;
+	}
+	*sectors_cache = memory_allocate_structure(
+	                  libbde_sectors_cache_t );
+
+	if( *sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sectors cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sectors_cache,
+	     0,
+	     sizeof( libbde_sectors_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sectors cache.",
+		 function );
+
+		memory_free(
+		 *sectors_cache );
+
+		*sectors_cache = NULL;
+
+		return( -1 );
+	}
+	buckets_size = sizeof( libbde_sectors_cache_entry_t * ) * ( (size_t) 1 << number_of_bucket_bits );
+
+	( *sectors_cache )->buckets = (libbde_sectors_cache_entry_t **) memory_allocate(
+	                                                                 buckets_size );
+
+	if( ( *sectors_cache )->buckets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buckets.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sectors_cache )->buckets,
+	     0,
+	     buckets_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		goto on_error;
+	}
+	( *sectors_cache )->number_of_buckets         = 1 << number_of_bucket_bits;
+	( *sectors_cache )->number_of_bucket_bits     = number_of_bucket_bits;
+	( *sectors_cache )->maximum_number_of_entries = maximum_number_of_entries;
+
+	return( 1 );
+
+on_error:
+	if( *sectors_cache != NULL )
+	{
+		if( ( *sectors_cache )->buckets != NULL )
+		{
+			memory_free(
+			 ( *sectors_cache )->buckets );
+		}
+		memory_free(
+		 *sectors_cache );
+
+		*sectors_cache = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a sectors cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sectors_cache_free(
+     libbde_sectors_cache_t **sectors_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sectors_cache_free";
+	int result            = 1;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sectors_cache != NULL )
+	{
+		if( libbde_sectors_cache_empty(
+		     *sectors_cache,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to empty sectors cache.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 ( *sectors_cache )->buckets );
+
+		memory_free(
+		 *sectors_cache );
+
+		*sectors_cache = NULL;
+	}
+	return( result );
+}
+
+/* Empties a sectors cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sectors_cache_empty(
+     libbde_sectors_cache_t *sectors_cache,
+     libcerror_error_t **error )
+{
+	libbde_sectors_cache_entry_t *cache_entry = NULL;
+	libbde_sectors_cache_entry_t *next_entry  = NULL;
+	static char *function                     = "libbde_sectors_cache_empty";
+	int result                                = 1;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	cache_entry = sectors_cache->most_recently_used;
+
+	while( cache_entry != NULL )
+	{
+		next_entry = cache_entry->next_used;
+
+		if( libbde_sector_data_free(
+		     &( cache_entry->sector_data ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector data.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 cache_entry );
+
+		cache_entry = next_entry;
+	}
+	if( memory_set(
+	     sectors_cache->buckets,
+	     0,
+	     sizeof( libbde_sectors_cache_entry_t * ) * (size_t) sectors_cache->number_of_buckets ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buckets.",
+		 function );
+
+		result = -1;
+	}
+	sectors_cache->number_of_entries   = 0;
+	sectors_cache->most_recently_used  = NULL;
+	sectors_cache->least_recently_used = NULL;
+
+	return( result );
+}
+
+/* Retrieves the number of entries
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sectors_cache_get_number_of_entries(
+     libbde_sectors_cache_t *sectors_cache,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sectors_cache_get_number_of_entries";
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = sectors_cache->number_of_entries;
+
+	return( 1 );
+}
+
+/* Retrieves the sector data of a specific offset
+ * The entry becomes the most recently used entry
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_sectors_cache_get_sector_data_by_offset(
+     libbde_sectors_cache_t *sectors_cache,
+     off64_t offset,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	libbde_sectors_cache_entry_t *cache_entry = NULL;
+	static char *function                     = "libbde_sectors_cache_get_sector_data_by_offset";
+	int bucket_index                          = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	*sector_data = NULL;
+
+	bucket_index = libbde_sectors_cache_get_bucket_index(
+	                sectors_cache,
+	                offset );
+
+	cache_entry = sectors_cache->buckets[ bucket_index ];
+
+	while( cache_entry != NULL )
+	{
+		if( cache_entry->offset == offset )
+		{
+			break;
+		}
+		cache_entry = cache_entry->next_in_bucket;
+	}
+	if( cache_entry == NULL )
+	{
+		return( 0 );
+	}
+	if( cache_entry != sectors_cache->most_recently_used )
+	{
+		/* Unlink the entry from the used list
+		 */
+		cache_entry->previous_used->next_used = cache_entry->next_used;
+
+		if( cache_entry->next_used != NULL )
+		{
+			cache_entry->next_used->previous_used = cache_entry->previous_used;
+		}
+		else
+		{
+			sectors_cache->least_recently_used = cache_entry->previous_used;
+		}
+		/* Make the entry the most recently used entry
+		 */
+		cache_entry->previous_used = NULL;
+		cache_entry->next_used     = sectors_cache->most_recently_used;
+
+		sectors_cache->most_recently_used->previous_used = cache_entry;
+		sectors_cache->most_recently_used                = cache_entry;
+	}
+	*sector_data = cache_entry->sector_data;
+
+	return( 1 );
+}
+
+/* Sets the sector data of a specific offset
+ * The sectors cache takes over management of the sector data
+ * If the cache is full the least recently used entry is evicted, the sector data
+ * that is no longer cached is returned in evicted sector data and the caller
+ * takes over its management
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sectors_cache_set_sector_data_by_offset(
+     libbde_sectors_cache_t *sectors_cache,
+     off64_t offset,
+     libbde_sector_data_t *sector_data,
+     libbde_sector_data_t **evicted_sector_data,
+     libcerror_error_t **error )
+{
+	libbde_sectors_cache_entry_t *bucket_entry  = NULL;
+	libbde_sectors_cache_entry_t *cache_entry   = NULL;
+	libbde_sector_data_t *existing_sector_data  = NULL;
+	static char *function                       = "libbde_sectors_cache_set_sector_data_by_offset";
+	int bucket_index                            = 0;
+	int result                                  = 0;
+
+	if( sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( evicted_sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid evicted sector data.",
+		 function );
+
+		return( -1 );
+	}
+	*evicted_sector_data = NULL;
+
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          sectors_cache,
+	          offset,
+	          &existing_sector_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sector data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		/* The existing entry is now the most recently used entry
+		 */
+		cache_entry = sectors_cache->most_recently_used;
+
+		if( existing_sector_data != sector_data )
+		{
+			*evicted_sector_data     = existing_sector_data;
+			cache_entry->sector_data = sector_data;
+		}
+		return( 1 );
+	}
+	if( sectors_cache->number_of_entries < sectors_cache->maximum_number_of_entries )
+	{
+		cache_entry = memory_allocate_structure(
+		               libbde_sectors_cache_entry_t );
+
+		if( cache_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create cache entry.",
+			 function );
+
+			return( -1 );
+		}
+		sectors_cache->number_of_entries += 1;
+	}
+	else
+	{
+		/* Evict the least recently used entry
+		 */
+		cache_entry = sectors_cache->least_recently_used;
+
+		bucket_index = libbde_sectors_cache_get_bucket_index(
+		                sectors_cache,
+		                cache_entry->offset );
+
+		if( sectors_cache->buckets[ bucket_index ] == cache_entry )
+		{
+			sectors_cache->buckets[ bucket_index ] = cache_entry->next_in_bucket;
+		}
+		else
+		{
+			bucket_entry = sectors_cache->buckets[ bucket_index ];
+
+			while( bucket_entry->next_in_bucket != cache_entry )
+			{
+				bucket_entry = bucket_entry->next_in_bucket;
+			}
+			bucket_entry->next_in_bucket = cache_entry->next_in_bucket;
+		}
+		sectors_cache->least_recently_used = cache_entry->previous_used;
+
+		if( sectors_cache->least_recently_used != NULL )
+		{
+			sectors_cache->least_recently_used->next_used = NULL;
+		}
+		else
+		{
+			sectors_cache->most_recently_used = NULL;
+		}
+		*evicted_sector_data = cache_entry->sector_data;
+	}
+	bucket_index = libbde_sectors_cache_get_bucket_index(
+	                sectors_cache,
+	                offset );
+
+	cache_entry->offset         = offset;
+	cache_entry->sector_data    = sector_data;
+	cache_entry->next_in_bucket = sectors_cache->buckets[ bucket_index ];
+	cache_entry->previous_used  = NULL;
+	cache_entry->next_used      = sectors_cache->most_recently_used;
+
+	sectors_cache->buckets[ bucket_index ] = cache_entry;
+
+	if( sectors_cache->most_recently_used != NULL )
+	{
+		sectors_cache->most_recently_used->previous_used = cache_entry;
+	}
+	else
+	{
+		sectors_cache->least_recently_used = cache_entry;
+	}
+	sectors_cache->most_recently_used = cache_entry;
+
+	return( 1 );
+}
+
@@ -0,0 +1,129 @@
+/*
+ * Sectors cache functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_SECTORS_CACHE_H )
+#define _LIBBDE_SECTORS_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sector_data.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_sectors_cache_entry libbde_sectors_cache_entry_t;
+
+struct libbde_sectors_cache_entry
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The sector data
+	 */
+	libbde_sector_data_t *sector_data;
+
+	/* The next entry in the same hash bucket
+	 */
+	libbde_sectors_cache_entry_t *next_in_bucket;
+
+	/* The previous (more recently used) entry
+	 */
+	libbde_sectors_cache_entry_t *previous_used;
+
+	/* The next (less recently used) entry
+	 */
+	libbde_sectors_cache_entry_t *next_used;
+};
+
+typedef struct libbde_sectors_cache libbde_sectors_cache_t;
+
+struct libbde_sectors_cache
+{
+	/* The hash buckets
+	 */
+	libbde_sectors_cache_entry_t **buckets;
+
+	/* The number of hash buckets
+	 */
+	int number_of_buckets;
+
+	/* The number of bits of the bucket index
+	 */
+	uint8_t number_of_bucket_bits;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The most recently used entry
+	 */
+	libbde_sectors_cache_entry_t *most_recently_used;
+
+	/* The least recently used entry
+	 */
+	libbde_sectors_cache_entry_t *least_recently_used;
+};
+
+int libbde_sectors_cache_initialize(
+     libbde_sectors_cache_t **sectors_cache,
+     int maximum_number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_sectors_cache_free(
+     libbde_sectors_cache_t **sectors_cache,
+     libcerror_error_t **error );
+
+int libbde_sectors_cache_empty(
+     libbde_sectors_cache_t *sectors_cache,
+     libcerror_error_t **error );
+
+int libbde_sectors_cache_get_number_of_entries(
+     libbde_sectors_cache_t *sectors_cache,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_sectors_cache_get_sector_data_by_offset(
+     libbde_sectors_cache_t *sectors_cache,
+     off64_t offset,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libbde_sectors_cache_set_sector_data_by_offset(
+     libbde_sectors_cache_t *sectors_cache,
+     off64_t offset,
+     libbde_sector_data_t *sector_data,
+     libbde_sector_data_t **evicted_sector_data,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_SECTORS_CACHE_H ) */
+
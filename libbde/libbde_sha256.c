@@ -0,0 +1,693 @@
+/*
+ * SHA-256 key stretching functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sha256.h"
+
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+
+#include <cpuid.h>
+#include <emmintrin.h>
+#include <immintrin.h>
+#include <smmintrin.h>
+#include <tmmintrin.h>
+
+#define LIBBDE_SHA256_NI_TARGET		__attribute__(( target( "sha,sse4.1" ) ))
+
+#if !defined( bit_SHA )
+#define bit_SHA				( 1 << 29 )
+#endif
+
+#endif /* defined( HAVE_LIBBDE_SHA256_NI_SUPPORT ) */
+
+/* The key data that is hashed every key iteration consists of:
+ * the last SHA-256 hash (32 bytes), the initial SHA-256 hash (32 bytes),
+ * the salt (16 bytes) and the 64-bit little-endian iteration count,
+ * which is 88 bytes of data and hence 2 SHA-256 message blocks
+ * The first block contains the last and initial hash, the second block the salt,
+ * the iteration count and the padding, where only the last hash and the iteration
+ * count change every key iteration
+ */
+
+/* The SHA-256 round constants
+ */
+const uint32_t libbde_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* The SHA-256 initial hash values
+ */
+const uint32_t libbde_sha256_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+#define libbde_sha256_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* Calculates a single SHA-256 round, where the roles of the working variables
+ * are rotated by the caller instead of the values being moved
+ */
+#define libbde_sha256_round( a, b, c, d, e, f, g, h, round_index ) \
+	temporary1 = h \
+	           + ( libbde_sha256_rotate_right( e, 6 ) ^ libbde_sha256_rotate_right( e, 11 ) ^ libbde_sha256_rotate_right( e, 25 ) ) \
+	           + ( ( e & f ) ^ ( ~e & g ) ) \
+	           + libbde_sha256_round_constants[ round_index ] \
+	           + schedule_words[ round_index ]; \
+	temporary2 = ( libbde_sha256_rotate_right( a, 2 ) ^ libbde_sha256_rotate_right( a, 13 ) ^ libbde_sha256_rotate_right( a, 22 ) ) \
+	           + ( ( a & b ) ^ ( a & c ) ^ ( b & c ) ); \
+	d         += temporary1; \
+	h          = temporary1 + temporary2;
+
+/* Determines if the CPU supports the SHA-NI instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_sha256_ni_is_supported(
+     void )
+{
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ecx & bit_SSE4_1 ) == 0 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid_count(
+	     7,
+	     0,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	if( ( ebx & bit_SHA ) == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Applies the SHA-256 compression function on a single message block
+ * The message block is provided as 16 (big-endian decoded) 32-bit words
+ */
+void libbde_sha256_transform(
+      uint32_t *state,
+      const uint32_t *message_words )
+{
+	uint32_t schedule_words[ 64 ];
+
+	uint32_t a          = 0;
+	uint32_t b          = 0;
+	uint32_t c          = 0;
+	uint32_t d          = 0;
+	uint32_t e          = 0;
+	uint32_t f          = 0;
+	uint32_t g          = 0;
+	uint32_t h          = 0;
+	uint32_t sigma0     = 0;
+	uint32_t sigma1     = 0;
+	uint32_t temporary1 = 0;
+	uint32_t temporary2 = 0;
+	int round_index     = 0;
+
+	for( round_index = 0;
+	     round_index < 16;
+	     round_index++ )
+	{
+		schedule_words[ round_index ] = message_words[ round_index ];
+	}
+	for( round_index = 16;
+	     round_index < 64;
+	     round_index++ )
+	{
+		sigma0 = libbde_sha256_rotate_right( schedule_words[ round_index - 15 ], 7 )
+		       ^ libbde_sha256_rotate_right( schedule_words[ round_index - 15 ], 18 )
+		       ^ ( schedule_words[ round_index - 15 ] >> 3 );
+
+		sigma1 = libbde_sha256_rotate_right( schedule_words[ round_index - 2 ], 17 )
+		       ^ libbde_sha256_rotate_right( schedule_words[ round_index - 2 ], 19 )
+		       ^ ( schedule_words[ round_index - 2 ] >> 10 );
+
+		schedule_words[ round_index ] = schedule_words[ round_index - 16 ]
+		                              + sigma0
+		                              + schedule_words[ round_index - 7 ]
+		                              + sigma1;
+	}
+	a = state[ 0 ];
+	b = state[ 1 ];
+	c = state[ 2 ];
+	d = state[ 3 ];
+	e = state[ 4 ];
+	f = state[ 5 ];
+	g = state[ 6 ];
+	h = state[ 7 ];
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index += 8 )
+	{
+		libbde_sha256_round( a, b, c, d, e, f, g, h, round_index )
+		libbde_sha256_round( h, a, b, c, d, e, f, g, round_index + 1 )
+		libbde_sha256_round( g, h, a, b, c, d, e, f, round_index + 2 )
+		libbde_sha256_round( f, g, h, a, b, c, d, e, round_index + 3 )
+		libbde_sha256_round( e, f, g, h, a, b, c, d, round_index + 4 )
+		libbde_sha256_round( d, e, f, g, h, a, b, c, round_index + 5 )
+		libbde_sha256_round( c, d, e, f, g, h, a, b, round_index + 6 )
+		libbde_sha256_round( b, c, d, e, f, g, h, a, round_index + 7 )
+	}
+	state[ 0 ] += a;
+	state[ 1 ] += b;
+	state[ 2 ] += c;
+	state[ 3 ] += d;
+	state[ 4 ] += e;
+	state[ 5 ] += f;
+	state[ 6 ] += g;
+	state[ 7 ] += h;
+}
+
+/* Calculates a stretched key using the portable SHA-256 compression function
+ * The password hash and key consist of 32 bytes and the salt of 16 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sha256_stretch_key_portable(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     libcerror_error_t **error )
+{
+	uint32_t first_block_words[ 16 ];
+	uint32_t second_block_words[ 16 ];
+	uint32_t state[ 8 ];
+
+	static char *function    = "libbde_sha256_stretch_key_portable";
+	uint32_t iteration_count = 0;
+	int word_index           = 0;
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last hash of the first key iteration is 0
+	 */
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		first_block_words[ word_index ] = 0;
+
+		byte_stream_copy_to_uint32_big_endian(
+		 &( password_hash[ word_index * 4 ] ),
+		 first_block_words[ word_index + 8 ] );
+	}
+	for( word_index = 0;
+	     word_index < 4;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( salt[ word_index * 4 ] ),
+		 second_block_words[ word_index ] );
+	}
+	/* The upper 32-bit of the iteration count, the padding and the data size in bits
+	 */
+	second_block_words[ 5 ]  = 0;
+	second_block_words[ 6 ]  = 0x80000000UL;
+
+	for( word_index = 7;
+	     word_index < 15;
+	     word_index++ )
+	{
+		second_block_words[ word_index ] = 0;
+	}
+	second_block_words[ 15 ] = 88 * 8;
+
+	for( iteration_count = 0;
+	     iteration_count < number_of_iterations;
+	     iteration_count++ )
+	{
+		/* The iteration count is stored little-endian in the key data
+		 */
+		second_block_words[ 4 ] = ( iteration_count >> 24 )
+		                        | ( ( iteration_count >> 8 ) & 0x0000ff00UL )
+		                        | ( ( iteration_count << 8 ) & 0x00ff0000UL )
+		                        | ( iteration_count << 24 );
+
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			state[ word_index ] = libbde_sha256_initial_hash_values[ word_index ];
+		}
+		libbde_sha256_transform(
+		 state,
+		 first_block_words );
+
+		libbde_sha256_transform(
+		 state,
+		 second_block_words );
+
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			first_block_words[ word_index ] = state[ word_index ];
+		}
+	}
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( key[ word_index * 4 ] ),
+		 first_block_words[ word_index ] );
+	}
+	memory_set(
+	 first_block_words,
+	 0,
+	 sizeof( uint32_t ) * 16 );
+
+	memory_set(
+	 state,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+
+/* Calculates 4 SHA-NI rounds using 4 message words
+ */
+#define libbde_sha256_ni_rounds( message, round_index ) \
+	message_schedule = _mm_add_epi32( \
+	                    message, \
+	                    _mm_loadu_si128( (const __m128i *) &( libbde_sha256_round_constants[ round_index ] ) ) ); \
+	state_cdgh       = _mm_sha256rnds2_epu32( state_cdgh, state_abef, message_schedule ); \
+	state_abef       = _mm_sha256rnds2_epu32( state_abef, state_cdgh, _mm_shuffle_epi32( message_schedule, 0x0e ) );
+
+/* Calculates the next 4 message words from the previous 16 message words
+ * The result replaces the oldest 4 message words
+ */
+#define libbde_sha256_ni_schedule( message0, message1, message2, message3 ) \
+	message0 = _mm_sha256msg2_epu32( \
+	            _mm_add_epi32( \
+	             _mm_sha256msg1_epu32( message0, message1 ), \
+	             _mm_alignr_epi8( message3, message2, 4 ) ), \
+	            message3 );
+
+/* Applies the SHA-256 compression function on a single message block
+ * The state is kept in the ABEF and CDGH order of the SHA-NI instructions
+ * and the message words are overwritten
+ */
+#define libbde_sha256_ni_transform( message0, message1, message2, message3 ) \
+	initial_state_abef = state_abef; \
+	initial_state_cdgh = state_cdgh; \
+	libbde_sha256_ni_rounds( message0, 0 ) \
+	libbde_sha256_ni_rounds( message1, 4 ) \
+	libbde_sha256_ni_rounds( message2, 8 ) \
+	libbde_sha256_ni_rounds( message3, 12 ) \
+	for( round_index = 16; \
+	     round_index < 64; \
+	     round_index += 16 ) \
+	{ \
+		libbde_sha256_ni_schedule( message0, message1, message2, message3 ) \
+		libbde_sha256_ni_rounds( message0, round_index ) \
+		libbde_sha256_ni_schedule( message1, message2, message3, message0 ) \
+		libbde_sha256_ni_rounds( message1, round_index + 4 ) \
+		libbde_sha256_ni_schedule( message2, message3, message0, message1 ) \
+		libbde_sha256_ni_rounds( message2, round_index + 8 ) \
+		libbde_sha256_ni_schedule( message3, message0, message1, message2 ) \
+		libbde_sha256_ni_rounds( message3, round_index + 12 ) \
+	} \
+	state_abef = _mm_add_epi32( state_abef, initial_state_abef ); \
+	state_cdgh = _mm_add_epi32( state_cdgh, initial_state_cdgh );
+
+#endif /* defined( HAVE_LIBBDE_SHA256_NI_SUPPORT ) */
+
+/* Calculates a stretched key using the SHA-NI instructions
+ * The state and the message words remain in registers during all key iterations
+ * The password hash and key consist of 32 bytes and the salt of 16 bytes
+ * Make sure to check libbde_sha256_ni_is_supported before calling this function
+ * Returns 1 if successful or -1 on error
+ */
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+LIBBDE_SHA256_NI_TARGET
+#endif
+int libbde_sha256_ni_stretch_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+	__m128i byte_swap_mask     = _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 );
+	__m128i initial_abef       = _mm_setzero_si128();
+	__m128i initial_cdgh       = _mm_setzero_si128();
+	__m128i initial_state_abef = _mm_setzero_si128();
+	__m128i initial_state_cdgh = _mm_setzero_si128();
+	__m128i last_hash_high     = _mm_setzero_si128();
+	__m128i last_hash_low      = _mm_setzero_si128();
+	__m128i message0           = _mm_setzero_si128();
+	__m128i message1           = _mm_setzero_si128();
+	__m128i message2           = _mm_setzero_si128();
+	__m128i message3           = _mm_setzero_si128();
+	__m128i message_schedule   = _mm_setzero_si128();
+	__m128i password_hash_high = _mm_setzero_si128();
+	__m128i password_hash_low  = _mm_setzero_si128();
+	__m128i salt_words         = _mm_setzero_si128();
+	__m128i state_abef         = _mm_setzero_si128();
+	__m128i state_cdgh         = _mm_setzero_si128();
+	__m128i temporary_state    = _mm_setzero_si128();
+	uint32_t iteration_count   = 0;
+	int round_index            = 0;
+#endif
+	static char *function      = "libbde_sha256_ni_stretch_key";
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_SHA256_NI_SUPPORT )
+	/* The initial hash values in ABEF and CDGH order
+	 */
+	initial_abef = _mm_set_epi32(
+	                (int) libbde_sha256_initial_hash_values[ 0 ],
+	                (int) libbde_sha256_initial_hash_values[ 1 ],
+	                (int) libbde_sha256_initial_hash_values[ 4 ],
+	                (int) libbde_sha256_initial_hash_values[ 5 ] );
+
+	initial_cdgh = _mm_set_epi32(
+	                (int) libbde_sha256_initial_hash_values[ 2 ],
+	                (int) libbde_sha256_initial_hash_values[ 3 ],
+	                (int) libbde_sha256_initial_hash_values[ 6 ],
+	                (int) libbde_sha256_initial_hash_values[ 7 ] );
+
+	password_hash_low = _mm_shuffle_epi8(
+	                     _mm_loadu_si128( (const __m128i *) password_hash ),
+	                     byte_swap_mask );
+
+	password_hash_high = _mm_shuffle_epi8(
+	                      _mm_loadu_si128( (const __m128i *) &( password_hash[ 16 ] ) ),
+	                      byte_swap_mask );
+
+	salt_words = _mm_shuffle_epi8(
+	              _mm_loadu_si128( (const __m128i *) salt ),
+	              byte_swap_mask );
+
+	/* The last hash of the first key iteration is 0
+	 */
+	last_hash_low  = _mm_setzero_si128();
+	last_hash_high = _mm_setzero_si128();
+
+	for( iteration_count = 0;
+	     iteration_count < number_of_iterations;
+	     iteration_count++ )
+	{
+		state_abef = initial_abef;
+		state_cdgh = initial_cdgh;
+
+		message0 = last_hash_low;
+		message1 = last_hash_high;
+		message2 = password_hash_low;
+		message3 = password_hash_high;
+
+		libbde_sha256_ni_transform( message0, message1, message2, message3 )
+
+		/* The iteration count is stored little-endian in the key data,
+		 * followed by the upper 32-bit of the iteration count, the padding
+		 * and the data size in bits
+		 */
+		message0 = salt_words;
+		message1 = _mm_set_epi32(
+		            0,
+		            (int) 0x80000000UL,
+		            0,
+		            (int) __builtin_bswap32( iteration_count ) );
+		message2 = _mm_setzero_si128();
+		message3 = _mm_set_epi32(
+		            88 * 8,
+		            0,
+		            0,
+		            0 );
+
+		libbde_sha256_ni_transform( message0, message1, message2, message3 )
+
+		/* Convert the state from ABEF and CDGH order into ABCD and EFGH order,
+		 * which are the message words of the next key iteration
+		 */
+		temporary_state = _mm_shuffle_epi32( state_abef, 0x1b );
+		state_cdgh      = _mm_shuffle_epi32( state_cdgh, 0xb1 );
+		last_hash_low   = _mm_blend_epi16( temporary_state, state_cdgh, 0xf0 );
+		last_hash_high  = _mm_alignr_epi8( state_cdgh, temporary_state, 8 );
+	}
+	_mm_storeu_si128(
+	 (__m128i *) key,
+	 _mm_shuffle_epi8( last_hash_low, byte_swap_mask ) );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( key[ 16 ] ),
+	 _mm_shuffle_epi8( last_hash_high, byte_swap_mask ) );
+
+	return( 1 );
+#else
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+	 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+	 "%s: SHA-NI is not supported.",
+	 function );
+
+	return( -1 );
+#endif /* defined( HAVE_LIBBDE_SHA256_NI_SUPPORT ) */
+}
+
+/* Calculates a stretched key
+ * Every key iteration the SHA-256 hash is calculated of the key data that consists of
+ * the hash of the previous key iteration, the password hash, the salt and the iteration count
+ * The key is the hash of the last key iteration
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sha256_stretch_key(
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sha256_stretch_key";
+	int result            = 0;
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_iterations == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid number of iterations value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sha256_ni_is_supported() != 0 )
+	{
+		result = libbde_sha256_ni_stretch_key(
+		          password_hash,
+		          salt,
+		          number_of_iterations,
+		          key,
+		          error );
+	}
+	else
+	{
+		result = libbde_sha256_stretch_key_portable(
+		          password_hash,
+		          salt,
+		          number_of_iterations,
+		          key,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate stretched key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
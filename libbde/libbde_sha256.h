@@ -0,0 +1,77 @@
+/*
+ * SHA-256 key stretching functions
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_SHA256_H )
+#define _LIBBDE_SHA256_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+/* The SHA-NI functions are build using function specific target attributes,
+ * so that no additional compiler flags are needed
+ */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 5 ) ) )
+#define HAVE_LIBBDE_SHA256_NI_SUPPORT
+#endif
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+int libbde_sha256_ni_is_supported(
+     void );
+
+void libbde_sha256_transform(
+      uint32_t *state,
+      const uint32_t *message_words );
+
+int libbde_sha256_stretch_key_portable(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     libcerror_error_t **error );
+
+int libbde_sha256_ni_stretch_key(
+     const uint8_t *password_hash,
+     const uint8_t *salt,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     libcerror_error_t **error );
+
+int libbde_sha256_stretch_key(
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_SHA256_H ) */
+
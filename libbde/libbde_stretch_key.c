@@ -128,11 +128,6 @@ int libbde_stretch_key_free(
 	}
 	if( *stretch_key != NULL )
 	{
-		if( ( *stretch_key )->data != NULL )
-		{
-			memory_free(
-			 ( *stretch_key )->data );
-		}
 		memory_free(
 		 *stretch_key );
 
@@ -149,9 +144,9 @@ int libbde_stretch_key_read(
      libbde_metadata_entry_t *metadata_entry,
      libcerror_error_t **error )
 {
-	uint8_t *value_data    = NULL;
-	static char *function  = "libbde_stretch_key_read";
-	size_t value_data_size = 0;
+	const uint8_t *value_data = NULL;
+	static char *function     = "libbde_stretch_key_read";
+	size_t value_data_size    = 0;
 
 	if( stretch_key == NULL )
 	{
@@ -228,7 +223,7 @@ int libbde_stretch_key_read(
 		 "%s: unable to copy salt to stretch key.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -264,46 +259,9 @@ int libbde_stretch_key_read(
 		 0 );
 	}
 #endif
-	stretch_key->data = (uint8_t *) memory_allocate(
-	                                 sizeof( uint8_t ) * value_data_size );
-
-	if( stretch_key->data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create data.",
-		 function );
-
-		goto on_error;
-	}
-	if( memory_copy(
-	     stretch_key->data,
-	     value_data,
-	     value_data_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy data to stretch key.",
-		 function );
-
-		goto on_error;
-	}
+	stretch_key->data      = value_data;
 	stretch_key->data_size = value_data_size;
-	
-	return( 1 );
 
-on_error:
-	if( stretch_key->data != NULL )
-	{
-		memory_free(
-		 stretch_key->data );
-
-		stretch_key->data = NULL;
-	}
-	return( -1 );
+	return( 1 );
 }
 
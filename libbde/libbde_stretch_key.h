@@ -45,8 +45,9 @@ struct libbde_stretch_key
 	uint8_t salt[ 16 ];
 
 	/* The (encrypted) data
+	 * references the metadata entry value data
 	 */
-	uint8_t *data;
+	const uint8_t *data;
 
 	/* The (encrypted) data size
 	 */
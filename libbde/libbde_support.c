@@ -26,7 +26,9 @@
 #include <wide_string.h>
 
 #include "libbde_definitions.h"
+#include "libbde_encryption.h"
 #include "libbde_io_handle.h"
+#include "libbde_key_memo.h"
 #include "libbde_libcerror.h"
 #include "libbde_libclocale.h"
 #include "libbde_support.h"
@@ -103,6 +105,114 @@ int libbde_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBBDE ) */
 
+/* Retrieves the crypto backend
+ * If the automatic crypto backend was requested the crypto backend it resolves to is retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_get_crypto_backend(
+     int *crypto_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_get_crypto_backend";
+
+	if( libbde_encryption_get_crypto_backend(
+	     crypto_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve crypto backend.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the crypto backend
+ * The crypto backend applies to volumes opened afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_set_crypto_backend(
+     int crypto_backend,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_set_crypto_backend";
+
+	if( libbde_encryption_set_crypto_backend(
+	     crypto_backend,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set crypto backend.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the key memo size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_get_key_memo_size(
+     int *key_memo_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_get_key_memo_size";
+
+	if( libbde_key_memo_get_size(
+	     key_memo_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve key memo size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the key memo size
+ * The key memo keeps stretched keys process-wide, so that volumes unlocked
+ * with the same password or recovery password and salt only stretch the key
+ * once. A size of 0, the default, disables the key memo
+ * The key memo applies to volumes created afterwards and cannot be changed
+ * while these volumes exist. The stretched keys are wiped when the last of
+ * these volumes is freed
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_set_key_memo_size(
+     int key_memo_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_set_key_memo_size";
+
+	if( libbde_key_memo_set_size(
+	     key_memo_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set key memo size.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Determines if a file contains a BDE volume signature
  * Returns 1 if true, 0 if not or -1 on error
  */
@@ -55,6 +55,26 @@ int libbde_set_codepage(
 
 #endif /* !defined( HAVE_LOCAL_LIBBDE ) */
 
+LIBBDE_EXTERN \
+int libbde_get_crypto_backend(
+     int *crypto_backend,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_set_crypto_backend(
+     int crypto_backend,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_get_key_memo_size(
+     int *key_memo_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_set_key_memo_size(
+     int key_memo_size,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_check_volume_signature(
      const char *volumename,
@@ -25,20 +25,46 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( HAVE_MMAP ) && defined( HAVE_MUNMAP ) && defined( HAVE_SYS_MMAN_H ) && !defined( WINAPI )
+#define HAVE_LIBBDE_MEMORY_MAP_SUPPORT
+#endif
+
+#if defined( HAVE_LIBBDE_MEMORY_MAP_SUPPORT )
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+#include <sys/mman.h>
+
+#if defined( HAVE_SYS_STAT_H )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#endif /* defined( HAVE_LIBBDE_MEMORY_MAP_SUPPORT ) */
+
 #include "libbde_debug.h"
 #include "libbde_definitions.h"
+#include "libbde_encryption.h"
 #include "libbde_io_handle.h"
+#include "libbde_io_uring.h"
+#include "libbde_key_memo.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
 #include "libbde_libcthreads.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
 #include "libbde_metadata.h"
 #include "libbde_key_protector.h"
 #include "libbde_password.h"
+#include "libbde_password_keep.h"
 #include "libbde_recovery.h"
 #include "libbde_sector_data.h"
+#include "libbde_sector_data_pool.h"
+#include "libbde_sectors_cache.h"
 #include "libbde_volume.h"
 
 #include "bde_metadata.h"
@@ -53,6 +79,7 @@ int libbde_volume_initialize(
 {
 	libbde_internal_volume_t *internal_volume = NULL;
 	static char *function                     = "libbde_volume_initialize";
+	int result                                = 0;
 
 	if( volume == NULL )
 	{
@@ -147,8 +174,39 @@ int libbde_volume_initialize(
 
 		goto on_error;
 	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_volume->shared_read_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize shared read mutex.",
+		 function );
+
+		goto on_error;
+	}
 #endif
-	internal_volume->is_locked = 1;
+	result = libbde_key_memo_register_user(
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to register key memo user.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->password_keep->use_key_memo = (uint8_t) result;
+
+	internal_volume->cache_size      = LIBBDE_DEFAULT_CACHE_SIZE;
+	internal_volume->readahead_depth = LIBBDE_DEFAULT_READAHEAD_DEPTH;
+	internal_volume->is_locked       = 1;
 
 	*volume = (libbde_volume_t *) internal_volume;
 
@@ -157,6 +215,20 @@ int libbde_volume_initialize(
 on_error:
 	if( internal_volume != NULL )
 	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( internal_volume->shared_read_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( internal_volume->shared_read_mutex ),
+			 NULL );
+		}
+		if( internal_volume->read_write_lock != NULL )
+		{
+			libcthreads_read_write_lock_free(
+			 &( internal_volume->read_write_lock ),
+			 NULL );
+		}
+#endif
 		if( internal_volume->password_keep != NULL )
 		{
 			libbde_password_keep_free(
@@ -220,6 +292,32 @@ int libbde_volume_free(
 		*volume = NULL;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libbde_internal_volume_stop_readahead(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop readahead.",
+			 function );
+
+			result = -1;
+		}
+		if( libbde_internal_volume_stop_decryption_threads(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop decryption threads.",
+			 function );
+
+			result = -1;
+		}
 		if( libcthreads_read_write_lock_free(
 		     &( internal_volume->read_write_lock ),
 		     error ) != 1 )
@@ -233,6 +331,32 @@ int libbde_volume_free(
 
 			result = -1;
 		}
+		if( libbde_internal_volume_free_encryption_contexts(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption contexts.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( internal_volume->shared_read_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free shared read mutex.",
+			 function );
+
+			result = -1;
+		}
 #endif
 		if( libbde_io_handle_free(
 		     &( internal_volume->io_handle ),
@@ -247,6 +371,21 @@ int libbde_volume_free(
 
 			result = -1;
 		}
+		if( internal_volume->password_keep->use_key_memo != 0 )
+		{
+			if( libbde_key_memo_unregister_user(
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to unregister key memo user.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libbde_password_keep_free(
 		     &( internal_volume->password_keep ),
 		     error ) != 1 )
@@ -306,6 +445,9 @@ int libbde_volume_signal_abort(
 }
 
 /* Opens a volume
+ * If LIBBDE_ACCESS_FLAG_MEMORY_MAP is set and supported the file is mapped into memory
+ * If LIBBDE_ACCESS_FLAG_LAZY_METADATA is set the secondary and tertiary metadata
+ * are only read when the primary metadata is corrupted or does not provide the keys
  * Returns 1 if successful, 0 if the keys could not be read or -1 on error
  */
 int libbde_volume_open(
@@ -478,7 +620,47 @@ int libbde_volume_open(
 #endif
 		internal_volume->file_io_handle_created_in_library = 1;
 
+		if( ( access_flags & LIBBDE_ACCESS_FLAG_MEMORY_MAP ) != 0 )
+		{
+			if( libbde_internal_volume_map_file(
+			     internal_volume,
+			     filename,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to map file: %s into memory.",
+				 function,
+				 filename );
+
+				result = -1;
+			}
+		}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		/* The readahead reads through io_uring if available,
+		 * a memory mapped file is decrypted directly instead
+		 */
+		if( ( result == 1 )
+		 && ( internal_volume->memory_mapped_data == NULL ) )
+		{
+			if( libbde_io_uring_initialize(
+			     &( internal_volume->io_uring ),
+			     filename,
+			     LIBBDE_IO_URING_QUEUE_DEPTH,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create io_uring.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libcthreads_read_write_lock_release_for_write(
 		     internal_volume->read_write_lock,
 		     error ) != 1 )
@@ -825,6 +1007,7 @@ int libbde_volume_open_file_io_handle(
 	result = libbde_volume_open_read(
 	          internal_volume,
 	          file_io_handle,
+	          access_flags,
 	          error );
 
 	if( result == -1 )
@@ -907,16 +1090,32 @@ on_error:
 	return( -1 );
 }
 
-/* Closes a volume
- * Returns 0 if successful or -1 on error
+/* Opens a volume using a Basic File IO (bfio) pool
+ * Every entry of the pool must be a file IO handle of the same volume
+ * The first entry is used to read the volume, the other entries allow
+ * libbde_volume_pread_buffer to read from multiple threads in parallel
+ * Returns 1 if successful, 0 if the keys could not be read or -1 on error
  */
-int libbde_volume_close(
+int libbde_volume_open_file_io_pool(
      libbde_volume_t *volume,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_close";
-	int result                                = 0;
+	libbde_internal_volume_t *internal_volume         = NULL;
+	libbfio_handle_t *file_io_handle                  = NULL;
+	uint8_t *file_io_pool_entries_opened_in_library   = NULL;
+	static char *function                             = "libbde_volume_open_file_io_pool";
+	int bfio_access_flags                             = 0;
+	int file_io_handle_is_open                        = 0;
+	int file_io_pool_entry                            = 0;
+	int number_of_file_io_pool_entries                = 0;
+	int result                                        = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int *free_file_io_pool_entries                    = NULL;
+	int free_file_io_pool_entry_index                 = 0;
+#endif
 
 	if( volume == NULL )
 	{
@@ -931,210 +1130,454 @@ int libbde_volume_close(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( ( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
-		if( internal_volume->file_io_handle_created_in_library != 0 )
-		{
-			if( libbde_debug_print_read_offsets(
-			     internal_volume->file_io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
-				 "%s: unable to print the read offsets.",
-				 function );
-			}
-		}
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( internal_volume->file_io_handle_opened_in_library != 0 )
+	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
 	{
-		if( libbfio_handle_close(
-		     internal_volume->file_io_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file IO handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
+		 function );
 
-			result = -1;
-		}
-		internal_volume->file_io_handle_opened_in_library = 0;
+		return( -1 );
 	}
-	if( internal_volume->file_io_handle_created_in_library != 0 )
+	if( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) != 0 )
 	{
-		if( libbfio_handle_free(
-		     &( internal_volume->file_io_handle ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free file IO handle.",
-			 function );
-
-			result = -1;
-		}
-		internal_volume->file_io_handle_created_in_library = 0;
+		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 	}
-	internal_volume->file_io_handle = NULL;
-	internal_volume->current_offset = 0;
-	internal_volume->is_locked      = 1;
-
-	if( libbde_io_handle_clear(
-	     internal_volume->io_handle,
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_pool_entries,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of file IO pool entries.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libfdata_vector_free(
-	     &( internal_volume->sectors_vector ),
-	     error ) != 1 )
+	if( number_of_file_io_pool_entries < 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors vector.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file IO pool - missing file IO handles.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( libfcache_cache_free(
-	     &( internal_volume->sectors_cache ),
-	     error ) != 1 )
+	file_io_pool_entries_opened_in_library = (uint8_t *) memory_allocate(
+	                                                      sizeof( uint8_t ) * number_of_file_io_pool_entries );
+
+	if( file_io_pool_entries_opened_in_library == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors cache.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create file IO pool entries opened in library.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( internal_volume->primary_metadata != NULL )
+	if( memory_set(
+	     file_io_pool_entries_opened_in_library,
+	     0,
+	     sizeof( uint8_t ) * number_of_file_io_pool_entries ) == NULL )
 	{
-		if( libbde_metadata_free(
-		     &( internal_volume->primary_metadata ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free primary metadata.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file IO pool entries opened in library.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_volume->secondary_metadata != NULL )
+	/* The file IO handles are read directly since the file IO pool
+	 * cannot be used by multiple threads in parallel, hence they are kept open
+	 */
+	for( file_io_pool_entry = 0;
+	     file_io_pool_entry < number_of_file_io_pool_entries;
+	     file_io_pool_entry++ )
 	{
-		if( libbde_metadata_free(
-		     &( internal_volume->secondary_metadata ),
+		if( libbfio_pool_get_handle(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     &file_io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free secondary metadata.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file IO handle: %d from pool.",
+			 function,
+			 file_io_pool_entry );
 
-			result = -1;
+			goto on_error;
+		}
+		file_io_handle_is_open = libbfio_handle_is_open(
+		                          file_io_handle,
+		                          error );
+
+		if( file_io_handle_is_open == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to determine if file IO handle: %d is open.",
+			 function,
+			 file_io_pool_entry );
+
+			goto on_error;
+		}
+		else if( file_io_handle_is_open == 0 )
+		{
+			if( libbfio_handle_open(
+			     file_io_handle,
+			     bfio_access_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open file IO handle: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			file_io_pool_entries_opened_in_library[ file_io_pool_entry ] = 1;
 		}
 	}
-	if( internal_volume->tertiary_metadata != NULL )
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     0,
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		if( libbde_metadata_free(
-		     &( internal_volume->tertiary_metadata ),
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: 0 from pool.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbde_volume_open_read(
+	          internal_volume,
+	          file_io_handle,
+	          access_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read from file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_pool_entries;
+		     file_io_pool_entry++ )
+		{
+			if( file_io_pool_entries_opened_in_library[ file_io_pool_entry ] == 0 )
+			{
+				continue;
+			}
+			file_io_pool_entries_opened_in_library[ file_io_pool_entry ] = 0;
+
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			if( libbfio_handle_close(
+			     file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+		}
+		memory_free(
+		 file_io_pool_entries_opened_in_library );
+
+		file_io_pool_entries_opened_in_library = NULL;
+	}
+	else
+	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		/* The first entry is the shared file IO handle and is never handed out
+		 */
+		if( number_of_file_io_pool_entries > 1 )
+		{
+			free_file_io_pool_entries = (int *) memory_allocate(
+			                                     sizeof( int ) * ( number_of_file_io_pool_entries - 1 ) );
+
+			if( free_file_io_pool_entries == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create free file IO pool entries.",
+				 function );
+
+				goto on_error;
+			}
+			for( free_file_io_pool_entry_index = 0;
+			     free_file_io_pool_entry_index < ( number_of_file_io_pool_entries - 1 );
+			     free_file_io_pool_entry_index++ )
+			{
+				free_file_io_pool_entries[ free_file_io_pool_entry_index ] = number_of_file_io_pool_entries - 1 - free_file_io_pool_entry_index;
+			}
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free tertiary metadata.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
 			 function );
 
-			result = -1;
+			goto on_error;
+		}
+		internal_volume->free_file_io_pool_entries           = free_file_io_pool_entries;
+		internal_volume->number_of_free_file_io_pool_entries = number_of_file_io_pool_entries - 1;
+#endif
+		internal_volume->file_io_handle                         = file_io_handle;
+		internal_volume->file_io_handle_opened_in_library       = 0;
+		internal_volume->file_io_pool                           = file_io_pool;
+		internal_volume->number_of_file_io_pool_entries         = number_of_file_io_pool_entries;
+		internal_volume->file_io_pool_entries_opened_in_library = file_io_pool_entries_opened_in_library;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
 		}
+#endif
 	}
+	return( result );
+
+on_error:
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( free_file_io_pool_entries != NULL )
+	{
+		memory_free(
+		 free_file_io_pool_entries );
+	}
+#endif
+	if( file_io_pool_entries_opened_in_library != NULL )
+	{
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < number_of_file_io_pool_entries;
+		     file_io_pool_entry++ )
+		{
+			if( file_io_pool_entries_opened_in_library[ file_io_pool_entry ] == 0 )
+			{
+				continue;
+			}
+			if( libbfio_pool_get_handle(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     NULL ) == 1 )
+			{
+				libbfio_handle_close(
+				 file_io_handle,
+				 NULL );
+			}
+		}
+		memory_free(
+		 file_io_pool_entries_opened_in_library );
+	}
+	return( -1 );
+}
+
+/* Closes the file IO handles of the file IO pool that were opened inside the library
+ * and releases the file IO pool
+ * Returns 0 if successful or -1 on error
+ */
+int libbde_internal_volume_close_file_io_pool(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_internal_volume_close_file_io_pool";
+	int file_io_pool_entry           = 0;
+	int result                       = 0;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
+	if( internal_volume->file_io_pool_entries_opened_in_library != NULL )
+	{
+		for( file_io_pool_entry = 0;
+		     file_io_pool_entry < internal_volume->number_of_file_io_pool_entries;
+		     file_io_pool_entry++ )
+		{
+			if( internal_volume->file_io_pool_entries_opened_in_library[ file_io_pool_entry ] == 0 )
+			{
+				continue;
+			}
+			if( libbfio_pool_get_handle(
+			     internal_volume->file_io_pool,
+			     file_io_pool_entry,
+			     &file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve file IO handle: %d from pool.",
+				 function,
+				 file_io_pool_entry );
+
+				result = -1;
+			}
+			else if( libbfio_handle_close(
+			          file_io_handle,
+			          error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close file IO handle: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_volume->file_io_pool_entries_opened_in_library );
+
+		internal_volume->file_io_pool_entries_opened_in_library = NULL;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->free_file_io_pool_entries != NULL )
+	{
+		memory_free(
+		 internal_volume->free_file_io_pool_entries );
+
+		internal_volume->free_file_io_pool_entries = NULL;
+	}
+	internal_volume->number_of_free_file_io_pool_entries = 0;
 #endif
+	internal_volume->file_io_pool                   = NULL;
+	internal_volume->number_of_file_io_pool_entries = 0;
+
 	return( result );
 }
 
-/* Opens a volume for reading
+/* Opens a volume that is stored in memory
+ * The buffer is owned by the caller and must remain valid until the volume is closed
+ * Sectors are decrypted directly from the buffer
  * Returns 1 if successful, 0 if the keys could not be read or -1 on error
  */
-int libbde_volume_open_read(
-     libbde_internal_volume_t *internal_volume,
-     libbfio_handle_t *file_io_handle,
+int libbde_volume_open_memory(
+     libbde_volume_t *volume,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     int access_flags,
      libcerror_error_t **error )
 {
-	uint8_t *startup_key_identifier    = NULL;
-	static char *function              = "libbde_volume_open_read";
-	size64_t file_size                 = 0;
-	size_t startup_key_identifier_size = 0;
-	int element_index                  = 0;
-	int result                         = 0;
+	libbfio_handle_t *file_io_handle          = NULL;
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_open_memory";
+	int result                                = 0;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1145,6 +1588,8 @@ int libbde_volume_open_read(
 
 		return( -1 );
 	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
 	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -1156,382 +1601,593 @@ int libbde_volume_open_read(
 
 		return( -1 );
 	}
-	if( internal_volume->primary_metadata != NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->secondary_metadata != NULL )
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - secondary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->tertiary_metadata != NULL )
+	if( ( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - tertiary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - sectors vector already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: write access currently not supported.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache != NULL )
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - sectors cache already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     (uint8_t *) buffer,
+	     buffer_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to set memory range in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libbde_metadata_initialize(
-	     &( internal_volume->primary_metadata ),
-	     error ) != 1 )
+	result = libbde_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          access_flags,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open volume from memory.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbde_metadata_initialize(
-	     &( internal_volume->secondary_metadata ),
-	     error ) != 1 )
+	else if( result == 0 )
+	{
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		internal_volume->file_io_handle_created_in_library = 1;
+		internal_volume->io_handle->mapped_data            = buffer;
+		internal_volume->io_handle->mapped_data_size       = (size64_t) buffer_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Maps the volume file into memory, so that sectors are decrypted directly from the mapping
+ * Returns 1 if successful, 0 if the file cannot be mapped or -1 on error
+ */
+int libbde_internal_volume_map_file(
+     libbde_internal_volume_t *internal_volume,
+     const char *filename,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_MEMORY_MAP_SUPPORT )
+	struct stat file_statistics;
+
+	void *mapped_data     = NULL;
+	int file_descriptor   = -1;
+#endif
+	static char *function = "libbde_internal_volume_map_file";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create secondary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libbde_metadata_initialize(
-	     &( internal_volume->tertiary_metadata ),
-	     error ) != 1 )
+	if( internal_volume->memory_mapped_data != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create tertiary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - memory mapped data value already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( internal_volume->external_key_metadata != NULL )
-	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL ) )
+	if( filename == NULL )
 	{
-		startup_key_identifier      = internal_volume->external_key_metadata->startup_key_external_key->identifier;
-		startup_key_identifier_size = 16;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+#if defined( HAVE_LIBBDE_MEMORY_MAP_SUPPORT )
+	file_descriptor = open(
+	                   filename,
+	                   O_RDONLY );
+
+	if( file_descriptor == -1 )
 	{
-		libcnotify_printf(
-		 "Reading BitLocker volume header:\n" );
+		return( 0 );
 	}
+	/* Only regular files are mapped, since the size of a device
+	 * cannot be determined with fstat
+	 */
+	if( ( fstat(
+	       file_descriptor,
+	       &file_statistics ) == 0 )
+	 && ( S_ISREG( file_statistics.st_mode ) )
+	 && ( file_statistics.st_size > 0 )
+	 && ( (uint64_t) file_statistics.st_size <= (uint64_t) SSIZE_MAX ) )
+	{
+		mapped_data = mmap(
+		               NULL,
+		               (size_t) file_statistics.st_size,
+		               PROT_READ,
+		               MAP_SHARED,
+		               file_descriptor,
+		               0 );
+	}
+	/* The mapping remains valid after the file descriptor is closed
+	 */
+	close(
+	 file_descriptor );
+
+	if( ( mapped_data == NULL )
+	 || ( mapped_data == MAP_FAILED ) )
+	{
+		return( 0 );
+	}
+	internal_volume->memory_mapped_data          = (uint8_t *) mapped_data;
+	internal_volume->memory_mapped_data_size     = (size_t) file_statistics.st_size;
+	internal_volume->io_handle->mapped_data      = internal_volume->memory_mapped_data;
+	internal_volume->io_handle->mapped_data_size = (size64_t) internal_volume->memory_mapped_data_size;
+
+	return( 1 );
+#else
+	return( 0 );
 #endif
-	if( libbde_io_handle_read_volume_header(
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     0,
-	     error ) != 1 )
+}
+
+/* Unmaps the volume file mapped by libbde_internal_volume_map_file
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_unmap_file(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_unmap_file";
+	int result            = 1;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read volume header.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	if( internal_volume->memory_mapped_data == NULL )
 	{
-		libcnotify_printf(
-		 "Reading BitLocker primary metadata block:\n" );
+		return( 1 );
 	}
-#endif
-	if( libbde_metadata_read_block(
-	     internal_volume->primary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->first_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
-	     error ) != 1 )
+	if( internal_volume->io_handle != NULL )
+	{
+		internal_volume->io_handle->mapped_data      = NULL;
+		internal_volume->io_handle->mapped_data_size = 0;
+	}
+#if defined( HAVE_LIBBDE_MEMORY_MAP_SUPPORT )
+	if( munmap(
+	     internal_volume->memory_mapped_data,
+	     internal_volume->memory_mapped_data_size ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary metadata block.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to unmap memory mapped data.",
 		 function );
 
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading BitLocker secondary metadata block:\n" );
+		result = -1;
 	}
 #endif
-	if( libbde_metadata_read_block(
-	     internal_volume->secondary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->second_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
-	     error ) != 1 )
+	internal_volume->memory_mapped_data      = NULL;
+	internal_volume->memory_mapped_data_size = 0;
+
+	return( result );
+}
+
+/* Closes a volume
+ * Returns 0 if successful or -1 on error
+ */
+int libbde_volume_close(
+     libbde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_close";
+	int result                                = 0;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read secondary metadata block.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
 	{
-		libcnotify_printf(
-		 "Reading BitLocker tertiary metadata block:\n" );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
 	}
-#endif
-	if( libbde_metadata_read_block(
-	     internal_volume->tertiary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->third_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_internal_volume_stop_readahead(
+	     internal_volume,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read tertiary metadata block.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop readahead.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	result = libbde_volume_open_read_keys_from_metadata(
-	          internal_volume,
-	          internal_volume->primary_metadata,
-	          error );
-
-	if( result == -1 )
+	if( libbde_internal_volume_stop_decryption_threads(
+	     internal_volume,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read keys from primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop decryption threads.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( result == 0 )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		result = libbde_volume_open_read_keys_from_metadata(
-			  internal_volume,
-			  internal_volume->secondary_metadata,
-			  error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
 
-		if( result == -1 )
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		if( internal_volume->file_io_handle_created_in_library != 0 )
+		{
+			if( libbde_debug_print_read_offsets(
+			     internal_volume->file_io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+				 "%s: unable to print the read offsets.",
+				 function );
+			}
+		}
+	}
+#endif
+	if( internal_volume->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_volume->file_io_handle,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read keys from secondary metadata.",
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
+		internal_volume->file_io_handle_opened_in_library = 0;
 	}
-	if( result == 0 )
+	if( internal_volume->file_io_handle_created_in_library != 0 )
 	{
-		result = libbde_volume_open_read_keys_from_metadata(
-			  internal_volume,
-			  internal_volume->tertiary_metadata,
-			  error );
-
-		if( result == -1 )
+		if( libbfio_handle_free(
+		     &( internal_volume->file_io_handle ),
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read keys from tertiary metadata.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
+		internal_volume->file_io_handle_created_in_library = 0;
 	}
-	if( result != 0 )
+	if( internal_volume->file_io_pool != NULL )
 	{
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "Reading unencrypted volume header:\n" );
-		}
-#endif
-		if( libbde_io_handle_read_unencrypted_volume_header(
-		     internal_volume->io_handle,
-		     file_io_handle,
-		     error ) != 1 )
+		if( libbde_internal_volume_close_file_io_pool(
+		     internal_volume,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read unencrypted volume header.",
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO pool.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: volume size\t\t\t\t\t: %" PRIu64 "\n",
-			 function,
-			 internal_volume->io_handle->volume_size );
+	}
+	internal_volume->file_io_handle             = NULL;
+	internal_volume->current_offset             = 0;
+	internal_volume->last_read_end_offset       = 0;
+	internal_volume->number_of_sequential_reads = 0;
+	internal_volume->is_locked                  = 1;
 
-			libcnotify_printf(
-			 "\n" );
-		}
+	if( libbde_internal_volume_unmap_file(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to unmap file.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libbde_io_uring_free(
+	     &( internal_volume->io_uring ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free io_uring.",
+		 function );
+
+		result = -1;
+	}
 #endif
-		if( libbfio_handle_get_size(
-		     file_io_handle,
-		     &file_size,
-		     error ) == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve file size.",
-			 function );
+	if( libbde_internal_volume_free_encryption_contexts(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free encryption contexts.",
+		 function );
 
-			goto on_error;
-		}
-		/* Correct a volume size that is 1 sector short
-		 */
-		if( ( internal_volume->io_handle->encrypted_volume_size == ( internal_volume->io_handle->volume_size + internal_volume->io_handle->bytes_per_sector ) )
-		 && ( ( internal_volume->io_handle->volume_size + internal_volume->io_handle->bytes_per_sector ) <= file_size ) )
-		{
-			internal_volume->io_handle->volume_size += internal_volume->io_handle->bytes_per_sector;
-		}
-/* TODO clone function ? */
-		if( libfdata_vector_initialize(
-		     &( internal_volume->sectors_vector ),
-		     (size64_t) internal_volume->io_handle->bytes_per_sector,
-		     (intptr_t *) internal_volume->io_handle,
-		     NULL,
-		     NULL,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libbde_io_handle_read_sector,
-		     NULL,
-		     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
+		result = -1;
+	}
+	if( libbde_io_handle_clear(
+	     internal_volume->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( libbde_internal_volume_free_sectors_cache(
+	     internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sectors cache.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_volume->sectors_run_data != NULL )
+	{
+		memory_free(
+		 internal_volume->sectors_run_data );
+
+		internal_volume->sectors_run_data = NULL;
+	}
+	if( internal_volume->primary_metadata != NULL )
+	{
+		if( libbde_metadata_free(
+		     &( internal_volume->primary_metadata ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors vector.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free primary metadata.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfdata_vector_append_segment(
-		     internal_volume->sectors_vector,
-		     &element_index,
-		     0,
-		     0,
-		     internal_volume->io_handle->volume_size,
-		     0,
+	}
+	if( internal_volume->secondary_metadata != NULL )
+	{
+		if( libbde_metadata_free(
+		     &( internal_volume->secondary_metadata ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append segment to sectors vector.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free secondary metadata.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		if( libfcache_cache_initialize(
-		     &( internal_volume->sectors_cache ),
-		     LIBBDE_MAXIMUM_CACHE_ENTRIES_SECTORS,
+	}
+	if( internal_volume->tertiary_metadata != NULL )
+	{
+		if( libbde_metadata_free(
+		     &( internal_volume->tertiary_metadata ),
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors cache.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free tertiary metadata.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
-		internal_volume->is_locked = 0;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1549,66 +2205,27 @@ int libbde_volume_open_read(
 	}
 #endif
 	return( result );
-
-on_error:
-	if( internal_volume->sectors_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &( internal_volume->sectors_cache ),
-		 NULL );
-	}
-	if( internal_volume->sectors_vector != NULL )
-	{
-		libfdata_vector_free(
-		 &( internal_volume->sectors_vector ),
-		 NULL );
-	}
-	if( internal_volume->tertiary_metadata != NULL )
-	{
-		libbde_metadata_free(
-		 &( internal_volume->tertiary_metadata ),
-		 NULL );
-	}
-	if( internal_volume->secondary_metadata != NULL )
-	{
-		libbde_metadata_free(
-		 &( internal_volume->secondary_metadata ),
-		 NULL );
-	}
-	if( internal_volume->primary_metadata != NULL )
-	{
-		libbde_metadata_free(
-		 &( internal_volume->primary_metadata ),
-		 NULL );
-	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
 }
 
-/* Reads the keys from the metadata when opening the volume for reading
- * Returns 1 if successful, 0 if not or -1 on error
+/* Opens a volume for reading
+ * If LIBBDE_ACCESS_FLAG_LAZY_METADATA is set the secondary and tertiary metadata
+ * are only read when needed
+ * Returns 1 if successful, 0 if the keys could not be read or -1 on error
  */
-int libbde_volume_open_read_keys_from_metadata(
+int libbde_volume_open_read(
      libbde_internal_volume_t *internal_volume,
-     libbde_metadata_t *metadata,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
      libcerror_error_t **error )
 {
-	uint8_t full_volume_encryption_key[ 64 ];
-	uint8_t tweak_key[ 32 ];
-	uint8_t volume_master_key[ 32 ];
+	libbde_metadata_t **metadata[ 3 ];
+	off64_t metadata_offsets[ 3 ];
 
-	uint8_t *external_key          = NULL;
-	static char *function          = "libbde_volume_open_read_keys_from_metadata";
-	off64_t volume_header_offset   = 0;
-	size64_t volume_header_size    = 0;
-	size64_t encrypted_volume_size = 0;
-	size_t external_key_size       = 0;
-	uint16_t encryption_method     = 0;
-	int result                     = 0;
+	static char *function  = "libbde_volume_open_read";
+	size64_t file_size     = 0;
+	int metadata_index     = 0;
+	int number_of_metadata = 0;
+	int result             = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -1632,258 +2249,5545 @@ int libbde_volume_open_read_keys_from_metadata(
 
 		return( -1 );
 	}
-	if( metadata == NULL )
+	if( internal_volume->primary_metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - primary metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->secondary_metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - secondary metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->tertiary_metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - tertiary metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid file - sectors cache already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading BitLocker volume header:\n" );
+	}
+#endif
+	/* A memory mapped or in-memory volume is parsed in-place
+	 */
+	if( ( internal_volume->io_handle->mapped_data != NULL )
+	 && ( internal_volume->io_handle->mapped_data_size >= 512 ) )
+	{
+		result = libbde_io_handle_read_volume_header_data(
+		          internal_volume->io_handle,
+		          internal_volume->io_handle->mapped_data,
+		          512,
+		          error );
+	}
+	else
+	{
+		result = libbde_io_handle_read_volume_header(
+		          internal_volume->io_handle,
+		          file_io_handle,
+		          0,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
+		 function );
+
+		goto on_error;
+	}
+	metadata[ 0 ]         = &( internal_volume->primary_metadata );
+	metadata[ 1 ]         = &( internal_volume->secondary_metadata );
+	metadata[ 2 ]         = &( internal_volume->tertiary_metadata );
+	metadata_offsets[ 0 ] = internal_volume->io_handle->first_metadata_offset;
+	metadata_offsets[ 1 ] = internal_volume->io_handle->second_metadata_offset;
+	metadata_offsets[ 2 ] = internal_volume->io_handle->third_metadata_offset;
+
+	/* Without lazy metadata all metadata blocks are read and must be valid,
+	 * which checks the consistency of the metadata. With lazy metadata only
+	 * the primary metadata block is read, the secondary and tertiary metadata
+	 * blocks are read when a previous block is corrupted or does not provide
+	 * the keys
+	 */
+	if( ( access_flags & LIBBDE_ACCESS_FLAG_LAZY_METADATA ) == 0 )
+	{
+		for( metadata_index = 0;
+		     metadata_index < 3;
+		     metadata_index++ )
+		{
+			if( libbde_volume_open_read_metadata(
+			     internal_volume,
+			     file_io_handle,
+			     metadata_offsets[ metadata_index ],
+			     metadata[ metadata_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read metadata block: %d.",
+				 function,
+				 metadata_index );
+
+				goto on_error;
+			}
+		}
+	}
+	result = 0;
+
+	for( metadata_index = 0;
+	     metadata_index < 3;
+	     metadata_index++ )
+	{
+		if( *( metadata[ metadata_index ] ) == NULL )
+		{
+			if( libbde_volume_open_read_metadata(
+			     internal_volume,
+			     file_io_handle,
+			     metadata_offsets[ metadata_index ],
+			     metadata[ metadata_index ],
+			     error ) != 1 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( ( libcnotify_verbose != 0 )
+				 && ( error != NULL ) )
+				{
+					libcnotify_print_error_backtrace(
+					 *error );
+				}
+#endif
+				libcerror_error_free(
+				 error );
+
+				continue;
+			}
+		}
+		number_of_metadata += 1;
+
+		/* The stretched keys of metadata that was read before are not calculated again
+		 */
+		if( libbde_internal_volume_calculate_stretched_keys(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate stretched keys.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbde_volume_open_read_keys_from_metadata(
+		          internal_volume,
+		          *( metadata[ metadata_index ] ),
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read keys from metadata: %d.",
+			 function,
+			 metadata_index );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+	}
+	if( number_of_metadata == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata block.",
+		 function );
+
+		goto on_error;
+	}
+	if( result != 0 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "Reading unencrypted volume header:\n" );
+		}
+#endif
+		if( libbde_io_handle_read_unencrypted_volume_header(
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read unencrypted volume header.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: volume size\t\t\t\t\t: %" PRIu64 "\n",
+			 function,
+			 internal_volume->io_handle->volume_size );
+
+			libcnotify_printf(
+			 "\n" );
+		}
+#endif
+		if( libbfio_handle_get_size(
+		     file_io_handle,
+		     &file_size,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve file size.",
+			 function );
+
+			goto on_error;
+		}
+		/* Correct a volume size that is 1 sector short
+		 */
+		if( ( internal_volume->io_handle->encrypted_volume_size == ( internal_volume->io_handle->volume_size + internal_volume->io_handle->bytes_per_sector ) )
+		 && ( ( internal_volume->io_handle->volume_size + internal_volume->io_handle->bytes_per_sector ) <= file_size ) )
+		{
+			internal_volume->io_handle->volume_size += internal_volume->io_handle->bytes_per_sector;
+		}
+		if( libbde_internal_volume_initialize_sectors_cache(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sectors cache.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->is_locked = 0;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+	libbde_internal_volume_free_sectors_cache(
+	 internal_volume,
+	 NULL );
+
+	if( internal_volume->tertiary_metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &( internal_volume->tertiary_metadata ),
+		 NULL );
+	}
+	if( internal_volume->secondary_metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &( internal_volume->secondary_metadata ),
+		 NULL );
+	}
+	if( internal_volume->primary_metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &( internal_volume->primary_metadata ),
+		 NULL );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads a metadata block when opening the volume for reading
+ * The metadata block is read in-place from memory mapped or in-memory data if available
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_open_read_metadata(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libbde_metadata_t **metadata,
+     libcerror_error_t **error )
+{
+	uint8_t *startup_key_identifier    = NULL;
+	static char *function              = "libbde_volume_open_read_metadata";
+	size_t startup_key_identifier_size = 0;
+	int result                         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( *metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid metadata value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->external_key_metadata != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL ) )
+	{
+		startup_key_identifier      = internal_volume->external_key_metadata->startup_key_external_key->identifier;
+		startup_key_identifier_size = 16;
+	}
+	if( libbde_metadata_initialize(
+	     metadata,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create metadata.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading BitLocker metadata block at offset: %" PRIi64 " (0x%08" PRIx64 "):\n",
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	/* The metadata area bounds the size of the metadata block
+	 */
+	if( ( internal_volume->io_handle->mapped_data != NULL )
+	 && ( file_offset >= 0 )
+	 && ( (size64_t) file_offset <= internal_volume->io_handle->mapped_data_size )
+	 && ( internal_volume->io_handle->metadata_size <= ( internal_volume->io_handle->mapped_data_size - (size64_t) file_offset ) ) )
+	{
+		result = libbde_metadata_read_block_data(
+		          *metadata,
+		          internal_volume->io_handle,
+		          &( internal_volume->io_handle->mapped_data[ file_offset ] ),
+		          (size_t) internal_volume->io_handle->metadata_size,
+		          startup_key_identifier,
+		          startup_key_identifier_size,
+		          error );
+	}
+	else
+	{
+		result = libbde_metadata_read_block(
+		          *metadata,
+		          internal_volume->io_handle,
+		          file_io_handle,
+		          file_offset,
+		          startup_key_identifier,
+		          startup_key_identifier_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *metadata != NULL )
+	{
+		libbde_metadata_free(
+		 metadata,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Creates the sectors cache based on the cache size
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_initialize_sectors_cache(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function             = "libbde_internal_volume_initialize_sectors_cache";
+	size64_t maximum_number_of_entries = 0;
+	size_t block_size                  = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - sectors cache already set.",
+		 function );
+
+		return( -1 );
+	}
+	block_size = internal_volume->cache_block_size;
+
+	if( block_size == 0 )
+	{
+		block_size = (size_t) internal_volume->io_handle->sectors_per_cluster_block
+		           * internal_volume->io_handle->bytes_per_sector;
+
+		if( block_size < (size_t) LIBBDE_MINIMUM_CACHE_BLOCK_SIZE )
+		{
+			block_size = (size_t) LIBBDE_MINIMUM_CACHE_BLOCK_SIZE;
+		}
+		else if( block_size > (size_t) LIBBDE_MAXIMUM_CACHE_BLOCK_SIZE )
+		{
+			block_size = (size_t) LIBBDE_MAXIMUM_CACHE_BLOCK_SIZE;
+		}
+	}
+	/* The block size must be a multiple of the sector size
+	 */
+	if( block_size < (size_t) internal_volume->io_handle->bytes_per_sector )
+	{
+		block_size = (size_t) internal_volume->io_handle->bytes_per_sector;
+	}
+	else
+	{
+		block_size -= block_size % internal_volume->io_handle->bytes_per_sector;
+	}
+	if( internal_volume->sector_data_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - sector data pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	maximum_number_of_entries = internal_volume->cache_size / block_size;
+
+	if( maximum_number_of_entries == 0 )
+	{
+		maximum_number_of_entries = 1;
+	}
+	else if( maximum_number_of_entries > (size64_t) LIBBDE_MAXIMUM_CACHE_ENTRIES_SECTORS )
+	{
+		maximum_number_of_entries = (size64_t) LIBBDE_MAXIMUM_CACHE_ENTRIES_SECTORS;
+	}
+	if( libbde_sectors_cache_initialize(
+	     &( internal_volume->sectors_cache ),
+	     (int) maximum_number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sector_data_pool_initialize(
+	     &( internal_volume->sector_data_pool ),
+	     block_size,
+	     LIBBDE_MAXIMUM_NUMBER_OF_FREE_SECTOR_DATA,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data pool.",
+		 function );
+
+		libbde_sectors_cache_free(
+		 &( internal_volume->sectors_cache ),
+		 NULL );
+
+		return( -1 );
+	}
+	internal_volume->sectors_cache_block_size = block_size;
+
+	return( 1 );
+}
+
+/* Frees the sectors cache and the sector data pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_free_sectors_cache(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_free_sectors_cache";
+	int result            = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sectors_cache_free(
+	     &( internal_volume->sectors_cache ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sectors cache.",
+		 function );
+
+		result = -1;
+	}
+	if( libbde_sector_data_pool_free(
+	     &( internal_volume->sector_data_pool ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free sector data pool.",
+		 function );
+
+		result = -1;
+	}
+	internal_volume->sectors_cache_block_size = 0;
+
+	return( result );
+}
+
+/* Retrieves an encryption context for a read that does not hold the read/write lock for writing
+ * The encryption context must be released with libbde_internal_volume_release_encryption_context
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_get_encryption_context(
+     libbde_internal_volume_t *internal_volume,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_get_encryption_context";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	if( *encryption_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid encryption context value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->io_handle->encryption_context == NULL )
+	{
+		return( 1 );
+	}
+	/* The AES contexts hold key schedules and cipher state that cannot be
+	 * shared by concurrent readers, hence every reader uses its own clone
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared read mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->number_of_free_encryption_contexts > 0 )
+	{
+		internal_volume->number_of_free_encryption_contexts -= 1;
+
+		*encryption_context = internal_volume->free_encryption_contexts[ internal_volume->number_of_free_encryption_contexts ];
+
+		internal_volume->free_encryption_contexts[ internal_volume->number_of_free_encryption_contexts ] = NULL;
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared read mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( *encryption_context == NULL )
+	{
+		if( libbde_encryption_clone(
+		     encryption_context,
+		     internal_volume->io_handle->encryption_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to clone encryption context.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#else
+	*encryption_context = internal_volume->io_handle->encryption_context;
+#endif
+	return( 1 );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+on_error:
+	if( *encryption_context != NULL )
+	{
+		libbde_encryption_free(
+		 encryption_context,
+		 NULL );
+	}
+	return( -1 );
+#endif
+}
+
+/* Releases an encryption context retrieved with libbde_internal_volume_get_encryption_context
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_release_encryption_context(
+     libbde_internal_volume_t *internal_volume,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_release_encryption_context";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int result            = 1;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( *encryption_context == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared read mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->number_of_free_encryption_contexts < LIBBDE_MAXIMUM_NUMBER_OF_FREE_ENCRYPTION_CONTEXTS )
+	{
+		internal_volume->free_encryption_contexts[ internal_volume->number_of_free_encryption_contexts ] = *encryption_context;
+
+		internal_volume->number_of_free_encryption_contexts += 1;
+
+		*encryption_context = NULL;
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared read mutex.",
+		 function );
+
+		result = -1;
+	}
+	if( *encryption_context != NULL )
+	{
+		if( libbde_encryption_free(
+		     encryption_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+#else
+	*encryption_context = NULL;
+
+	return( 1 );
+#endif
+}
+
+/* Frees the encryption contexts that are kept for reuse
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_free_encryption_contexts(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_free_encryption_contexts";
+	int result            = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	while( internal_volume->number_of_free_encryption_contexts > 0 )
+	{
+		internal_volume->number_of_free_encryption_contexts -= 1;
+
+		if( libbde_encryption_free(
+		     &( internal_volume->free_encryption_contexts[ internal_volume->number_of_free_encryption_contexts ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context: %d.",
+			 function,
+			 internal_volume->number_of_free_encryption_contexts );
+
+			result = -1;
+		}
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a file IO pool entry for a read that does not hold the read/write lock for writing
+ * The file IO handle of the entry is used exclusively until the entry is released
+ * with libbde_internal_volume_release_file_io_pool_entry
+ * Returns 1 if successful, 0 if no entry is available or -1 on error
+ */
+int libbde_internal_volume_get_file_io_pool_entry(
+     libbde_internal_volume_t *internal_volume,
+     int *file_io_pool_entry,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_get_file_io_pool_entry";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int entry             = -1;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = -1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( internal_volume->file_io_pool == NULL )
+	{
+		return( 0 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared read mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->number_of_free_file_io_pool_entries > 0 )
+	{
+		internal_volume->number_of_free_file_io_pool_entries -= 1;
+
+		entry = internal_volume->free_file_io_pool_entries[ internal_volume->number_of_free_file_io_pool_entries ];
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared read mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( entry == -1 )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_get_handle(
+	     internal_volume->file_io_pool,
+	     entry,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 entry );
+
+		goto on_error;
+	}
+	*file_io_pool_entry = entry;
+
+	return( 1 );
+
+on_error:
+	if( entry != -1 )
+	{
+		libbde_internal_volume_release_file_io_pool_entry(
+		 internal_volume,
+		 &entry,
+		 NULL );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Releases a file IO pool entry retrieved with libbde_internal_volume_get_file_io_pool_entry
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_release_file_io_pool_entry(
+     libbde_internal_volume_t *internal_volume,
+     int *file_io_pool_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_release_file_io_pool_entry";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *file_io_pool_entry == -1 )
+	{
+		return( 1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab shared read mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->free_file_io_pool_entries[ internal_volume->number_of_free_file_io_pool_entries ] = *file_io_pool_entry;
+
+	internal_volume->number_of_free_file_io_pool_entries += 1;
+
+	if( libcthreads_mutex_release(
+	     internal_volume->shared_read_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release shared read mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*file_io_pool_entry = -1;
+
+	return( 1 );
+}
+
+/* Calculates the stretched keys of the password and recovery password protectors
+ * of the primary, secondary and tertiary metadata that was read in advance
+ * Every distinct password hash and salt is stretched only once and independent
+ * stretched keys are calculated concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_calculate_stretched_keys(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	const uint8_t *external_key = NULL;
+	static char *function       = "libbde_internal_volume_calculate_stretched_keys";
+	size_t external_key_size    = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing password keep.",
+		 function );
+
+		return( -1 );
+	}
+	/* The key protectors are only needed when the external provided
+	 * volume master key does not match
+	 */
+	if( internal_volume->io_handle->volume_master_key_is_set != 0 )
+	{
+		return( 1 );
+	}
+	if( ( internal_volume->external_key_metadata != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key->key != NULL ) )
+	{
+		external_key      = internal_volume->external_key_metadata->startup_key_external_key->key->data;
+		external_key_size = internal_volume->external_key_metadata->startup_key_external_key->key->data_size;
+	}
+	if( internal_volume->primary_metadata != NULL )
+	{
+		if( libbde_metadata_append_stretched_keys(
+		     internal_volume->primary_metadata,
+		     internal_volume->password_keep,
+		     external_key,
+		     external_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append stretched keys of primary metadata.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->secondary_metadata != NULL )
+	{
+		if( libbde_metadata_append_stretched_keys(
+		     internal_volume->secondary_metadata,
+		     internal_volume->password_keep,
+		     external_key,
+		     external_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append stretched keys of secondary metadata.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->tertiary_metadata != NULL )
+	{
+		if( libbde_metadata_append_stretched_keys(
+		     internal_volume->tertiary_metadata,
+		     internal_volume->password_keep,
+		     external_key,
+		     external_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append stretched keys of tertiary metadata.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbde_password_keep_calculate_stretched_keys(
+	     internal_volume->password_keep,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate stretched keys.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the keys from the metadata when opening the volume for reading
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libbde_volume_open_read_keys_from_metadata(
+     libbde_internal_volume_t *internal_volume,
+     libbde_metadata_t *metadata,
+     libcerror_error_t **error )
+{
+	uint8_t full_volume_encryption_key[ 64 ];
+	uint8_t tweak_key[ 32 ];
+	uint8_t volume_master_key[ 32 ];
+
+	const uint8_t *external_key    = NULL;
+	static char *function          = "libbde_volume_open_read_keys_from_metadata";
+	off64_t volume_header_offset   = 0;
+	size64_t volume_header_size    = 0;
+	size64_t encrypted_volume_size = 0;
+	size_t external_key_size       = 0;
+	uint16_t encryption_method     = 0;
+	int result                     = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     full_volume_encryption_key,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear full volume encryption key.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     tweak_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tweak key.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     volume_master_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to volume master key.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_volume->external_key_metadata != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key->key != NULL ) )
+	{
+		external_key      = internal_volume->external_key_metadata->startup_key_external_key->key->data;
+		external_key_size = internal_volume->external_key_metadata->startup_key_external_key->key->data_size;
+	}
+	encrypted_volume_size = metadata->encrypted_volume_size;
+	volume_header_offset  = metadata->volume_header_offset;
+	volume_header_size    = metadata->volume_header_size;
+	encryption_method     = metadata->encryption_method;
+
+	/* An external provided volume master key does not require a key protector
+	 * to be unlocked, when it does not match the key protectors are tried instead
+	 */
+	if( internal_volume->io_handle->volume_master_key_is_set != 0 )
+	{
+		if( memory_copy(
+		     volume_master_key,
+		     internal_volume->io_handle->volume_master_key,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbde_metadata_read_full_volume_encryption_key(
+		          metadata,
+		          internal_volume->io_handle,
+		          volume_master_key,
+		          32,
+		          full_volume_encryption_key,
+		          64,
+		          tweak_key,
+		          32,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read full volume encryption key from metadata.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( result == 0 )
+	{
+		result = libbde_metadata_read_volume_master_key(
+		          metadata,
+		          internal_volume->io_handle,
+		          internal_volume->password_keep,
+		          external_key,
+		          external_key_size,
+		          volume_master_key,
+		          32,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read volume master key from metadata.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			result = libbde_metadata_read_full_volume_encryption_key(
+			          metadata,
+			          internal_volume->io_handle,
+			          volume_master_key,
+			          32,
+			          full_volume_encryption_key,
+			          64,
+			          tweak_key,
+			          32,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read full volume encryption key from metadata.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	if( result != 0 )
+	{
+		internal_volume->io_handle->encrypted_volume_size = encrypted_volume_size;
+		internal_volume->io_handle->volume_header_offset  = volume_header_offset;
+		internal_volume->io_handle->volume_header_size    = volume_header_size;
+
+		if( libbde_encryption_initialize(
+		     &( internal_volume->io_handle->encryption_context ),
+		     encryption_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create encryption context.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: volume master key:\n",
+			 function );
+			libcnotify_print_data(
+			 volume_master_key,
+			 32,
+			 0 );
+
+			libcnotify_printf(
+			 "%s: full volume encryption key:\n",
+			 function );
+			libcnotify_print_data(
+			 full_volume_encryption_key,
+			 64,
+			 0 );
+
+			libcnotify_printf(
+			 "%s: tweak key:\n",
+			 function );
+			libcnotify_print_data(
+			 tweak_key,
+			 32,
+			 0 );
+		}
+#endif
+		if( libbde_encryption_set_keys(
+		     internal_volume->io_handle->encryption_context,
+		     full_volume_encryption_key,
+		     64,
+		     tweak_key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in encryption context.",
+			 function );
+
+			goto on_error;
+		}
+		/* Keep the volume master key so that it can be retrieved and reused
+		 */
+		if( memory_copy(
+		     internal_volume->io_handle->volume_master_key,
+		     volume_master_key,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		internal_volume->io_handle->volume_master_key_is_set = 1;
+	}
+	if( memory_set(
+	     full_volume_encryption_key,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear full volume encryption key.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     tweak_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tweak key.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     volume_master_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to volume master key.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->encryption_method = encryption_method;
+
+	return( result );
+
+on_error:
+	memory_set(
+	 full_volume_encryption_key,
+	 0,
+	 32 );
+
+	memory_set(
+	 tweak_key,
+	 0,
+	 32 );
+
+	memory_set(
+	 volume_master_key,
+	 0,
+	 32 );
+
+	return( -1 );
+}
+
+/* Determines if the volume is locked
+ * Returns 1 if locked, 0 if not or -1 on error
+ */
+int libbde_volume_is_locked(
+     libbde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_is_locked";
+	uint8_t is_locked                         = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	is_locked = internal_volume->is_locked;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( is_locked );
+}
+
+/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbde_sector_data_t *sector_data = NULL;
+	static char *function             = "libbde_internal_volume_read_buffer_from_file_io_handle";
+	size_t buffer_offset              = 0;
+	size_t read_size                  = 0;
+	size_t sector_data_offset         = 0;
+	ssize_t total_read_count          = 0;
+	off64_t read_offset               = 0;
+	off64_t sector_offset             = 0;
+	int result                        = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid file - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - internal_volume->current_offset );
+	}
+	read_offset = internal_volume->current_offset;
+
+	while( buffer_size > 0 )
+	{
+		sector_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->sectors_cache_block_size );
+		sector_offset      = internal_volume->current_offset - (off64_t) sector_data_offset;
+
+		result = libbde_sectors_cache_get_sector_data_by_offset(
+		          internal_volume->sectors_cache,
+		          sector_offset,
+		          &sector_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector data at offset: %" PRIi64 " from cache.",
+			 function,
+			 sector_offset );
+
+			return( -1 );
+		}
+		/* Read multiple whole sectors as runs directly into the buffer
+		 * bypassing the sectors cache if the buffer spans at least a cache block
+		 * and the block was not cached, e.g. by the readahead. The run stops
+		 * at the next block that was cached
+		 */
+		if( ( result == 0 )
+		 && ( ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector ) == 0 )
+		 && ( buffer_size >= internal_volume->sectors_cache_block_size )
+		 && ( buffer_size >= ( 2 * (size_t) internal_volume->io_handle->bytes_per_sector ) ) )
+		{
+			read_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+			if( read_size > (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE )
+			{
+				read_size = (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE;
+			}
+			if( libbde_internal_volume_get_uncached_run_size(
+			     internal_volume,
+			     internal_volume->current_offset,
+			     read_size,
+			     &read_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine uncached run size at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+			if( internal_volume->sectors_run_data == NULL )
+			{
+				internal_volume->sectors_run_data = (uint8_t *) memory_allocate(
+				                                                 sizeof( uint8_t ) * LIBBDE_MAXIMUM_SECTORS_RUN_SIZE );
+
+				if( internal_volume->sectors_run_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create sectors run data.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+			/* Decrypt the sectors using the decryption threads if more than 1 thread was set
+			 */
+			if( internal_volume->number_of_threads > 1 )
+			{
+				if( internal_volume->decryption_mutex == NULL )
+				{
+					if( libbde_internal_volume_start_decryption_threads(
+					     internal_volume,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to start decryption threads.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				result = libbde_internal_volume_read_sectors_multi_threaded(
+				          internal_volume,
+				          file_io_handle,
+				          internal_volume->current_offset,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          error );
+			}
+			else
+#endif
+			{
+				result = libbde_io_handle_read_sectors(
+				          internal_volume->io_handle,
+				          file_io_handle,
+				          internal_volume->current_offset,
+				          internal_volume->io_handle->encryption_context,
+				          internal_volume->sectors_run_data,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          1,
+				          1,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+		}
+		else
+		{
+			if( result == 0 )
+			{
+				if( libbde_internal_volume_read_sector_data(
+				     internal_volume,
+				     file_io_handle,
+				     sector_offset,
+				     &sector_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read sector data at offset: %" PRIi64 ".",
+					 function,
+					 sector_offset );
+
+					return( -1 );
+				}
+			}
+			if( sector_data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: missing sector data at offset: %" PRIi64 ".",
+				 function,
+				 internal_volume->current_offset );
+
+				return( -1 );
+			}
+			read_size = sector_data->data_size - sector_data_offset;
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( read_size == 0 )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ sector_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+
+		internal_volume->current_offset += (off64_t) read_size;
+
+		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
+		{
+			break;
+		}
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( libbde_internal_volume_update_readahead(
+	     internal_volume,
+	     read_offset,
+	     (size_t) total_read_count,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update readahead.",
+		 function );
+
+		return( -1 );
+	}
+	return( total_read_count );
+}
+
+/* Reads the sector data of a cache block and stores it in the sectors cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_read_sector_data(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_offset,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error )
+{
+	libbde_sector_data_t *evicted_sector_data = NULL;
+	libbde_sector_data_t *safe_sector_data    = NULL;
+	static char *function                     = "libbde_internal_volume_read_sector_data";
+	size_t sector_data_size                   = 0;
+	int result                                = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_offset < 0 )
+	 || ( (size64_t) sector_offset >= internal_volume->io_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid sector offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last block of the volume can be smaller than the block size
+	 */
+	sector_data_size = internal_volume->sectors_cache_block_size;
+
+	if( sector_data_size > ( internal_volume->io_handle->volume_size - sector_offset ) )
+	{
+		sector_data_size = (size_t) ( internal_volume->io_handle->volume_size - sector_offset );
+
+		if( ( sector_data_size % internal_volume->io_handle->bytes_per_sector ) != 0 )
+		{
+			sector_data_size += internal_volume->io_handle->bytes_per_sector
+			                  - ( sector_data_size % internal_volume->io_handle->bytes_per_sector );
+		}
+	}
+	if( sector_data_size == internal_volume->sector_data_pool->data_size )
+	{
+		result = libbde_sector_data_pool_get_sector_data(
+		          internal_volume->sector_data_pool,
+		          &safe_sector_data,
+		          error );
+	}
+	else
+	{
+		result = libbde_sector_data_initialize(
+		          &safe_sector_data,
+		          sector_data_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_sector_data_read(
+	     safe_sector_data,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     sector_offset,
+	     internal_volume->io_handle->encryption_context,
+	     1,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data at offset: %" PRIi64 ".",
+		 function,
+		 sector_offset );
+
+		goto on_error;
+	}
+	if( libbde_sectors_cache_set_sector_data_by_offset(
+	     internal_volume->sectors_cache,
+	     sector_offset,
+	     safe_sector_data,
+	     &evicted_sector_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set sector data at offset: %" PRIi64 " in cache.",
+		 function,
+		 sector_offset );
+
+		goto on_error;
+	}
+	*sector_data = safe_sector_data;
+
+	/* Recycle the sector data of the evicted cache entry
+	 */
+	if( libbde_sector_data_pool_release_sector_data(
+	     internal_volume->sector_data_pool,
+	     &evicted_sector_data,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release evicted sector data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	if( safe_sector_data != NULL )
+	{
+		libbde_sector_data_pool_release_sector_data(
+		 internal_volume->sector_data_pool,
+		 &safe_sector_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Determines the size of the run of blocks that are not cached starting at a specific offset
+ * The block containing the offset is expected not to be cached. The run ends before
+ * the first block that is cached, e.g. by the readahead, so that it is not read and decrypted again
+ * This function is not multi-thread safe acquire write lock or shared read mutex before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_get_uncached_run_size(
+     libbde_internal_volume_t *internal_volume,
+     off64_t offset,
+     size_t maximum_run_size,
+     size_t *run_size,
+     libcerror_error_t **error )
+{
+	libbde_sector_data_t *sector_data = NULL;
+	static char *function             = "libbde_internal_volume_get_uncached_run_size";
+	off64_t block_offset              = 0;
+	off64_t end_offset                = 0;
+	int result                        = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_run_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum run size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( run_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run size.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset   = offset + (off64_t) maximum_run_size;
+	block_offset = offset - ( offset % internal_volume->sectors_cache_block_size )
+	             + (off64_t) internal_volume->sectors_cache_block_size;
+
+	while( block_offset < end_offset )
+	{
+		result = libbde_sectors_cache_get_sector_data_by_offset(
+		          internal_volume->sectors_cache,
+		          block_offset,
+		          &sector_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector data at offset: %" PRIi64 " from cache.",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			end_offset = block_offset;
+
+			break;
+		}
+		block_offset += (off64_t) internal_volume->sectors_cache_block_size;
+	}
+	*run_size = (size_t) ( end_offset - offset );
+
+	return( 1 );
+}
+
+/* Updates the readahead based on the access pattern of the reads
+ * The readahead is started after a number of consecutive sequential reads
+ * and covers the readahead depth in blocks of at least the last read size
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_update_readahead(
+     libbde_internal_volume_t *internal_volume,
+     off64_t read_offset,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	static char *function           = "libbde_internal_volume_update_readahead";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	size64_t maximum_readahead_size = 0;
+	size64_t readahead_size         = 0;
+	size_t block_size               = 0;
+	off64_t readahead_end_offset    = 0;
+	off64_t readahead_offset        = 0;
+#endif
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( read_size > 0 )
+	 && ( read_offset == internal_volume->last_read_end_offset ) )
+	{
+		if( internal_volume->number_of_sequential_reads < LIBBDE_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+		{
+			internal_volume->number_of_sequential_reads += 1;
+		}
+	}
+	else
+	{
+		internal_volume->number_of_sequential_reads = 0;
+	}
+	internal_volume->last_read_end_offset = read_offset + (off64_t) read_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( ( internal_volume->readahead_depth > 0 )
+	 && ( internal_volume->number_of_sequential_reads >= LIBBDE_READAHEAD_SEQUENTIAL_READS_THRESHOLD )
+	 && ( internal_volume->io_handle->abort == 0 )
+	 && ( internal_volume->sectors_cache != NULL )
+	 && ( internal_volume->sectors_cache_block_size > 0 ) )
+	{
+		block_size = internal_volume->sectors_cache_block_size;
+
+		readahead_size = (size64_t) read_size;
+
+		if( readahead_size < (size64_t) block_size )
+		{
+			readahead_size = (size64_t) block_size;
+		}
+		readahead_size *= (size64_t) internal_volume->readahead_depth;
+
+		/* Keep the readahead within half of the cache so that the blocks
+		 * read ahead are not evicted before they are read
+		 */
+		maximum_readahead_size = (size64_t) ( internal_volume->sectors_cache->maximum_number_of_entries / 2 ) * block_size;
+
+		if( readahead_size > maximum_readahead_size )
+		{
+			readahead_size = maximum_readahead_size;
+		}
+		readahead_offset     = internal_volume->last_read_end_offset - ( internal_volume->last_read_end_offset % block_size );
+		readahead_end_offset = readahead_offset + (off64_t) readahead_size;
+
+		if( (size64_t) readahead_end_offset > internal_volume->io_handle->volume_size )
+		{
+			readahead_end_offset = (off64_t) internal_volume->io_handle->volume_size;
+		}
+	}
+	if( ( readahead_end_offset > readahead_offset )
+	 && ( internal_volume->readahead_thread == NULL ) )
+	{
+		if( libbde_internal_volume_start_readahead(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start readahead.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->readahead_thread != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_volume->readahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab readahead mutex.",
+			 function );
+
+			return( -1 );
+		}
+		/* Skip blocks that were already read and restart the readahead
+		 * if the block size changed, otherwise a non-sequential read
+		 * cancels the outstanding readahead
+		 */
+		if( ( internal_volume->readahead_offset < readahead_offset )
+		 || ( internal_volume->readahead_block_size != block_size ) )
+		{
+			internal_volume->readahead_offset = readahead_offset;
+		}
+		internal_volume->readahead_end_offset = readahead_end_offset;
+		internal_volume->readahead_block_size = block_size;
+
+		if( libcthreads_condition_signal(
+		     internal_volume->readahead_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal readahead condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 internal_volume->readahead_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_release(
+		     internal_volume->readahead_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release readahead mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+
+/* Starts the readahead thread
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_start_readahead(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_start_readahead";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->readahead_thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - readahead thread already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_volume->readahead_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create readahead mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_volume->readahead_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create readahead condition.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->readahead_offset     = 0;
+	internal_volume->readahead_end_offset = 0;
+	internal_volume->readahead_block_size = 0;
+	internal_volume->readahead_stop       = 0;
+
+	if( libcthreads_thread_create(
+	     &( internal_volume->readahead_thread ),
+	     NULL,
+	     &libbde_internal_volume_readahead_thread_callback,
+	     (void *) internal_volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create readahead thread.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( internal_volume->readahead_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( internal_volume->readahead_condition ),
+		 NULL );
+	}
+	if( internal_volume->readahead_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( internal_volume->readahead_mutex ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Stops the readahead thread
+ * Do not hold the read/write lock when calling this function,
+ * since the readahead thread needs it to finish reading the current block
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_stop_readahead(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_stop_readahead";
+	int result            = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->readahead_thread == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->readahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab readahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->readahead_stop = 1;
+
+	if( libcthreads_condition_broadcast(
+	     internal_volume->readahead_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to broadcast readahead condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->readahead_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release readahead mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_thread_join(
+	     &( internal_volume->readahead_thread ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to join readahead thread.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_condition_free(
+	     &( internal_volume->readahead_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free readahead condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( internal_volume->readahead_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free readahead mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Reads the blocks in the readahead range into the sectors cache
+ * This function runs in the readahead thread and reads a batch of blocks at a time,
+ * which are read using io_uring if available. The read/write lock is only held
+ * to look up and insert the blocks in the sectors cache and not while reading
+ * and decrypting, so that the reader can consume blocks in the meantime
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_readahead_thread_callback(
+     void *arguments )
+{
+	libbde_encryption_context_t *encryption_context                 = NULL;
+	libbde_internal_volume_t *internal_volume                       = NULL;
+	libbde_sector_data_t *sector_data[ LIBBDE_IO_URING_QUEUE_DEPTH ] = { NULL };
+	libbde_sector_data_t *cached_sector_data                        = NULL;
+	libbde_sector_data_t *evicted_sector_data                       = NULL;
+	libcerror_error_t *error                                        = NULL;
+	static char *function                                           = "libbde_internal_volume_readahead_thread_callback";
+	size_t block_size                                               = 0;
+	size_t sector_data_size                                         = 0;
+	off64_t block_offset                                            = 0;
+	off64_t sector_data_offsets[ LIBBDE_IO_URING_QUEUE_DEPTH ];
+	off64_t sector_offset                                           = 0;
+	int block_index                                                 = 0;
+	int maximum_number_of_blocks                                    = 0;
+	int number_of_blocks                                            = 0;
+	int number_of_sector_data                                       = 0;
+	int result                                                      = 0;
+	int sector_data_index                                           = 0;
+
+	if( arguments == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume = (libbde_internal_volume_t *) arguments;
+
+	/* Without io_uring the blocks are read one at a time
+	 */
+	if( internal_volume->io_uring != NULL )
+	{
+		maximum_number_of_blocks = LIBBDE_IO_URING_QUEUE_DEPTH;
+	}
+	else
+	{
+		maximum_number_of_blocks = 1;
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->readahead_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab readahead mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( internal_volume->readahead_stop == 0 )
+	{
+		if( internal_volume->readahead_offset >= internal_volume->readahead_end_offset )
+		{
+			if( libcthreads_condition_wait(
+			     internal_volume->readahead_condition,
+			     internal_volume->readahead_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for readahead condition.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		sector_offset = internal_volume->readahead_offset;
+		block_size    = internal_volume->readahead_block_size;
+
+		number_of_blocks = 0;
+
+		while( ( number_of_blocks < maximum_number_of_blocks )
+		    && ( internal_volume->readahead_offset < internal_volume->readahead_end_offset ) )
+		{
+			internal_volume->readahead_offset += (off64_t) block_size;
+
+			number_of_blocks++;
+		}
+		if( libcthreads_mutex_release(
+		     internal_volume->readahead_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release readahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_read_write_lock_grab_for_write(
+		     internal_volume->read_write_lock,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+		/* Determine the blocks that are not cached yet, the volume could have been
+		 * closed or the cache resized in the meantime
+		 */
+		result = 1;
+
+		if( ( internal_volume->is_locked == 0 )
+		 && ( internal_volume->io_handle->abort == 0 )
+		 && ( internal_volume->sectors_cache != NULL )
+		 && ( internal_volume->sectors_cache_block_size == block_size ) )
+		{
+			for( block_index = 0;
+			     block_index < number_of_blocks;
+			     block_index++ )
+			{
+				block_offset = sector_offset + ( (off64_t) block_index * (off64_t) block_size );
+
+				if( (size64_t) block_offset >= internal_volume->io_handle->volume_size )
+				{
+					break;
+				}
+				result = libbde_sectors_cache_get_sector_data_by_offset(
+				          internal_volume->sectors_cache,
+				          block_offset,
+				          &cached_sector_data,
+				          &error );
+
+				if( result == -1 )
+				{
+					break;
+				}
+				else if( result != 0 )
+				{
+					continue;
+				}
+				/* The last block of the volume can be smaller than the block size
+				 */
+				sector_data_size = block_size;
+
+				if( sector_data_size > ( internal_volume->io_handle->volume_size - block_offset ) )
+				{
+					sector_data_size = (size_t) ( internal_volume->io_handle->volume_size - block_offset );
+
+					if( ( sector_data_size % internal_volume->io_handle->bytes_per_sector ) != 0 )
+					{
+						sector_data_size += internal_volume->io_handle->bytes_per_sector
+						                  - ( sector_data_size % internal_volume->io_handle->bytes_per_sector );
+					}
+				}
+				if( sector_data_size == internal_volume->sector_data_pool->data_size )
+				{
+					result = libbde_sector_data_pool_get_sector_data(
+					          internal_volume->sector_data_pool,
+					          &( sector_data[ number_of_sector_data ] ),
+					          &error );
+				}
+				else
+				{
+					result = libbde_sector_data_initialize(
+					          &( sector_data[ number_of_sector_data ] ),
+					          sector_data_size,
+					          &error );
+				}
+				if( result != 1 )
+				{
+					result = -1;
+
+					break;
+				}
+				sector_data_offsets[ number_of_sector_data ] = block_offset;
+
+				number_of_sector_data++;
+			}
+		}
+		if( libcthreads_read_write_lock_release_for_write(
+		     internal_volume->read_write_lock,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release read/write lock for writing.",
+			 function );
+
+			goto on_error;
+		}
+		/* Read and decrypt the blocks without holding the read/write lock,
+		 * the volume cannot be closed while the readahead thread is running
+		 */
+		if( ( result != -1 )
+		 && ( number_of_sector_data > 0 ) )
+		{
+			result = libbde_internal_volume_get_encryption_context(
+			          internal_volume,
+			          &encryption_context,
+			          &error );
+
+			if( result == 1 )
+			{
+				if( internal_volume->io_uring != NULL )
+				{
+					result = libbde_sector_data_read_multiple(
+					          sector_data,
+					          sector_data_offsets,
+					          number_of_sector_data,
+					          internal_volume->io_handle,
+					          internal_volume->io_uring,
+					          encryption_context,
+					          1,
+					          &error );
+				}
+				else
+				{
+					for( sector_data_index = 0;
+					     sector_data_index < number_of_sector_data;
+					     sector_data_index++ )
+					{
+						result = libbde_sector_data_read(
+						          sector_data[ sector_data_index ],
+						          internal_volume->io_handle,
+						          internal_volume->file_io_handle,
+						          sector_data_offsets[ sector_data_index ],
+						          encryption_context,
+						          1,
+						          1,
+						          &error );
+
+						if( result != 1 )
+						{
+							break;
+						}
+					}
+				}
+				if( libbde_internal_volume_release_encryption_context(
+				     internal_volume,
+				     &encryption_context,
+				     &error ) != 1 )
+				{
+					result = -1;
+				}
+			}
+		}
+		if( number_of_sector_data > 0 )
+		{
+			if( libcthreads_read_write_lock_grab_for_write(
+			     internal_volume->read_write_lock,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+			/* Blocks that were read by the reader in the meantime are replaced
+			 * with the same data, blocks of a resized cache are discarded
+			 */
+			for( sector_data_index = 0;
+			     sector_data_index < number_of_sector_data;
+			     sector_data_index++ )
+			{
+				if( ( result == 1 )
+				 && ( internal_volume->sectors_cache != NULL )
+				 && ( internal_volume->sectors_cache_block_size == block_size ) )
+				{
+					if( libbde_sectors_cache_set_sector_data_by_offset(
+					     internal_volume->sectors_cache,
+					     sector_data_offsets[ sector_data_index ],
+					     sector_data[ sector_data_index ],
+					     &evicted_sector_data,
+					     &error ) == 1 )
+					{
+						sector_data[ sector_data_index ] = NULL;
+					}
+					else
+					{
+						result = -1;
+					}
+				}
+				else
+				{
+					evicted_sector_data = sector_data[ sector_data_index ];
+
+					sector_data[ sector_data_index ] = NULL;
+				}
+				if( evicted_sector_data != NULL )
+				{
+					if( libbde_sector_data_pool_release_sector_data(
+					     internal_volume->sector_data_pool,
+					     &evicted_sector_data,
+					     &error ) != 1 )
+					{
+						result = -1;
+					}
+				}
+				if( sector_data[ sector_data_index ] != NULL )
+				{
+					libbde_sector_data_free(
+					 &( sector_data[ sector_data_index ] ),
+					 NULL );
+				}
+			}
+			number_of_sector_data = 0;
+
+			if( libcthreads_read_write_lock_release_for_write(
+			     internal_volume->read_write_lock,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release read/write lock for writing.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     internal_volume->readahead_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab readahead mutex.",
+			 function );
+
+			goto on_error;
+		}
+		/* Stop reading ahead on abort or if the blocks could not be read,
+		 * the reader will report the error if it needs the blocks
+		 */
+		if( ( result == -1 )
+		 || ( internal_volume->io_handle->abort != 0 ) )
+		{
+			internal_volume->readahead_offset = internal_volume->readahead_end_offset;
+
+			if( error != NULL )
+			{
+				libcerror_error_free(
+				 &error );
+			}
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->readahead_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release readahead mutex.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	for( sector_data_index = 0;
+	     sector_data_index < number_of_sector_data;
+	     sector_data_index++ )
+	{
+		if( sector_data[ sector_data_index ] != NULL )
+		{
+			libbde_sector_data_free(
+			 &( sector_data[ sector_data_index ] ),
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Starts the decryption threads
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_start_decryption_threads(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_start_decryption_threads";
+	int thread_index      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->decryption_mutex != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - decryption mutex already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_volume->number_of_threads < 0 )
+	 || ( internal_volume->number_of_threads > LIBBDE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_initialize(
+	     &( internal_volume->decryption_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create decryption mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_volume->decryption_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create decryption condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( internal_volume->decryption_done_condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create decryption done condition.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->first_decryption_job_index        = 0;
+	internal_volume->number_of_queued_decryption_jobs  = 0;
+	internal_volume->number_of_pending_decryption_jobs = 0;
+	internal_volume->number_of_failed_decryption_jobs  = 0;
+	internal_volume->decryption_stop                   = 0;
+
+	for( thread_index = 0;
+	     thread_index < internal_volume->number_of_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_create(
+		     &( internal_volume->decryption_threads[ thread_index ] ),
+		     NULL,
+		     &libbde_internal_volume_decryption_thread_callback,
+		     (void *) internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decryption thread: %d.",
+			 function,
+			 thread_index );
+
+			goto on_error;
+		}
+		internal_volume->number_of_decryption_threads += 1;
+	}
+	return( 1 );
+
+on_error:
+	libbde_internal_volume_stop_decryption_threads(
+	 internal_volume,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Stops the decryption threads
+ * The decryption threads finish the queued jobs before they stop
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_stop_decryption_threads(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_stop_decryption_threads";
+	int result            = 1;
+	int thread_index      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->decryption_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( internal_volume->decryption_condition != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_volume->decryption_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab decryption mutex.",
+			 function );
+
+			return( -1 );
+		}
+		internal_volume->decryption_stop = 1;
+
+		if( libcthreads_condition_broadcast(
+		     internal_volume->decryption_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast decryption condition.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_release(
+		     internal_volume->decryption_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release decryption mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( thread_index = 0;
+	     thread_index < internal_volume->number_of_decryption_threads;
+	     thread_index++ )
+	{
+		if( libcthreads_thread_join(
+		     &( internal_volume->decryption_threads[ thread_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join decryption thread: %d.",
+			 function,
+			 thread_index );
+
+			result = -1;
+		}
+	}
+	internal_volume->number_of_decryption_threads = 0;
+
+	if( internal_volume->decryption_done_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( internal_volume->decryption_done_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decryption done condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->decryption_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( internal_volume->decryption_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free decryption condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_free(
+	     &( internal_volume->decryption_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free decryption mutex.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* Decrypts the queued sectors runs
+ * This function runs in a decryption thread, where every thread retrieves its
+ * own encryption context for the first job and keeps it until the thread stops.
+ * The decryption threads are stopped before the encryption contexts are freed.
+ * A job that fails is counted and reported by libbde_internal_volume_wait_for_decryption_jobs
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_decryption_thread_callback(
+     void *arguments )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_internal_volume_t *internal_volume       = NULL;
+	libcerror_error_t *error                        = NULL;
+	const uint8_t *encrypted_data                   = NULL;
+	uint8_t *data                                   = NULL;
+	static char *function                           = "libbde_internal_volume_decryption_thread_callback";
+	size_t run_size                                 = 0;
+	off64_t physical_offset                         = 0;
+	int job_index                                   = 0;
+	int result                                      = 0;
+
+	if( arguments == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume = (libbde_internal_volume_t *) arguments;
+
+	if( libcthreads_mutex_grab(
+	     internal_volume->decryption_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab decryption mutex.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( internal_volume->decryption_stop == 0 )
+	    || ( internal_volume->number_of_queued_decryption_jobs > 0 ) )
+	{
+		if( internal_volume->number_of_queued_decryption_jobs == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     internal_volume->decryption_condition,
+			     internal_volume->decryption_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for decryption condition.",
+				 function );
+
+				goto on_error;
+			}
+			continue;
+		}
+		job_index = internal_volume->first_decryption_job_index;
+
+		physical_offset = internal_volume->decryption_jobs[ job_index ].physical_offset;
+		encrypted_data  = internal_volume->decryption_jobs[ job_index ].encrypted_data;
+		data            = internal_volume->decryption_jobs[ job_index ].data;
+		run_size        = internal_volume->decryption_jobs[ job_index ].run_size;
+
+		internal_volume->first_decryption_job_index = ( job_index + 1 ) % LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_JOBS;
+
+		internal_volume->number_of_queued_decryption_jobs -= 1;
+
+		if( libcthreads_mutex_release(
+		     internal_volume->decryption_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release decryption mutex.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+
+		if( encryption_context == NULL )
+		{
+			result = libbde_internal_volume_get_encryption_context(
+			          internal_volume,
+			          &encryption_context,
+			          &error );
+		}
+		if( result == 1 )
+		{
+			result = libbde_io_handle_decrypt_sectors_run(
+			          internal_volume->io_handle,
+			          encryption_context,
+			          physical_offset,
+			          LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED,
+			          encrypted_data,
+			          data,
+			          run_size,
+			          &error );
+		}
+		if( error != NULL )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_print_error_backtrace(
+				 error );
+			}
+#endif
+			libcerror_error_free(
+			 &error );
+		}
+		if( libcthreads_mutex_grab(
+		     internal_volume->decryption_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab decryption mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( result != 1 )
+		{
+			internal_volume->number_of_failed_decryption_jobs += 1;
+		}
+		internal_volume->number_of_pending_decryption_jobs -= 1;
+
+		/* The reader waits for a free job or for all jobs to finish
+		 */
+		if( libcthreads_condition_broadcast(
+		     internal_volume->decryption_done_condition,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast decryption done condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 internal_volume->decryption_mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->decryption_mutex,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release decryption mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_internal_volume_release_encryption_context(
+	     internal_volume,
+	     &encryption_context,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to release encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( encryption_context != NULL )
+	{
+		libbde_internal_volume_release_encryption_context(
+		 internal_volume,
+		 &encryption_context,
+		 NULL );
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	return( -1 );
+}
+
+/* Queues a run of encrypted sectors to be decrypted by the decryption threads
+ * The encrypted data and data must remain available until the job is finished
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_push_decryption_job(
+     libbde_internal_volume_t *internal_volume,
+     off64_t physical_offset,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_push_decryption_job";
+	int job_index         = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->number_of_decryption_threads == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing decryption threads.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->decryption_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab decryption mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_volume->number_of_queued_decryption_jobs >= LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_JOBS )
+	{
+		if( libcthreads_condition_wait(
+		     internal_volume->decryption_done_condition,
+		     internal_volume->decryption_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for decryption done condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	job_index = ( internal_volume->first_decryption_job_index + internal_volume->number_of_queued_decryption_jobs )
+	          % LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_JOBS;
+
+	internal_volume->decryption_jobs[ job_index ].physical_offset = physical_offset;
+	internal_volume->decryption_jobs[ job_index ].encrypted_data  = encrypted_data;
+	internal_volume->decryption_jobs[ job_index ].data            = data;
+	internal_volume->decryption_jobs[ job_index ].run_size        = run_size;
+
+	internal_volume->number_of_queued_decryption_jobs  += 1;
+	internal_volume->number_of_pending_decryption_jobs += 1;
+
+	if( libcthreads_condition_signal(
+	     internal_volume->decryption_condition,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to signal decryption condition.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_release(
+	     internal_volume->decryption_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release decryption mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libcthreads_mutex_release(
+	 internal_volume->decryption_mutex,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Waits until the decryption threads finished all queued jobs
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_wait_for_decryption_jobs(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error )
+{
+	static char *function     = "libbde_internal_volume_wait_for_decryption_jobs";
+	int number_of_failed_jobs = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->decryption_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     internal_volume->decryption_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab decryption mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( internal_volume->number_of_pending_decryption_jobs > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     internal_volume->decryption_done_condition,
+		     internal_volume->decryption_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for decryption done condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 internal_volume->decryption_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	number_of_failed_jobs = internal_volume->number_of_failed_decryption_jobs;
+
+	internal_volume->number_of_failed_decryption_jobs = 0;
+
+	if( libcthreads_mutex_release(
+	     internal_volume->decryption_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release decryption mutex.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_failed_jobs > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to decrypt %d sectors runs.",
+		 function,
+		 number_of_failed_jobs );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads sectors and decrypts them using the decryption threads
+ * The sectors are read in runs of at most the decryption job size into the sectors run data,
+ * where the decryption of a run by the decryption threads overlaps the read of the next run
+ * The sectors offset and data size must be a multiple of the bytes per sector
+ * and the data size cannot exceed the maximum sectors run size
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_read_sectors_multi_threaded(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t sectors_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	const uint8_t *run_encrypted_data = NULL;
+	static char *function             = "libbde_internal_volume_read_sectors_multi_threaded";
+	size_t data_offset                = 0;
+	size_t maximum_run_size           = 0;
+	size_t run_size                   = 0;
+	off64_t physical_offset           = 0;
+	uint8_t storage_type              = 0;
+	int result                        = 1;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_run_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors run data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < data_size )
+	{
+		maximum_run_size = data_size - data_offset;
+
+		if( maximum_run_size > (size_t) LIBBDE_DECRYPTION_JOB_SIZE )
+		{
+			maximum_run_size = (size_t) LIBBDE_DECRYPTION_JOB_SIZE;
+		}
+		if( libbde_io_handle_get_sectors_run(
+		     internal_volume->io_handle,
+		     sectors_offset + (off64_t) data_offset,
+		     maximum_run_size,
+		     1,
+		     &physical_offset,
+		     &storage_type,
+		     &run_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sectors run at offset: %" PRIi64 ".",
+			 function,
+			 sectors_offset + (off64_t) data_offset );
+
+			result = -1;
+
+			break;
+		}
+		if( libbde_io_handle_read_sectors_run(
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     physical_offset,
+		     storage_type,
+		     &( internal_volume->sectors_run_data[ data_offset ] ),
+		     &( data[ data_offset ] ),
+		     run_size,
+		     1,
+		     &run_encrypted_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sectors run at offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			result = -1;
+
+			break;
+		}
+		if( storage_type == LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED )
+		{
+			result = libbde_internal_volume_push_decryption_job(
+			          internal_volume,
+			          physical_offset,
+			          run_encrypted_data,
+			          &( data[ data_offset ] ),
+			          run_size,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to queue decryption of sectors run at offset: %" PRIi64 ".",
+				 function,
+				 physical_offset );
+
+				break;
+			}
+		}
+		else if( libbde_io_handle_decrypt_sectors_run(
+		          internal_volume->io_handle,
+		          NULL,
+		          physical_offset,
+		          storage_type,
+		          run_encrypted_data,
+		          &( data[ data_offset ] ),
+		          run_size,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sectors run at offset: %" PRIi64 ".",
+			 function,
+			 physical_offset );
+
+			result = -1;
+
+			break;
+		}
+		data_offset += run_size;
+	}
+	/* The decryption threads write into the data and the sectors run data
+	 * is reused by the next read, hence the queued jobs must finish before returning
+	 */
+	if( result == 1 )
+	{
+		if( libbde_internal_volume_wait_for_decryption_jobs(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to decrypt sectors at offset: %" PRIi64 ".",
+			 function,
+			 sectors_offset );
+
+			result = -1;
+		}
+	}
+	else
+	{
+		libbde_internal_volume_wait_for_decryption_jobs(
+		 internal_volume,
+		 NULL );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
+
+/* Reads data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_read_buffer(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (volume) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_read_buffer_at_offset(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (volume) data at a specific offset without using or changing the current offset
+ * Unlike libbde_internal_volume_read_buffer_from_file_io_handle this function can be
+ * called by multiple threads that hold the read/write lock for reading
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_internal_volume_pread_buffer_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_sector_data_t *evicted_sector_data       = NULL;
+	libbde_sector_data_t *sector_data               = NULL;
+	uint8_t *sectors_run_data                       = NULL;
+	static char *function                           = "libbde_internal_volume_pread_buffer_from_file_io_handle";
+	size_t buffer_offset                            = 0;
+	size_t read_size                                = 0;
+	size_t sector_data_offset                       = 0;
+	size_t sector_data_size                         = 0;
+	size_t sectors_run_data_size                    = 0;
+	ssize_t total_read_count                        = 0;
+	off64_t sector_offset                           = 0;
+	uint8_t file_io_handle_is_shared                = 1;
+	uint8_t read_sectors_run                        = 0;
+	int file_io_pool_entry                          = -1;
+	int result                                      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sector_data_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sector data pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->sectors_cache_block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_volume->io_handle->volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_volume->io_handle->volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - offset );
+	}
+	if( libbde_internal_volume_get_encryption_context(
+	     internal_volume,
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	/* Use a file IO handle of the file IO pool if available
+	 * otherwise seeking and reading the shared file IO handle is serialized
+	 */
+	result = libbde_internal_volume_get_file_io_pool_entry(
+	          internal_volume,
+	          &file_io_pool_entry,
+	          &file_io_handle,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO pool entry.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		file_io_handle_is_shared = 0;
+	}
+	while( buffer_size > 0 )
+	{
+		sector_data_offset = (size_t) ( offset % internal_volume->sectors_cache_block_size );
+		sector_offset      = offset - (off64_t) sector_data_offset;
+
+		/* Multiple whole sectors are read as runs directly into the buffer
+		 * bypassing the sectors cache if the buffer spans at least a cache block
+		 */
+		read_sectors_run = 0;
+
+		if( ( ( offset % internal_volume->io_handle->bytes_per_sector ) == 0 )
+		 && ( buffer_size >= internal_volume->sectors_cache_block_size )
+		 && ( buffer_size >= ( 2 * (size_t) internal_volume->io_handle->bytes_per_sector ) ) )
+		{
+			read_sectors_run = 1;
+		}
+		/* The sector data is copied while the mutex is held since another
+		 * thread can evict and recycle it as soon as the mutex is released
+		 */
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_volume->shared_read_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab shared read mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		result = libbde_sectors_cache_get_sector_data_by_offset(
+		          internal_volume->sectors_cache,
+		          sector_offset,
+		          &sector_data,
+		          error );
+
+		if( ( result == 0 )
+		 && ( read_sectors_run != 0 ) )
+		{
+			/* The run stops at the next block that was cached, e.g. by the readahead
+			 */
+			read_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+			if( read_size > (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE )
+			{
+				read_size = (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE;
+			}
+			if( libbde_internal_volume_get_uncached_run_size(
+			     internal_volume,
+			     offset,
+			     read_size,
+			     &read_size,
+			     error ) != 1 )
+			{
+				result = -1;
+			}
+		}
+		else if( result == 1 )
+		{
+			read_size = sector_data->data_size - sector_data_offset;
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ sector_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				result = -1;
+			}
+			sector_data = NULL;
+		}
+		else if( ( result == 0 )
+		      && ( read_sectors_run == 0 )
+		      && ( internal_volume->sector_data_pool->data_size == internal_volume->sectors_cache_block_size )
+		      && ( (size64_t) ( sector_offset + internal_volume->sectors_cache_block_size ) <= internal_volume->io_handle->volume_size ) )
+		{
+			result = libbde_sector_data_pool_get_sector_data(
+			          internal_volume->sector_data_pool,
+			          &sector_data,
+			          error );
+
+			if( result == 1 )
+			{
+				result = 0;
+			}
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_volume->shared_read_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release shared read mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve sector data at offset: %" PRIi64 " from cache.",
+			 function,
+			 sector_offset );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      && ( read_sectors_run != 0 ) )
+		{
+			/* The sectors run data of the volume is used by unshared reads,
+			 * hence every call uses its own. It is sized for the remainder
+			 * of the buffer since the first run can stop at a cached block
+			 */
+			if( sectors_run_data == NULL )
+			{
+				sectors_run_data_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+				if( sectors_run_data_size > (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE )
+				{
+					sectors_run_data_size = (size_t) LIBBDE_MAXIMUM_SECTORS_RUN_SIZE;
+				}
+
+				sectors_run_data = (uint8_t *) memory_allocate(
+				                                sizeof( uint8_t ) * sectors_run_data_size );
+
+				if( sectors_run_data == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create sectors run data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( read_size > sectors_run_data_size )
+			{
+				read_size = sectors_run_data_size;
+			}
+			if( libbde_io_handle_read_sectors(
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     offset,
+			     encryption_context,
+			     sectors_run_data,
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     read_size,
+			     1,
+			     file_io_handle_is_shared,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sectors at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		else if( result == 0 )
+		{
+			/* The last block of the volume can be smaller than the block size
+			 */
+			if( sector_data == NULL )
+			{
+				sector_data_size = (size_t) ( internal_volume->io_handle->volume_size - sector_offset );
+
+				if( ( sector_data_size % internal_volume->io_handle->bytes_per_sector ) != 0 )
+				{
+					sector_data_size += internal_volume->io_handle->bytes_per_sector
+					                  - ( sector_data_size % internal_volume->io_handle->bytes_per_sector );
+				}
+				if( libbde_sector_data_initialize(
+				     &sector_data,
+				     sector_data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create sector data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libbde_sector_data_read(
+			     sector_data,
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     sector_offset,
+			     encryption_context,
+			     1,
+			     file_io_handle_is_shared,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector data at offset: %" PRIi64 ".",
+				 function,
+				 sector_offset );
+
+				goto on_error;
+			}
+			read_size = sector_data->data_size - sector_data_offset;
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ sector_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_grab(
+			     internal_volume->shared_read_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to grab shared read mutex.",
+				 function );
+
+				goto on_error;
+			}
+#endif
+			/* Another thread could have cached the same block in the meantime
+			 * in which case its sector data is replaced and recycled
+			 */
+			result = libbde_sectors_cache_set_sector_data_by_offset(
+			          internal_volume->sectors_cache,
+			          sector_offset,
+			          sector_data,
+			          &evicted_sector_data,
+			          error );
+
+			if( result == 1 )
+			{
+				sector_data = NULL;
+
+				result = libbde_sector_data_pool_release_sector_data(
+				          internal_volume->sector_data_pool,
+				          &evicted_sector_data,
+				          error );
+			}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_release(
+			     internal_volume->shared_read_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release shared read mutex.",
+				 function );
+
+				goto on_error;
+			}
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sector data at offset: %" PRIi64 " in cache.",
+				 function,
+				 sector_offset );
+
+				goto on_error;
+			}
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		offset           += (off64_t) read_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( sectors_run_data != NULL )
+	{
+		memory_free(
+		 sectors_run_data );
+
+		sectors_run_data = NULL;
+	}
+	if( libbde_internal_volume_release_file_io_pool_entry(
+	     internal_volume,
+	     &file_io_pool_entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release file IO pool entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_internal_volume_release_encryption_context(
+	     internal_volume,
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	return( total_read_count );
+
+on_error:
+	if( evicted_sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &evicted_sector_data,
+		 NULL );
+	}
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( sectors_run_data != NULL )
+	{
+		memory_free(
+		 sectors_run_data );
+	}
+	if( file_io_pool_entry != -1 )
+	{
+		libbde_internal_volume_release_file_io_pool_entry(
+		 internal_volume,
+		 &file_io_pool_entry,
+		 NULL );
+	}
+	if( encryption_context != NULL )
+	{
+		libbde_internal_volume_release_encryption_context(
+		 internal_volume,
+		 &encryption_context,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (volume) data at a specific offset without changing the current offset
+ * Multiple threads can read concurrently, since only a shared lock is taken
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_pread_buffer(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_pread_buffer";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbde_internal_volume_pread_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+#ifdef TODO_WRITE_SUPPORT
+
+/* Writes (volume) data at the current offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_volume_write_buffer(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	return( -1 );
+}
+
+/* Writes (volume) data at a specific offset,
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_volume_write_buffer_at_offset(
+         libbde_volume_t *volume,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "libbde_volume_write_buffer_at_offset";
+	ssize_t write_count   = 0;
+
+	if( libbde_volume_seek_offset(
+	     volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbde_volume_write_buffer(
+	               volume,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+#endif /* TODO_WRITE_SUPPORT */
+
+/* Seeks a certain offset of the (volume) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libbde_internal_volume_seek_offset(
+         libbde_internal_volume_t *internal_volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_seek_offset";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_volume->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_volume->io_handle->volume_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking volume data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libbde_volume_seek_offset(
+         libbde_volume_t *volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_seek_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libbde_internal_volume_seek_offset(
+	          internal_volume,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (volume) data
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_offset(
+     libbde_volume_t *volume,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_volume->current_offset;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_size(
+     libbde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->io_handle->volume_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the cache size
+ * The cache size is the maximum number of bytes of decrypted data that is cached
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_cache_size(
+     libbde_volume_t *volume,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_cache_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid metadata.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( memory_set(
-	     full_volume_encryption_key,
-	     0,
-	     64 ) == NULL )
+#endif
+	*cache_size = internal_volume->cache_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear full volume encryption key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     tweak_key,
-	     0,
-	     32 ) == NULL )
+#endif
+	return( 1 );
+}
+
+/* Sets the cache size
+ * The cache size is the maximum number of bytes of decrypted data that is cached
+ * If the volume is open the cache is emptied and resized
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_cache_size(
+     libbde_volume_t *volume,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_cache_size";
+	int result                                = 1;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear tweak key.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     volume_master_key,
-	     0,
-	     32 ) == NULL )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( cache_size > (size64_t) INT64_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to volume master key.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
 		 function );
 
-		goto on_error;
-	}
-	if( ( internal_volume->external_key_metadata != NULL )
-	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL )
-	 && ( internal_volume->external_key_metadata->startup_key_external_key->key != NULL ) )
-	{
-		external_key      = internal_volume->external_key_metadata->startup_key_external_key->key->data;
-		external_key_size = internal_volume->external_key_metadata->startup_key_external_key->key->data_size;
+		return( -1 );
 	}
-	encrypted_volume_size = metadata->encrypted_volume_size;
-	volume_header_offset  = metadata->volume_header_offset;
-	volume_header_size    = metadata->volume_header_size;
-	encryption_method     = metadata->encryption_method;
-
-	result = libbde_metadata_read_volume_master_key(
-	          metadata,
-	          internal_volume->io_handle,
-	          internal_volume->password_keep,
-	          external_key,
-	          external_key_size,
-	          volume_master_key,
-	          32,
-	          error );
-
-	if( result == -1 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to read volume master key from metadata.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	else if( result != 0 )
-	{
-		result = libbde_metadata_read_full_volume_encryption_key(
-		          metadata,
-		          internal_volume->io_handle,
-		          volume_master_key,
-		          32,
-		          full_volume_encryption_key,
-		          64,
-		          tweak_key,
-		          32,
-		          error );
-
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read full volume encryption key from metadata.",
-			 function );
+#endif
+	internal_volume->cache_size = cache_size;
 
-			goto on_error;
-		}
-	}
-	if( result != 0 )
+	if( internal_volume->sectors_cache != NULL )
 	{
-		internal_volume->io_handle->encrypted_volume_size = encrypted_volume_size;
-		internal_volume->io_handle->volume_header_offset  = volume_header_offset;
-		internal_volume->io_handle->volume_header_size    = volume_header_size;
-
-		if( libbde_encryption_initialize(
-		     &( internal_volume->io_handle->encryption_context ),
-		     encryption_method,
+		if( libbde_internal_volume_free_sectors_cache(
+		     internal_volume,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create encryption context.",
-			 function );
-
-			goto on_error;
-		}
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
-		{
-			libcnotify_printf(
-			 "%s: volume master key:\n",
-			 function );
-			libcnotify_print_data(
-			 volume_master_key,
-			 32,
-			 0 );
-
-			libcnotify_printf(
-			 "%s: full volume encryption key:\n",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sectors cache.",
 			 function );
-			libcnotify_print_data(
-			 full_volume_encryption_key,
-			 64,
-			 0 );
 
-			libcnotify_printf(
-			 "%s: tweak key:\n",
-			 function );
-			libcnotify_print_data(
-			 tweak_key,
-			 32,
-			 0 );
+			result = -1;
 		}
-#endif
-		if( libbde_encryption_set_keys(
-		     internal_volume->io_handle->encryption_context,
-		     full_volume_encryption_key,
-		     64,
-		     tweak_key,
-		     32,
-		     error ) != 1 )
+		else if( libbde_internal_volume_initialize_sectors_cache(
+		          internal_volume,
+		          error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set keys in encryption context.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sectors cache.",
 			 function );
 
-			goto on_error;
+			result = -1;
 		}
 	}
-	if( memory_set(
-	     full_volume_encryption_key,
-	     0,
-	     64 ) == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear full volume encryption key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     tweak_key,
-	     0,
-	     32 ) == NULL )
+#endif
+	return( result );
+}
+
+/* Retrieves the cache block size
+ * The cache block size is the number of bytes that is decrypted and cached as a single unit
+ * If the volume is open the block size in use is returned
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_cache_block_size(
+     libbde_volume_t *volume,
+     size_t *cache_block_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_cache_block_size";
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear tweak key.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( memory_set(
-	     volume_master_key,
-	     0,
-	     32 ) == NULL )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( cache_block_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to volume master key.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache block size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	internal_volume->encryption_method = encryption_method;
-
-	return( result );
-
-on_error:
-	memory_set(
-	 full_volume_encryption_key,
-	 0,
-	 32 );
-
-	memory_set(
-	 tweak_key,
-	 0,
-	 32 );
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
 
-	memory_set(
-	 volume_master_key,
-	 0,
-	 32 );
+		return( -1 );
+	}
+#endif
+	if( internal_volume->sectors_cache_block_size != 0 )
+	{
+		*cache_block_size = internal_volume->sectors_cache_block_size;
+	}
+	else
+	{
+		*cache_block_size = internal_volume->cache_block_size;
+	}
 
-	return( -1 );
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
 }
 
-/* Determines if the volume is locked
- * Returns 1 if locked, 0 if not or -1 on error
+/* Sets the cache block size
+ * The cache block size is either 0 to use the cluster block size
+ * or a value between 4 KiB and 256 KiB
+ * If the volume is open the cache is emptied and resized
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_is_locked(
+int libbde_volume_set_cache_block_size(
      libbde_volume_t *volume,
+     size_t cache_block_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_is_locked";
-	uint8_t is_locked                         = 0;
+	static char *function                     = "libbde_volume_set_cache_block_size";
+	int result                                = 1;
 
 	if( volume == NULL )
 	{
@@ -1898,8 +7802,21 @@ int libbde_volume_is_locked(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
+	if( ( cache_block_size != 0 )
+	 && ( ( cache_block_size < (size_t) LIBBDE_MINIMUM_CACHE_BLOCK_SIZE )
+	  || ( cache_block_size > (size_t) LIBBDE_MAXIMUM_CACHE_BLOCK_SIZE ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid cache block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1907,16 +7824,45 @@ int libbde_volume_is_locked(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	is_locked = internal_volume->is_locked;
+	internal_volume->cache_block_size = cache_block_size;
+
+	if( internal_volume->sectors_cache != NULL )
+	{
+		if( libbde_internal_volume_free_sectors_cache(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sectors cache.",
+			 function );
+
+			result = -1;
+		}
+		else if( libbde_internal_volume_initialize_sectors_cache(
+		          internal_volume,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sectors cache.",
+			 function );
 
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -1924,35 +7870,29 @@ int libbde_volume_is_locked(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( is_locked );
+	return( result );
 }
 
-/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Retrieves the readahead depth
+ * The readahead depth is the number of blocks that is read ahead in the background
+ * when the volume is read sequentially, where 0 represents readahead is disabled
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
-         libbde_internal_volume_t *internal_volume,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbde_volume_get_readahead_depth(
+     libbde_volume_t *volume,
+     int *readahead_depth,
+     libcerror_error_t **error )
 {
-	libbde_sector_data_t *sector_data = NULL;
-	static char *function             = "libbde_internal_volume_read_buffer_from_file_io_handle";
-	off64_t element_data_offset       = 0;
-	size_t buffer_offset              = 0;
-	size_t read_size                  = 0;
-	size_t sector_data_offset         = 0;
-	ssize_t total_read_count          = 0;
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_readahead_depth";
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1963,198 +7903,205 @@ ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
-		 function );
+	internal_volume = (libbde_internal_volume_t *) volume;
 
-		return( -1 );
-	}
-	if( internal_volume->io_handle == NULL )
+	if( readahead_depth == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid readahead depth.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors vector.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache == NULL )
+#endif
+	*readahead_depth = internal_volume->readahead_depth;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->current_offset < 0 )
+#endif
+	return( 1 );
+}
+
+/* Sets the readahead depth
+ * The readahead depth is the number of blocks that is read ahead in the background
+ * when the volume is read sequentially, where 0 disables readahead
+ * Readahead requires multi-thread support otherwise the value is ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_readahead_depth(
+     libbde_volume_t *volume,
+     int readahead_depth,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_readahead_depth";
+	int result                                = 1;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid volume - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( ( readahead_depth < 0 )
+	 || ( readahead_depth > LIBBDE_MAXIMUM_READAHEAD_DEPTH ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid readahead depth value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
-	{
-		return( 0 );
-	}
-	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->volume_size )
-	{
-		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - internal_volume->current_offset );
-	}
-	sector_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector );
+#endif
+	internal_volume->readahead_depth = readahead_depth;
 
-	while( buffer_size > 0 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* Cancel the outstanding readahead when it is disabled
+	 */
+	if( ( readahead_depth == 0 )
+	 && ( internal_volume->readahead_thread != NULL ) )
 	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     internal_volume->sectors_vector,
-		     (intptr_t *) file_io_handle,
-		     internal_volume->sectors_cache,
-		     internal_volume->current_offset,
-		     &element_data_offset,
-		     (intptr_t **) &sector_data,
-		     0,
+		if( libcthreads_mutex_grab(
+		     internal_volume->readahead_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab readahead mutex.",
+			 function );
 
-			return( -1 );
+			result = -1;
 		}
-		if( sector_data == NULL )
+		else
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
-
-			return( -1 );
-		}
-		read_size = sector_data->data_size - sector_data_offset;
+			internal_volume->readahead_end_offset = internal_volume->readahead_offset;
 
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( sector_data->data )[ sector_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data to buffer.",
-			 function );
+			if( libcthreads_mutex_release(
+			     internal_volume->readahead_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to release readahead mutex.",
+				 function );
 
-			return( -1 );
+				result = -1;
+			}
 		}
-		buffer_offset     += read_size;
-		buffer_size       -= read_size;
-		total_read_count  += (ssize_t) read_size;
-		sector_data_offset = 0;
-
-		internal_volume->current_offset += (off64_t) read_size;
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
 
-		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
-		{
-			break;
-		}
-		if( internal_volume->io_handle->abort != 0 )
-		{
-			break;
-		}
+		return( -1 );
 	}
-	return( total_read_count );
+#endif
+	return( result );
 }
 
-/* Reads data at the current offset into a buffer
- * Returns the number of bytes read or -1 on error
+/* Retrieves the number of threads
+ * The number of threads is the number of threads that decrypt the sectors of large reads,
+ * where 0 or 1 represents the sectors are decrypted by the reading thread
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbde_volume_read_buffer(
-         libbde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbde_volume_get_number_of_threads(
+     libbde_volume_t *volume,
+     int *number_of_threads,
+     libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_read_buffer";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libbde_volume_get_number_of_threads";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( volume == NULL )
+	if( number_of_threads == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid number of threads.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2162,32 +8109,16 @@ ssize_t libbde_volume_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+	*number_of_threads = internal_volume->number_of_threads;
 
-		read_count = -1;
-	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2195,28 +8126,29 @@ ssize_t libbde_volume_read_buffer(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Reads (volume) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Sets the number of threads
+ * The number of threads is the number of threads that decrypt the sectors of large reads,
+ * where 0 or 1 represents the sectors are decrypted by the reading thread
+ * Decryption threads require multi-thread support otherwise the value is ignored
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbde_volume_read_buffer_at_offset(
-         libbde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libbde_volume_set_number_of_threads(
+     libbde_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
+	static char *function                     = "libbde_volume_set_number_of_threads";
+	int result                                = 1;
 
 	if( volume == NULL )
 	{
@@ -2231,6 +8163,18 @@ ssize_t libbde_volume_read_buffer_at_offset(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBBDE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
@@ -2245,40 +8189,28 @@ ssize_t libbde_volume_read_buffer_at_offset(
 
 		return( -1 );
 	}
-#endif
-	if( libbde_internal_volume_seek_offset(
-	     internal_volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	/* The decryption threads are idle while the write lock is held,
+	 * they are restarted with the new number of threads by the next large read
+	 */
+	if( number_of_threads != internal_volume->number_of_threads )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+		if( libbde_internal_volume_stop_decryption_threads(
+		     internal_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop decryption threads.",
+			 function );
 
-		goto on_error;
+			result = -1;
+		}
 	}
-	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+#endif
+	internal_volume->number_of_threads = number_of_threads;
 
-		goto on_error;
-	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -2294,183 +8226,127 @@ ssize_t libbde_volume_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
-
-on_error:
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-#ifdef TODO_WRITE_SUPPORT
-
-/* Writes (volume) data at the current offset
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libbde_volume_write_buffer(
-         libbde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	return( -1 );
+	return( result );
 }
 
-/* Writes (volume) data at a specific offset,
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Retrieves the sector data pool statistics
+ * The number of allocations is the number of times new sector data was allocated
+ * on a cache miss and the number of reuses the number of times the sector data
+ * of an evicted cache entry was reused
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbde_volume_write_buffer_at_offset(
-         libbde_volume_t *volume,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libbde_volume_get_sector_data_pool_statistics(
+     libbde_volume_t *volume,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error )
 {
-	static char *function = "libbde_volume_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_sector_data_pool_statistics";
+	int result                                = 1;
 
-	if( libbde_volume_seek_offset(
-	     volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libbde_volume_write_buffer(
-	               volume,
-	               buffer,
-	               buffer_size,
-	               error );
+	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( write_count < 0 )
+	if( number_of_allocations == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of allocations.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
-}
-
-#endif /* TODO_WRITE_SUPPORT */
-
-/* Seeks a certain offset of the (volume) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libbde_internal_volume_seek_offset(
-         libbde_internal_volume_t *internal_volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	static char *function = "libbde_internal_volume_seek_offset";
-
-	if( internal_volume == NULL )
+	if( number_of_reuses == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid number of reuses.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+#endif
+	if( internal_volume->sector_data_pool == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
+		*number_of_allocations = 0;
+		*number_of_reuses      = 0;
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	else if( libbde_sector_data_pool_get_statistics(
+	          internal_volume->sector_data_pool,
+	          number_of_allocations,
+	          number_of_reuses,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sector data pool statistics.",
 		 function );
 
-		return( -1 );
-	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_volume->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_volume->io_handle->volume_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking volume data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
+		result = -1;
 	}
-#endif
-	if( offset < 0 )
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume->current_offset = offset;
-
-	return( offset );
+#endif
+	return( result );
 }
 
-/* Seeks a certain offset of the data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the optimal IO size
+ * Reads of at least the optimal IO size at an offset that is a multiple
+ * of the optimal IO size are decrypted directly into the buffer
+ * Returns 1 if successful or -1 on error
  */
-off64_t libbde_volume_seek_offset(
-         libbde_volume_t *volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libbde_volume_get_optimal_io_size(
+     libbde_volume_t *volume,
+     size_t *io_size,
+     libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_seek_offset";
+	static char *function                     = "libbde_volume_get_optimal_io_size";
+	int result                                = 1;
 
 	if( volume == NULL )
 	{
@@ -2485,19 +8361,19 @@ off64_t libbde_volume_seek_offset(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( io_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2505,31 +8381,35 @@ off64_t libbde_volume_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libbde_internal_volume_seek_offset(
-	          internal_volume,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( internal_volume->sectors_cache_block_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing sectors cache block size.",
 		 function );
 
-		offset = -1;
+		result = -1;
+	}
+	else
+	{
+		*io_size = internal_volume->sectors_cache_block_size;
+
+		if( *io_size < ( 2 * (size_t) internal_volume->io_handle->bytes_per_sector ) )
+		{
+			*io_size = 2 * (size_t) internal_volume->io_handle->bytes_per_sector;
+		}
 	}
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2537,25 +8417,25 @@ off64_t libbde_volume_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( result );
 }
 
-/* Retrieves the current offset of the (volume) data
+/* Retrieves the encryption method
  * Returns 1 if successful or -1 on error
  */
-int libbde_volume_get_offset(
+int libbde_volume_get_encryption_method(
      libbde_volume_t *volume,
-     off64_t *offset,
+     uint16_t *encryption_method,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_offset";
+	static char *function                     = "libbde_volume_get_encryption_method";
 
 	if( volume == NULL )
 	{
@@ -2570,24 +8450,13 @@ int libbde_volume_get_offset(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( offset == NULL )
+	if( encryption_method == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid encryption method.",
 		 function );
 
 		return( -1 );
@@ -2607,7 +8476,7 @@ int libbde_volume_get_offset(
 		return( -1 );
 	}
 #endif
-	*offset = internal_volume->current_offset;
+	*encryption_method = internal_volume->encryption_method;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -2627,16 +8496,20 @@ int libbde_volume_get_offset(
 	return( 1 );
 }
 
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
+/* Retrieves the volume identifier
+ * The identifier is a GUID and is 16 bytes of size
+ * Returns 1 if successful, 0 if not or or -1 on error
  */
-int libbde_volume_get_size(
+int libbde_volume_get_volume_identifier(
      libbde_volume_t *volume,
-     size64_t *size,
+     uint8_t *volume_identifier,
+     size_t size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_size";
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_volume_identifier";
+	int result                                = 1;
 
 	if( volume == NULL )
 	{
@@ -2651,28 +8524,94 @@ int libbde_volume_get_size(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_volume_identifier(
+	          metadata,
+	          volume_identifier,
+	          size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume identifier from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the creation date and time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_creation_time(
+     libbde_volume_t *volume,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_creation_time";
+	int result                                = 1;
+
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -2688,8 +8627,34 @@ int libbde_volume_get_size(
 		return( -1 );
 	}
 #endif
-	*size = internal_volume->io_handle->volume_size;
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_creation_time(
+	          metadata,
+	          filetime,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time from primary metadata.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -2705,19 +8670,22 @@ int libbde_volume_get_size(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the encryption method
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-8 string size of the volume description
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
  */
-int libbde_volume_get_encryption_method(
+int libbde_volume_get_utf8_description_size(
      libbde_volume_t *volume,
-     uint16_t *encryption_method,
+     size_t *utf8_string_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_encryption_method";
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_utf8_description_size";
+	int result                                = 1;
 
 	if( volume == NULL )
 	{
@@ -2732,17 +8700,6 @@ int libbde_volume_get_encryption_method(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( encryption_method == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -2758,8 +8715,34 @@ int libbde_volume_get_encryption_method(
 		return( -1 );
 	}
 #endif
-	*encryption_method = internal_volume->encryption_method;
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_utf8_description_size(
+	          metadata,
+	          utf8_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 description size from primary metadata.",
+		 function );
 
+		result = -1;
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -2775,22 +8758,23 @@ int libbde_volume_get_encryption_method(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 }
 
-/* Retrieves the volume identifier
- * The identifier is a GUID and is 16 bytes of size
- * Returns 1 if successful, 0 if not or or -1 on error
+/* Retrieves the UTF-8 string value of the volume description
+ * The function uses a codepage if necessary, it uses the codepage set for the library
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
  */
-int libbde_volume_get_volume_identifier(
+int libbde_volume_get_utf8_description(
      libbde_volume_t *volume,
-     uint8_t *volume_identifier,
-     size_t size,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
 	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_volume_identifier";
+	static char *function                     = "libbde_volume_get_utf8_description";
 	int result                                = 1;
 
 	if( volume == NULL )
@@ -2835,17 +8819,17 @@ int libbde_volume_get_volume_identifier(
 	{
 		result = 0;
 	}
-	else if( libbde_metadata_get_volume_identifier(
+	else if( libbde_metadata_get_utf8_description(
 	          metadata,
-	          volume_identifier,
-	          size,
+	          utf8_string,
+	          utf8_string_size,
 	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume identifier from primary metadata.",
+		 "%s: unable to retrieve UTF-8 description from primary metadata.",
 		 function );
 
 		result = -1;
@@ -2868,17 +8852,18 @@ int libbde_volume_get_volume_identifier(
 	return( result );
 }
 
-/* Retrieves the creation date and time
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-16 string size of the volume description
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
  */
-int libbde_volume_get_creation_time(
+int libbde_volume_get_utf16_description_size(
      libbde_volume_t *volume,
-     uint64_t *filetime,
+     size_t *utf16_string_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
 	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_creation_time";
+	static char *function                     = "libbde_volume_get_utf16_description_size";
 	int result                                = 1;
 
 	if( volume == NULL )
@@ -2923,16 +8908,16 @@ int libbde_volume_get_creation_time(
 	{
 		result = 0;
 	}
-	else if( libbde_metadata_get_creation_time(
+	else if( libbde_metadata_get_utf16_description_size(
 	          metadata,
-	          filetime,
+	          utf16_string_size,
 	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve creation time from primary metadata.",
+		 "%s: unable to retrieve UTF-16 description size from primary metadata.",
 		 function );
 
 		result = -1;
@@ -2955,18 +8940,20 @@ int libbde_volume_get_creation_time(
 	return( result );
 }
 
-/* Retrieves the UTF-8 string size of the volume description
- * The returned size includes the end of string character
+/* Retrieves the UTF-16 string value of the volume description
+ * The function uses a codepage if necessary, it uses the codepage set for the library
+ * The size should include the end of string character
  * Returns 1 if successful, 0 if not or -1 on error
  */
-int libbde_volume_get_utf8_description_size(
+int libbde_volume_get_utf16_description(
      libbde_volume_t *volume,
-     size_t *utf8_string_size,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
 	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf8_description_size";
+	static char *function                     = "libbde_volume_get_utf16_description";
 	int result                                = 1;
 
 	if( volume == NULL )
@@ -3011,16 +8998,17 @@ int libbde_volume_get_utf8_description_size(
 	{
 		result = 0;
 	}
-	else if( libbde_metadata_get_utf8_description_size(
+	else if( libbde_metadata_get_utf16_description(
 	          metadata,
-	          utf8_string_size,
+	          utf16_string,
+	          utf16_string_size,
 	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 description size from primary metadata.",
+		 "%s: unable to retrieve UTF-16 description from primary metadata.",
 		 function );
 
 		result = -1;
@@ -3043,20 +9031,17 @@ int libbde_volume_get_utf8_description_size(
 	return( result );
 }
 
-/* Retrieves the UTF-8 string value of the volume description
- * The function uses a codepage if necessary, it uses the codepage set for the library
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves the number of volume master key protectors
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_get_utf8_description(
+int libbde_volume_get_number_of_key_protectors(
      libbde_volume_t *volume,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
+     int *number_of_key_protectors,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
 	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf8_description";
+	static char *function                     = "libbde_volume_get_number_of_key_protectors";
 	int result                                = 1;
 
 	if( volume == NULL )
@@ -3101,17 +9086,16 @@ int libbde_volume_get_utf8_description(
 	{
 		result = 0;
 	}
-	else if( libbde_metadata_get_utf8_description(
+	else if( libbde_metadata_get_number_of_volume_master_keys(
 	          metadata,
-	          utf8_string,
-	          utf8_string_size,
+	          number_of_key_protectors,
 	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 description from primary metadata.",
+		 "%s: unable to retrieve number of volume master key from primary metadata.",
 		 function );
 
 		result = -1;
@@ -3134,19 +9118,20 @@ int libbde_volume_get_utf8_description(
 	return( result );
 }
 
-/* Retrieves the UTF-16 string size of the volume description
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves a specific volume master key protector
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_get_utf16_description_size(
+int libbde_volume_get_key_protector(
      libbde_volume_t *volume,
-     size_t *utf16_string_size,
+     int key_protector_index,
+     libbde_key_protector_t **key_protector,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf16_description_size";
-	int result                                = 1;
+	libbde_internal_volume_t *internal_volume     = NULL;
+	libbde_metadata_t *metadata                   = NULL;
+	libbde_volume_master_key_t *volume_master_key = NULL;
+	static char *function                         = "libbde_volume_get_key_protector";
+	int result                                    = 1;
 
 	if( volume == NULL )
 	{
@@ -3190,20 +9175,39 @@ int libbde_volume_get_utf16_description_size(
 	{
 		result = 0;
 	}
-	else if( libbde_metadata_get_utf16_description_size(
+	else if( libbde_metadata_get_volume_master_key_by_index(
 	          metadata,
-	          utf16_string_size,
+	          key_protector_index,
+	          &volume_master_key,
 	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 description size from primary metadata.",
-		 function );
+		 "%s: unable to retrieve volume master key: %d from primary metadata.",
+		 function,
+		 key_protector_index );
 
 		result = -1;
 	}
+	if( result == 1 )
+	{
+		if( libbde_key_protector_initialize(
+		     key_protector,
+		     volume_master_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create key protector.",
+			 function );
+
+			result = -1;
+		}
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -3222,21 +9226,19 @@ int libbde_volume_get_utf16_description_size(
 	return( result );
 }
 
-/* Retrieves the UTF-16 string value of the volume description
- * The function uses a codepage if necessary, it uses the codepage set for the library
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+/* Retrieves the volume master key
+ * The volume master key can be used to unlock the volume without a key protector
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libbde_volume_get_utf16_description(
+int libbde_volume_get_volume_master_key(
      libbde_volume_t *volume,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     uint8_t *volume_master_key,
+     size_t volume_master_key_size,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf16_description";
-	int result                                = 1;
+	static char *function                     = "libbde_volume_get_volume_master_key";
+	int result                                = 0;
 
 	if( volume == NULL )
 	{
@@ -3251,49 +9253,96 @@ int libbde_volume_get_utf16_description(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
+	if( volume_master_key == NULL )
 	{
-		metadata = internal_volume->secondary_metadata;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume master key.",
+		 function );
+
+		return( -1 );
 	}
-	if( metadata == NULL )
+	if( volume_master_key_size > (size_t) SSIZE_MAX )
 	{
-		metadata = internal_volume->tertiary_metadata;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid volume master key size value exceeds maximum.",
+		 function );
+
+		return( -1 );
 	}
-	if( metadata == NULL )
+	if( volume_master_key_size < 32 )
 	{
-		result = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid volume master key value too small.",
+		 function );
+
+		return( -1 );
 	}
-	else if( libbde_metadata_get_utf16_description(
-	          metadata,
-	          utf16_string,
-	          utf16_string_size,
-	          error ) != 1 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 description from primary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		result = -1;
+		return( -1 );
+	}
+#endif
+	if( internal_volume->io_handle->volume_master_key_is_set != 0 )
+	{
+		if( memory_set(
+		     volume_master_key,
+		     0,
+		     volume_master_key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     volume_master_key,
+		     internal_volume->io_handle->volume_master_key,
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3311,20 +9360,37 @@ int libbde_volume_get_utf16_description(
 	}
 #endif
 	return( result );
+
+on_error:
+	memory_set(
+	 volume_master_key,
+	 0,
+	 volume_master_key_size );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the number of volume master key protectors
- * Returns 1 if successful or -1 on error
+/* Retrieves the keys
+ * The keys are stored in the buffers starting with the first byte, the remaining bytes are set to 0
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libbde_volume_get_number_of_key_protectors(
+int libbde_volume_get_keys(
      libbde_volume_t *volume,
-     int *number_of_key_protectors,
+     uint8_t *full_volume_encryption_key,
+     size_t full_volume_encryption_key_size,
+     uint8_t *tweak_key,
+     size_t tweak_key_size,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_number_of_key_protectors";
-	int result                                = 1;
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_internal_volume_t *internal_volume       = NULL;
+	static char *function                           = "libbde_volume_get_keys";
+	int result                                      = 0;
 
 	if( volume == NULL )
 	{
@@ -3339,95 +9405,61 @@ int libbde_volume_get_number_of_key_protectors(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
-	}
-	else if( libbde_metadata_get_number_of_volume_master_keys(
-	          metadata,
-	          number_of_key_protectors,
-	          error ) != 1 )
+	if( full_volume_encryption_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of volume master key from primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid full volume encryption key.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( full_volume_encryption_key_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid full volume encryption key size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak key.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves a specific volume master key protector
- * Returns 1 if successful or -1 on error
- */
-int libbde_volume_get_key_protector(
-     libbde_volume_t *volume,
-     int key_protector_index,
-     libbde_key_protector_t **key_protector,
-     libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume     = NULL;
-	libbde_metadata_t *metadata                   = NULL;
-	libbde_volume_master_key_t *volume_master_key = NULL;
-	static char *function                         = "libbde_volume_get_key_protector";
-	int result                                    = 1;
-
-	if( volume == NULL )
+	if( tweak_key_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid tweak key size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
@@ -3443,52 +9475,80 @@ int libbde_volume_get_key_protector(
 		return( -1 );
 	}
 #endif
-	metadata = internal_volume->primary_metadata;
+	encryption_context = internal_volume->io_handle->encryption_context;
 
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
-	}
-	else if( libbde_metadata_get_volume_master_key_by_index(
-	          metadata,
-	          key_protector_index,
-	          &volume_master_key,
-	          error ) != 1 )
+	if( ( internal_volume->is_locked == 0 )
+	 && ( encryption_context != NULL ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume master key: %d from primary metadata.",
-		 function,
-		 key_protector_index );
+		if( ( full_volume_encryption_key_size < encryption_context->full_volume_encryption_key_size )
+		 || ( tweak_key_size < encryption_context->tweak_key_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+			 "%s: invalid full volume encryption key or tweak key value too small.",
+			 function );
 
-		result = -1;
-	}
-	if( result == 1 )
-	{
-		if( libbde_key_protector_initialize(
-		     key_protector,
-		     volume_master_key,
-		     error ) != 1 )
+			goto on_error;
+		}
+		if( memory_set(
+		     full_volume_encryption_key,
+		     0,
+		     full_volume_encryption_key_size ) == NULL )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create key protector.",
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear full volume encryption key.",
 			 function );
 
-			result = -1;
+			goto on_error;
+		}
+		if( memory_copy(
+		     full_volume_encryption_key,
+		     encryption_context->full_volume_encryption_key,
+		     encryption_context->full_volume_encryption_key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy full volume encryption key.",
+			 function );
+
+			goto on_error;
 		}
+		if( memory_set(
+		     tweak_key,
+		     0,
+		     tweak_key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear tweak key.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     tweak_key,
+		     encryption_context->tweak_key,
+		     encryption_context->tweak_key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy tweak key.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3506,6 +9566,24 @@ int libbde_volume_get_key_protector(
 	}
 #endif
 	return( result );
+
+on_error:
+	memory_set(
+	 full_volume_encryption_key,
+	 0,
+	 full_volume_encryption_key_size );
+
+	memory_set(
+	 tweak_key,
+	 0,
+	 tweak_key_size );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
 /* Sets the keys
@@ -3739,6 +9817,140 @@ on_error:
 	return( -1 );
 }
 
+/* Sets the volume master key
+ * This function needs to be used before one of the open functions
+ * The volume master key takes precedence over the key protectors, which
+ * are only used when the volume master key does not match the volume
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_volume_master_key(
+     libbde_volume_t *volume,
+     const uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_volume_master_key";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume master key.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported volume master key size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( memory_copy(
+	     internal_volume->io_handle->volume_master_key,
+	     volume_master_key,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume master key.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->io_handle->volume_master_key_is_set = 1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	memory_set(
+	 internal_volume->io_handle->volume_master_key,
+	 0,
+	 32 );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
 /* Sets an UTF-8 formatted password
  * This function needs to be used before one of the open functions
  * Returns 1 if successful, 0 if password is invalid or -1 on error
@@ -25,21 +25,45 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbde_definitions.h"
+#include "libbde_encryption.h"
 #include "libbde_extern.h"
 #include "libbde_io_handle.h"
+#include "libbde_io_uring.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcthreads.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
 #include "libbde_metadata.h"
 #include "libbde_password_keep.h"
+#include "libbde_sector_data_pool.h"
+#include "libbde_sectors_cache.h"
 #include "libbde_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+typedef struct libbde_decryption_job libbde_decryption_job_t;
+
+struct libbde_decryption_job
+{
+	/* The physical offset of the sectors run
+	 */
+	off64_t physical_offset;
+
+	/* The encrypted data
+	 */
+	const uint8_t *encrypted_data;
+
+	/* The (decrypted) data
+	 */
+	uint8_t *data;
+
+	/* The size of the sectors run
+	 */
+	size_t run_size;
+};
+
 typedef struct libbde_internal_volume libbde_internal_volume_t;
 
 struct libbde_internal_volume
@@ -68,13 +92,29 @@ struct libbde_internal_volume
 	 */
 	libbde_metadata_t *external_key_metadata;
 
-	/* The sectors vector
+	/* The sectors cache
+	 */
+	libbde_sectors_cache_t *sectors_cache;
+
+	/* The (maximum) cache size
 	 */
-	libfdata_vector_t *sectors_vector;
+	size64_t cache_size;
 
-	/* The sectors cache
+	/* The cache block size, where 0 represents the cluster block size
 	 */
-	libfcache_cache_t *sectors_cache;
+	size_t cache_block_size;
+
+	/* The block size of the sectors cache entries
+	 */
+	size_t sectors_cache_block_size;
+
+	/* The sector data pool
+	 */
+	libbde_sector_data_pool_t *sector_data_pool;
+
+	/* The sectors run data
+	 */
+	uint8_t *sectors_run_data;
 
 	/* The file IO handle
 	 */
@@ -92,6 +132,26 @@ struct libbde_internal_volume
 	 */
 	uint8_t file_io_handle_opened_in_library;
 
+	/* The file IO pool, where every entry is a file IO handle of the same volume
+	 */
+	libbfio_pool_t *file_io_pool;
+
+	/* The number of file IO pool entries
+	 */
+	int number_of_file_io_pool_entries;
+
+	/* Values to indicate if the file IO pool entries were opened inside the library
+	 */
+	uint8_t *file_io_pool_entries_opened_in_library;
+
+	/* The data of the volume file mapped into memory by the library
+	 */
+	uint8_t *memory_mapped_data;
+
+	/* The size of the memory mapped data
+	 */
+	size_t memory_mapped_data_size;
+
 	/* The password keep
 	 */
 	libbde_password_keep_t *password_keep;
@@ -100,10 +160,125 @@ struct libbde_internal_volume
 	 */
 	uint8_t is_locked;
 
+	/* The readahead depth in number of cache blocks, where 0 disables readahead
+	 */
+	int readahead_depth;
+
+	/* The offset directly after the last read
+	 */
+	off64_t last_read_end_offset;
+
+	/* The number of consecutive sequential reads
+	 */
+	int number_of_sequential_reads;
+
+	/* The number of threads used to decrypt large reads, where 0 or 1 represents
+	 * the sectors are decrypted by the reading thread
+	 */
+	int number_of_threads;
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
 	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The readahead thread
+	 */
+	libcthreads_thread_t *readahead_thread;
+
+	/* The readahead mutex, which protects the readahead values below
+	 */
+	libcthreads_mutex_t *readahead_mutex;
+
+	/* The readahead condition
+	 */
+	libcthreads_condition_t *readahead_condition;
+
+	/* The offset of the next block to read ahead
+	 */
+	off64_t readahead_offset;
+
+	/* The offset where the readahead stops
+	 */
+	off64_t readahead_end_offset;
+
+	/* The block size used by the readahead
+	 */
+	size_t readahead_block_size;
+
+	/* Value to indicate the readahead thread should stop
+	 */
+	uint8_t readahead_stop;
+
+	/* The io_uring used by the readahead thread, which is NULL if not available
+	 */
+	libbde_io_uring_t *io_uring;
+
+	/* The shared read mutex, which protects the sectors cache, the sector data pool
+	 * and the free encryption contexts when reading with a shared lock
+	 */
+	libcthreads_mutex_t *shared_read_mutex;
+
+	/* The free encryption contexts of reads with a shared lock
+	 */
+	libbde_encryption_context_t *free_encryption_contexts[ LIBBDE_MAXIMUM_NUMBER_OF_FREE_ENCRYPTION_CONTEXTS ];
+
+	/* The number of free encryption contexts
+	 */
+	int number_of_free_encryption_contexts;
+
+	/* The free file IO pool entries of reads with a shared lock
+	 */
+	int *free_file_io_pool_entries;
+
+	/* The number of free file IO pool entries
+	 */
+	int number_of_free_file_io_pool_entries;
+
+	/* The decryption threads
+	 */
+	libcthreads_thread_t *decryption_threads[ LIBBDE_MAXIMUM_NUMBER_OF_THREADS ];
+
+	/* The number of decryption threads
+	 */
+	int number_of_decryption_threads;
+
+	/* The decryption mutex, which protects the decryption values below
+	 */
+	libcthreads_mutex_t *decryption_mutex;
+
+	/* The decryption condition, which is signalled when a job is queued
+	 * or the decryption threads should stop
+	 */
+	libcthreads_condition_t *decryption_condition;
+
+	/* The decryption done condition, which is signalled when a job is finished
+	 */
+	libcthreads_condition_t *decryption_done_condition;
+
+	/* The queued decryption jobs
+	 */
+	libbde_decryption_job_t decryption_jobs[ LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_JOBS ];
+
+	/* The index of the first queued decryption job
+	 */
+	int first_decryption_job_index;
+
+	/* The number of queued decryption jobs
+	 */
+	int number_of_queued_decryption_jobs;
+
+	/* The number of decryption jobs that are queued or in progress
+	 */
+	int number_of_pending_decryption_jobs;
+
+	/* The number of decryption jobs that failed
+	 */
+	int number_of_failed_decryption_jobs;
+
+	/* Value to indicate the decryption threads should stop
+	 */
+	uint8_t decryption_stop;
 #endif
 };
 
@@ -147,6 +322,34 @@ int libbde_volume_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_open_file_io_pool(
+     libbde_volume_t *volume,
+     libbfio_pool_t *file_io_pool,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_close_file_io_pool(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_open_memory(
+     libbde_volume_t *volume,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_map_file(
+     libbde_internal_volume_t *internal_volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_unmap_file(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_close(
      libbde_volume_t *volume,
@@ -155,6 +358,117 @@ int libbde_volume_close(
 int libbde_volume_open_read(
      libbde_internal_volume_t *internal_volume,
      libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libcerror_error_t **error );
+
+int libbde_volume_open_read_metadata(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t file_offset,
+     libbde_metadata_t **metadata,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_initialize_sectors_cache(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_free_sectors_cache(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_read_sector_data(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_offset,
+     libbde_sector_data_t **sector_data,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_get_uncached_run_size(
+     libbde_internal_volume_t *internal_volume,
+     off64_t offset,
+     size_t maximum_run_size,
+     size_t *run_size,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_get_encryption_context(
+     libbde_internal_volume_t *internal_volume,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_release_encryption_context(
+     libbde_internal_volume_t *internal_volume,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_free_encryption_contexts(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_get_file_io_pool_entry(
+     libbde_internal_volume_t *internal_volume,
+     int *file_io_pool_entry,
+     libbfio_handle_t **file_io_handle,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_release_file_io_pool_entry(
+     libbde_internal_volume_t *internal_volume,
+     int *file_io_pool_entry,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_update_readahead(
+     libbde_internal_volume_t *internal_volume,
+     off64_t read_offset,
+     size_t read_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+
+int libbde_internal_volume_start_readahead(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_stop_readahead(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_readahead_thread_callback(
+     void *arguments );
+
+int libbde_internal_volume_start_decryption_threads(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_stop_decryption_threads(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_decryption_thread_callback(
+     void *arguments );
+
+int libbde_internal_volume_push_decryption_job(
+     libbde_internal_volume_t *internal_volume,
+     off64_t physical_offset,
+     const uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t run_size,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_wait_for_decryption_jobs(
+     libbde_internal_volume_t *internal_volume,
+     libcerror_error_t **error );
+
+int libbde_internal_volume_read_sectors_multi_threaded(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     off64_t sectors_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
+
+int libbde_internal_volume_calculate_stretched_keys(
+     libbde_internal_volume_t *internal_volume,
      libcerror_error_t **error );
 
 int libbde_volume_open_read_keys_from_metadata(
@@ -189,6 +503,22 @@ ssize_t libbde_volume_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
+ssize_t libbde_internal_volume_pread_buffer_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+ssize_t libbde_volume_pread_buffer(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 #ifdef TODO_WRITE_SUPPORT
 
 LIBBDE_EXTERN \
@@ -233,6 +563,67 @@ int libbde_volume_get_size(
      size64_t *size,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_get_cache_size(
+     libbde_volume_t *volume,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_cache_size(
+     libbde_volume_t *volume,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_cache_block_size(
+     libbde_volume_t *volume,
+     size_t *cache_block_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_cache_block_size(
+     libbde_volume_t *volume,
+     size_t cache_block_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_readahead_depth(
+     libbde_volume_t *volume,
+     int *readahead_depth,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_readahead_depth(
+     libbde_volume_t *volume,
+     int readahead_depth,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_number_of_threads(
+     libbde_volume_t *volume,
+     int *number_of_threads,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_number_of_threads(
+     libbde_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_sector_data_pool_statistics(
+     libbde_volume_t *volume,
+     uint64_t *number_of_allocations,
+     uint64_t *number_of_reuses,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_optimal_io_size(
+     libbde_volume_t *volume,
+     size_t *io_size,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_get_encryption_method(
      libbde_volume_t *volume,
@@ -291,6 +682,22 @@ int libbde_volume_get_key_protector(
      libbde_key_protector_t **key_protector,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_get_volume_master_key(
+     libbde_volume_t *volume,
+     uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_keys(
+     libbde_volume_t *volume,
+     uint8_t *full_volume_encryption_key,
+     size_t full_volume_encryption_key_size,
+     uint8_t *tweak_key,
+     size_t tweak_key_size,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_set_keys(
      libbde_volume_t *volume,
@@ -300,6 +707,13 @@ int libbde_volume_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_set_volume_master_key(
+     libbde_volume_t *volume,
+     const uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_set_utf8_password(
      libbde_volume_t *volume,
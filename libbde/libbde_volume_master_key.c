@@ -106,20 +106,6 @@ int libbde_volume_master_key_initialize(
 
 		return( -1 );
 	}
-	if( libcdata_array_initialize(
-	     &( ( *volume_master_key )->entries_array ),
-	     0,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create entries array.",
-		 function );
-
-		goto on_error;
-	}
 	return( 1 );
 
 on_error:
@@ -204,19 +190,10 @@ int libbde_volume_master_key_free(
 				result = -1;
 			}
 		}
-		if( libcdata_array_free(
-		     &( ( *volume_master_key )->entries_array ),
-		     (int(*)(intptr_t **, libcerror_error_t **)) &libbde_metadata_entry_free,
-		     error ) != 1 )
+		if( ( *volume_master_key )->entries != NULL )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free entries array.",
-			 function );
-
-			result = -1;
+			memory_free(
+			 ( *volume_master_key )->entries );
 		}
 		memory_free(
 		 *volume_master_key );
@@ -238,11 +215,12 @@ int libbde_volume_master_key_read(
 	libbde_key_t *key                                     = NULL;
 	libbde_metadata_entry_t *property_metadata_entry      = NULL;
 	libbde_stretch_key_t *stretch_key                     = NULL;
-	uint8_t *value_data                                   = NULL;
+	const uint8_t *value_data                             = NULL;
 	static char *function                                 = "libbde_volume_master_key_read";
 	size_t value_data_size                                = 0;
 	ssize_t read_count                                    = 0;
 	int property_metadata_entry_index                     = 0;
+	int number_of_entries                                 = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	system_character_t filetime_string[ 32 ];
@@ -492,6 +470,24 @@ int libbde_volume_master_key_read(
 	value_data      += sizeof( bde_metadata_entry_volume_master_key_header_t );
 	value_data_size -= sizeof( bde_metadata_entry_volume_master_key_header_t );
 
+	if( libbde_metadata_entry_initialize_entries(
+	     &( volume_master_key->entries ),
+	     &number_of_entries,
+	     value_data,
+	     value_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create property metadata entries.",
+		 function );
+
+		goto on_error;
+	}
+	volume_master_key->number_of_entries = number_of_entries;
+
 	while( value_data_size >= sizeof( bde_metadata_entry_v1_t ) )
 	{
 		if( memory_compare(
@@ -501,19 +497,19 @@ int libbde_volume_master_key_read(
 		{
 			break;
 		}
-		if( libbde_metadata_entry_initialize(
-		     &property_metadata_entry,
-		     error ) != 1 )
+		if( property_metadata_entry_index >= number_of_entries )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create property metadata entry.",
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid property metadata entry index value out of bounds.",
 			 function );
 
 			goto on_error;
 		}
+		property_metadata_entry = &( volume_master_key->entries[ property_metadata_entry_index ] );
+
 		read_count = libbde_metadata_entry_read(
 			      property_metadata_entry,
 			      value_data,
@@ -712,22 +708,7 @@ int libbde_volume_master_key_read(
 				}
 			}
 		}
-		if( libcdata_array_append_entry(
-		     volume_master_key->entries_array,
-		     &property_metadata_entry_index,
-		     (intptr_t *) property_metadata_entry,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to append property metadata entry to entries array.",
-			 function );
-
-			goto on_error;
-		}
-		property_metadata_entry = NULL;
+		property_metadata_entry_index++;
 	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
@@ -779,12 +760,6 @@ on_error:
 		 &key,
 		 NULL );
 	}
-	if( property_metadata_entry != NULL )
-	{
-		libbde_metadata_entry_free(
-		 &property_metadata_entry,
-		 NULL );
-	}
 	return( -1 );
 }
 
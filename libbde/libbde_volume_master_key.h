@@ -54,6 +54,7 @@ struct libbde_volume_master_key
 	libbde_key_t *key;
 
 	/* The string metadata entry
+	 * references one of the entries
 	 */
 	libbde_metadata_entry_t *string_entry;
 
@@ -65,9 +66,14 @@ struct libbde_volume_master_key
 	 */
 	libbde_aes_ccm_encrypted_key_t *aes_ccm_encrypted_key;
 
-	/* The metadata entries array
+	/* The property metadata entries
+	 * stored as a single contiguous block
 	 */
-	libcdata_array_t *entries_array;
+	libbde_metadata_entry_t *entries;
+
+	/* The number of property metadata entries
+	 */
+	int number_of_entries;
 };
 
 int libbde_volume_master_key_initialize(
@@ -0,0 +1,134 @@
+dnl Functions for liburing
+dnl
+dnl Version: 20261016
+
+dnl Function to detect if liburing is available
+dnl ac_liburing_dummy is used to prevent AC_CHECK_LIB adding unnecessary -l<library> arguments
+AC_DEFUN([AX_LIBURING_CHECK_LIB],
+ [dnl Check if parameters were provided
+ AS_IF(
+  [test "x$ac_cv_with_liburing" != x && test "x$ac_cv_with_liburing" != xno && test "x$ac_cv_with_liburing" != xauto-detect],
+  [AS_IF(
+   [test -d "$ac_cv_with_liburing"],
+   [CFLAGS="$CFLAGS -I${ac_cv_with_liburing}/include"
+   LDFLAGS="$LDFLAGS -L${ac_cv_with_liburing}/lib"],
+   [AC_MSG_WARN([no such directory: $ac_cv_with_liburing])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_with_liburing" = xno || test "x$ac_cv_enable_winapi" = xyes],
+  [ac_cv_liburing=no],
+  [dnl Check for a pkg-config file
+  AS_IF(
+   [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
+   [PKG_CHECK_MODULES(
+    [liburing],
+    [liburing >= 2.0],
+    [ac_cv_liburing=liburing],
+    [ac_cv_liburing=no])
+   ])
+
+  AS_IF(
+   [test "x$ac_cv_liburing" = xliburing],
+   [ac_cv_liburing_CPPFLAGS="$pkg_cv_liburing_CFLAGS"
+   ac_cv_liburing_LIBADD="$pkg_cv_liburing_LIBS"],
+   [dnl Check for headers
+   AC_CHECK_HEADERS([liburing.h])
+
+   AS_IF(
+    [test "x$ac_cv_header_liburing_h" = xno],
+    [ac_cv_liburing=no],
+    [dnl Check for the individual functions
+    ac_cv_liburing=liburing
+
+    AC_CHECK_LIB(
+     uring,
+     io_uring_queue_init,
+     [ac_cv_liburing_dummy=yes],
+     [ac_cv_liburing=no])
+    AC_CHECK_LIB(
+     uring,
+     io_uring_queue_exit,
+     [ac_cv_liburing_dummy=yes],
+     [ac_cv_liburing=no])
+    AC_CHECK_LIB(
+     uring,
+     io_uring_submit,
+     [ac_cv_liburing_dummy=yes],
+     [ac_cv_liburing=no])
+
+    ac_cv_liburing_LIBADD="-luring";
+    ])
+   ])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_with_liburing" != xno && test "x$ac_cv_with_liburing" != xauto-detect && test "x$ac_cv_liburing" = xno],
+  [AC_MSG_FAILURE(
+   [liburing is required but not found],
+   [1])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_liburing" = xliburing],
+  [AC_DEFINE(
+   [HAVE_LIBURING],
+   [1],
+   [Define to 1 if you have the 'uring' library (-luring).])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_liburing" != xno],
+  [AC_SUBST(
+   [HAVE_LIBURING],
+   [1]) ],
+  [AC_SUBST(
+   [HAVE_LIBURING],
+   [0])
+  ])
+ ])
+
+dnl Function to detect how to enable liburing
+AC_DEFUN([AX_LIBURING_CHECK_ENABLE],
+ [AX_COMMON_ARG_WITH(
+  [liburing],
+  [liburing],
+  [search for liburing in includedir and libdir or in the specified DIR, or no if not to use liburing for asynchronous reads],
+  [auto-detect],
+  [DIR])
+
+ dnl Check for a shared library version
+ AX_LIBURING_CHECK_LIB
+
+ AS_IF(
+  [test "x$ac_cv_liburing_CPPFLAGS" != "x"],
+  [AC_SUBST(
+   [LIBURING_CPPFLAGS],
+   [$ac_cv_liburing_CPPFLAGS])
+  ])
+ AS_IF(
+  [test "x$ac_cv_liburing_LIBADD" != "x"],
+  [AC_SUBST(
+   [LIBURING_LIBADD],
+   [$ac_cv_liburing_LIBADD])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_liburing" = xliburing],
+  [AC_SUBST(
+   [ax_liburing_pc_libs_private],
+   [-luring])
+  ])
+
+ AS_IF(
+  [test "x$ac_cv_liburing" = xliburing],
+  [AC_SUBST(
+   [ax_liburing_spec_requires],
+   [liburing])
+  AC_SUBST(
+   [ax_liburing_spec_build_requires],
+   [liburing-devel])
+  ])
+ ])
+
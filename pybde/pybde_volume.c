@@ -153,6 +153,27 @@ PyMethodDef pybde_volume_object_methods[] = {
 	  "\n"
 	  "Retrieves the size of the volume data." },
 
+	{ "get_cache_size",
+	  (PyCFunction) pybde_volume_get_cache_size,
+	  METH_NOARGS,
+	  "get_cache_size() -> Integer\n"
+	  "\n"
+	  "Retrieves the size of the decrypted data cache in bytes." },
+
+	{ "set_cache_size",
+	  (PyCFunction) pybde_volume_set_cache_size,
+	  METH_VARARGS | METH_KEYWORDS,
+	  "set_cache_size(cache_size) -> None\n"
+	  "\n"
+	  "Sets the size of the decrypted data cache in bytes." },
+
+	{ "get_optimal_io_size",
+	  (PyCFunction) pybde_volume_get_optimal_io_size,
+	  METH_NOARGS,
+	  "get_optimal_io_size() -> Integer\n"
+	  "\n"
+	  "Retrieves the optimal IO size, reads of this size are decrypted directly into the buffer." },
+
 	{ "get_encryption_method",
 	  (PyCFunction) pybde_volume_get_encryption_method,
 	  METH_NOARGS,
@@ -234,6 +255,18 @@ PyGetSetDef pybde_volume_object_get_set_definitions[] = {
 	  "The size.",
 	  NULL },
 
+	{ "cache_size",
+	  (getter) pybde_volume_get_cache_size,
+	  (setter) 0,
+	  "The cache size.",
+	  NULL },
+
+	{ "optimal_io_size",
+	  (getter) pybde_volume_get_optimal_io_size,
+	  (setter) 0,
+	  "The optimal IO size.",
+	  NULL },
+
 	{ "encryption_method",
 	  (getter) pybde_volume_get_encryption_method,
 	  (setter) 0,
@@ -1448,6 +1481,170 @@ PyObject *pybde_volume_get_size(
 	return( integer_object );
 }
 
+/* Retrieves the cache size
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pybde_volume_get_cache_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments PYBDE_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pybde_volume_get_cache_size";
+	size64_t cache_size      = 0;
+	int result               = 0;
+
+	PYBDE_UNREFERENCED_PARAMETER( arguments )
+
+	if( pybde_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libbde_volume_get_cache_size(
+	          pybde_volume->volume,
+	          &cache_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pybde_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: failed to retrieve cache size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pybde_integer_unsigned_new_from_64bit(
+	                  (uint64_t) cache_size );
+
+	return( integer_object );
+}
+
+/* Sets the cache size
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pybde_volume_set_cache_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments,
+           PyObject *keywords )
+{
+	libcerror_error_t *error      = NULL;
+	static char *function         = "pybde_volume_set_cache_size";
+	static char *keyword_list[]   = { "cache_size", NULL };
+	unsigned long long cache_size = 0;
+	int result                    = 0;
+
+	if( pybde_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( NULL );
+	}
+	if( PyArg_ParseTupleAndKeywords(
+	     arguments,
+	     keywords,
+	     "K",
+	     keyword_list,
+	     &cache_size ) == 0 )
+	{
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libbde_volume_set_cache_size(
+	          pybde_volume->volume,
+	          (size64_t) cache_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pybde_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: unable to set cache size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	Py_IncRef(
+	 Py_None );
+
+	return( Py_None );
+}
+
+/* Retrieves the optimal IO size
+ * Returns a Python object if successful or NULL on error
+ */
+PyObject *pybde_volume_get_optimal_io_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments PYBDE_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	PyObject *integer_object = NULL;
+	static char *function    = "pybde_volume_get_optimal_io_size";
+	size_t io_size           = 0;
+	int result               = 0;
+
+	PYBDE_UNREFERENCED_PARAMETER( arguments )
+
+	if( pybde_volume == NULL )
+	{
+		PyErr_Format(
+		 PyExc_TypeError,
+		 "%s: invalid volume.",
+		 function );
+
+		return( NULL );
+	}
+	Py_BEGIN_ALLOW_THREADS
+
+	result = libbde_volume_get_optimal_io_size(
+	          pybde_volume->volume,
+	          &io_size,
+	          &error );
+
+	Py_END_ALLOW_THREADS
+
+	if( result != 1 )
+	{
+		pybde_error_raise(
+		 error,
+		 PyExc_IOError,
+		 "%s: failed to retrieve optimal IO size.",
+		 function );
+
+		libcerror_error_free(
+		 &error );
+
+		return( NULL );
+	}
+	integer_object = pybde_integer_unsigned_new_from_64bit(
+	                  (uint64_t) io_size );
+
+	return( integer_object );
+}
+
 /* Retrieves the encryption method
  * Returns a Python object if successful or NULL on error
  */
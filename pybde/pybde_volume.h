@@ -117,6 +117,19 @@ PyObject *pybde_volume_get_size(
            pybde_volume_t *pybde_volume,
            PyObject *arguments );
 
+PyObject *pybde_volume_get_cache_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments );
+
+PyObject *pybde_volume_set_cache_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments,
+           PyObject *keywords );
+
+PyObject *pybde_volume_get_optimal_io_size(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments );
+
 PyObject *pybde_volume_get_encryption_method(
            pybde_volume_t *pybde_volume,
            PyObject *arguments );
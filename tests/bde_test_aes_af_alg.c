@@ -0,0 +1,1493 @@
+/*
+ * Library Linux kernel crypto API (AF_ALG) AES functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_aes_af_alg.h"
+#include "../libbde/libbde_aes_ni.h"
+#include "../libbde/libbde_definitions.h"
+
+/* A single AES-ECB request is limited in size, the test data therefore
+ * is larger than a single request to test splitting the data into requests
+ */
+#define BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE	( 16 * 2600 )
+
+#define BDE_TEST_AES_AF_ALG_SECTOR_SIZE		512
+
+/* FIPS-197 appendix C.1 AES-128 key 0x00 - 0x0f with plaintext 0x00, 0x11, ..., 0xff
+ */
+uint8_t bde_test_aes_af_alg_ecb_128_ciphertext[ 16 ] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+/* FIPS-197 appendix C.3 AES-256 key 0x00 - 0x1f with plaintext 0x00, 0x11, ..., 0xff
+ */
+uint8_t bde_test_aes_af_alg_ecb_256_ciphertext[ 16 ] = {
+	0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+
+/* NIST SP 800-38A appendix F.2.6 CBC-AES256.Decrypt key
+ */
+uint8_t bde_test_aes_af_alg_cbc_256_key[ 32 ] = {
+	0x60, 0x3d, 0xeb, 0x10, 0x15, 0xca, 0x71, 0xbe, 0x2b, 0x73, 0xae, 0xf0, 0x85, 0x7d, 0x77, 0x81,
+	0x1f, 0x35, 0x2c, 0x07, 0x3b, 0x61, 0x08, 0xd7, 0x2d, 0x98, 0x10, 0xa3, 0x09, 0x14, 0xdf, 0xf4 };
+
+/* NIST SP 800-38A appendix F.2.6 CBC-AES256.Decrypt ciphertext with initialization vector 0x00 - 0x0f
+ */
+uint8_t bde_test_aes_af_alg_cbc_256_ciphertext[ 64 ] = {
+	0xf5, 0x8c, 0x4c, 0x04, 0xd6, 0xe5, 0xf1, 0xba, 0x77, 0x9e, 0xab, 0xfb, 0x5f, 0x7b, 0xfb, 0xd6,
+	0x9c, 0xfc, 0x4e, 0x96, 0x7e, 0xdb, 0x80, 0x8d, 0x67, 0x9f, 0x77, 0x7b, 0xc6, 0x70, 0x2c, 0x7d,
+	0x39, 0xf2, 0x33, 0x69, 0xa9, 0xd9, 0xba, 0xcf, 0xa5, 0x30, 0xe2, 0x63, 0x04, 0x23, 0x14, 0x61,
+	0xb2, 0xeb, 0x05, 0xe2, 0xc3, 0x9b, 0xe9, 0xfc, 0xda, 0x6c, 0x19, 0x07, 0x8c, 0x6a, 0x9d, 0x1b };
+
+/* NIST SP 800-38A appendix F.2.6 CBC-AES256.Decrypt plaintext
+ */
+uint8_t bde_test_aes_af_alg_cbc_256_plaintext[ 64 ] = {
+	0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+	0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+	0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+	0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+
+/* IEEE 1619 vector 2 XTS-AES-128 keys 0x11... and 0x22..., data unit sequence number 0x3333333333
+ * with plaintext 0x44...
+ */
+uint8_t bde_test_aes_af_alg_xts_128_ciphertext[ 32 ] = {
+	0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+	0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_aes_af_alg_context_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_context_initialize(
+     void )
+{
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_af_alg_context_initialize(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (libbde_aes_af_alg_context_t *) 0x12345678UL;
+
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	context = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_context_set_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_context_set_key(
+     void )
+{
+	uint8_t key[ 64 ];
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = memory_set(
+	          key,
+	          0x5a,
+	          64 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test replacing the key with a key of another cipher mode
+	 */
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS,
+	          key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_af_alg_context_set_key(
+	          NULL,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          -1,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_encrypt_ecb function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_encrypt_ecb(
+     void )
+{
+	uint8_t key[ 32 ];
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	uint8_t *data                        = NULL;
+	uint8_t *plaintext                   = NULL;
+	size_t data_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	data = (uint8_t *) memory_allocate(
+	                    sizeof( uint8_t ) * BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "data",
+	 data );
+
+	plaintext = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "plaintext",
+	 plaintext );
+
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE;
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( ( data_index % 16 ) * 0x11 );
+	}
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_af_alg_encrypt_ecb(
+	          context,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE;
+	     data_index += 16 )
+	{
+		result = memory_compare(
+		          &( data[ data_index ] ),
+		          bde_test_aes_af_alg_ecb_128_ciphertext,
+		          16 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test encryption with a 256-bit key
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_ECB,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_encrypt_ecb(
+	          context,
+	          plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_af_alg_ecb_256_ciphertext,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_af_alg_encrypt_ecb(
+	          NULL,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_encrypt_ecb(
+	          context,
+	          plaintext,
+	          15,
+	          data,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_encrypt_ecb(
+	          context,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_ECB_DATA_SIZE,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 plaintext );
+
+	memory_free(
+	 data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	if( plaintext != NULL )
+	{
+		memory_free(
+		 plaintext );
+	}
+	if( data != NULL )
+	{
+		memory_free(
+		 data );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_decrypt_cbc function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_decrypt_cbc(
+     void )
+{
+	uint8_t aes_ni_data[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+	uint8_t ciphertext[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+	uint8_t data[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+	uint8_t initialization_vectors[ 32 ];
+	uint8_t key[ 32 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 * The AES-NI functions are used as reference
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		initialization_vectors[ data_index ] = (uint8_t) ( data_index * 7 );
+		key[ data_index ]                    = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < ( BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 );
+	     data_index++ )
+	{
+		ciphertext[ data_index ] = (uint8_t) ( ( data_index * 31 ) ^ ( data_index >> 8 ) );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          aes_ni_data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption of two sectors, the result should match that of AES-NI
+	 */
+	result = libbde_aes_af_alg_decrypt_cbc(
+	          context,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          aes_ni_data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_af_alg_decrypt_cbc(
+	          NULL,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_decrypt_cbc(
+	          context,
+	          initialization_vectors,
+	          16,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_decrypt_cbc function with known answer test vectors
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_decrypt_cbc_known_answer(
+     void )
+{
+	uint8_t data[ 64 ];
+	uint8_t initialization_vector[ 16 ];
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		initialization_vector[ data_index ] = (uint8_t) data_index;
+	}
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_CBC,
+	          bde_test_aes_af_alg_cbc_256_key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption of a single 64-byte sector
+	 */
+	result = libbde_aes_af_alg_decrypt_cbc(
+	          context,
+	          initialization_vector,
+	          16,
+	          64,
+	          bde_test_aes_af_alg_cbc_256_ciphertext,
+	          64,
+	          data,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_af_alg_cbc_256_plaintext,
+	          64 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_crypt_xts function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_crypt_xts(
+     void )
+{
+	uint8_t aes_ni_data[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+	uint8_t data[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+	uint8_t key[ 64 ];
+	uint8_t plaintext[ BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+	libbde_aes_ni_key_schedule_t tweak_key_schedule;
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 * The AES-NI functions are used as reference
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < ( BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 );
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( ( data_index * 13 ) ^ ( data_index >> 8 ) );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &tweak_key_schedule,
+	          &( key[ 32 ] ),
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          aes_ni_data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS,
+	          key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test encryption of two sectors, the result should match that of AES-NI
+	 */
+	result = libbde_aes_af_alg_crypt_xts(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          aes_ni_data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decryption in-place with the same context
+	 */
+	result = libbde_aes_af_alg_crypt_xts(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_af_alg_crypt_xts(
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_af_alg_crypt_xts(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_AF_ALG_SECTOR_SIZE * 2,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_af_alg_crypt_xts function with known answer test vectors
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_af_alg_crypt_xts_known_answer(
+     void )
+{
+	uint8_t data[ 32 ];
+	uint8_t key[ 32 ];
+	uint8_t plaintext[ 32 ];
+
+	libbde_aes_af_alg_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_af_alg_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = memory_set(
+	          key,
+	          0x11,
+	          16 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          &( key[ 16 ] ),
+	          0x22,
+	          16 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_set(
+	          plaintext,
+	          0x44,
+	          32 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_aes_af_alg_context_initialize(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_af_alg_context_set_key(
+	          context,
+	          LIBBDE_AES_AF_ALG_CIPHER_MODE_XTS,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test encryption of a single 32-byte sector
+	 */
+	result = libbde_aes_af_alg_crypt_xts(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x3333333333ULL,
+	          32,
+	          plaintext,
+	          32,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_af_alg_xts_128_ciphertext,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decryption of a single 32-byte sector
+	 */
+	result = libbde_aes_af_alg_crypt_xts(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0x3333333333ULL,
+	          32,
+	          bde_test_aes_af_alg_xts_128_ciphertext,
+	          32,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plaintext,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libbde_aes_af_alg_context_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_aes_af_alg_context_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	/* TODO: add tests for libbde_aes_af_alg_is_supported */
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_context_initialize",
+	 bde_test_aes_af_alg_context_initialize );
+
+	/* TODO: add tests for libbde_aes_af_alg_context_free */
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_context_set_key",
+	 bde_test_aes_af_alg_context_set_key );
+
+	/* TODO: add tests for libbde_aes_af_alg_crypt_request */
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_encrypt_ecb",
+	 bde_test_aes_af_alg_encrypt_ecb );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_decrypt_cbc",
+	 bde_test_aes_af_alg_decrypt_cbc_known_answer );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_decrypt_cbc",
+	 bde_test_aes_af_alg_decrypt_cbc );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_crypt_xts",
+	 bde_test_aes_af_alg_crypt_xts_known_answer );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_af_alg_crypt_xts",
+	 bde_test_aes_af_alg_crypt_xts );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
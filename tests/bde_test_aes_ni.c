@@ -0,0 +1,987 @@
+/*
+ * Library AES-NI functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_aes_ni.h"
+#include "../libbde/libbde_definitions.h"
+
+/* FIPS-197 appendix C.1 AES-128 key 0x00 - 0x0f with plaintext 0x00, 0x11, ..., 0xff
+ */
+uint8_t bde_test_aes_ni_ecb_128_ciphertext[ 16 ] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+/* AES-128-CBC with the NIST SP 800-38A key, initialization vector 0x00 - 0x0f
+ * and plaintext bytes 0x00 - 0x7f
+ */
+uint8_t bde_test_aes_ni_cbc_128_key[ 16 ] = {
+	0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+
+uint8_t bde_test_aes_ni_cbc_128_ciphertext[ 128 ] = {
+	0x7d, 0xf7, 0x6b, 0x0c, 0x1a, 0xb8, 0x99, 0xb3, 0x3e, 0x42, 0xf0, 0x47, 0xb9, 0x1b, 0x54, 0x6f,
+	0x1c, 0xaa, 0x80, 0x18, 0xc8, 0x0b, 0x15, 0xb8, 0xe7, 0xae, 0xa8, 0x27, 0x94, 0xad, 0xcb, 0x00,
+	0xbb, 0xc1, 0xe2, 0x95, 0x91, 0x0b, 0x9d, 0xe4, 0xf1, 0x35, 0x8d, 0xcb, 0x42, 0x13, 0xbd, 0xd8,
+	0xee, 0xfa, 0x31, 0x54, 0x21, 0x5f, 0x47, 0x09, 0xaf, 0x46, 0x57, 0x3f, 0xc8, 0xcb, 0x07, 0xb9,
+	0x86, 0x0d, 0xc1, 0xdd, 0x67, 0xdd, 0xfd, 0x95, 0x2b, 0x41, 0xe3, 0xaa, 0x0c, 0xc4, 0x7a, 0x96,
+	0x48, 0x73, 0x85, 0x34, 0xd3, 0x7e, 0x5e, 0x29, 0xae, 0x21, 0x35, 0xaf, 0x75, 0x32, 0xe4, 0x1c,
+	0x14, 0x28, 0xb8, 0x47, 0xec, 0x62, 0x48, 0xfa, 0x03, 0x56, 0x8d, 0x55, 0x16, 0x3a, 0xa8, 0x98,
+	0x85, 0xe7, 0x57, 0xfd, 0x9c, 0x61, 0x99, 0x91, 0x78, 0xf9, 0x6a, 0x3c, 0x78, 0xf2, 0x6b, 0xef };
+
+/* IEEE P1619 XTS-AES-128 test vector 1, all zero keys, data unit sequence number 0
+ */
+uint8_t bde_test_aes_ni_xts_128_ciphertext[ 32 ] = {
+	0x91, 0x7c, 0xf6, 0x9e, 0xbd, 0x68, 0xb2, 0xec, 0x9b, 0x9f, 0xe9, 0xa3, 0xea, 0xdd, 0xa6, 0x92,
+	0xcd, 0x43, 0xd2, 0xf5, 0x95, 0x98, 0xed, 0x85, 0x8c, 0x02, 0xc2, 0x65, 0x2f, 0xbf, 0x92, 0x2e };
+
+/* XTS-AES-256 with key bytes 0x00 - 0x3f, data unit sequence number 0x123456789
+ * and plaintext bytes 0x00 - 0x7f
+ */
+uint8_t bde_test_aes_ni_xts_256_ciphertext[ 128 ] = {
+	0xdb, 0xe0, 0xe0, 0xe8, 0x54, 0xa3, 0x50, 0x5a, 0xa1, 0x43, 0x0b, 0x23, 0x04, 0xc0, 0x1c, 0x5c,
+	0xb7, 0x1d, 0xba, 0xc8, 0x4f, 0x8c, 0xed, 0x79, 0x7a, 0x87, 0x12, 0xed, 0xc7, 0xb3, 0xe3, 0x0b,
+	0x2b, 0x9c, 0xd4, 0x65, 0xfd, 0x22, 0xc4, 0x9b, 0x6e, 0x3d, 0x35, 0x5a, 0x77, 0xdd, 0x10, 0xfe,
+	0x98, 0x5b, 0xe7, 0x6a, 0x76, 0x9c, 0xc3, 0xea, 0x9c, 0x3e, 0x60, 0x6a, 0x37, 0x8d, 0x23, 0xc2,
+	0xbe, 0x69, 0x99, 0x55, 0x0c, 0x19, 0x18, 0xd9, 0xf1, 0x27, 0x2a, 0x86, 0xa0, 0xf8, 0xfe, 0xcf,
+	0x49, 0x80, 0xa0, 0xb0, 0xab, 0x8d, 0xae, 0xef, 0xec, 0xb5, 0x58, 0x0a, 0x9f, 0x22, 0x7c, 0x40,
+	0x78, 0xdf, 0xc3, 0x37, 0x9b, 0x3c, 0x61, 0x99, 0x4c, 0x6d, 0x87, 0x46, 0x32, 0xf0, 0xa3, 0xf7,
+	0x57, 0x3b, 0xa9, 0xd0, 0x8a, 0xb2, 0xee, 0x27, 0xcb, 0xa2, 0x25, 0xd5, 0x81, 0x6d, 0x5a, 0xcd };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_aes_ni_key_schedule_set_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_key_schedule_set_key(
+     void )
+{
+	uint8_t key[ 32 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = memory_set(
+	          key,
+	          0,
+	          32 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "key_schedule.number_of_rounds",
+	 key_schedule.number_of_rounds,
+	 10 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "key_schedule.number_of_rounds",
+	 key_schedule.number_of_rounds,
+	 14 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_key_schedule_set_key(
+	          NULL,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          NULL,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          192,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_encrypt_ecb function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_encrypt_ecb(
+     void )
+{
+	uint8_t data[ 16 * 9 ];
+	uint8_t key[ 16 ];
+	uint8_t plaintext[ 16 * 9 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	/* Use 9 identical blocks to test both the parallel and the single block code path
+	 */
+	for( data_index = 0;
+	     data_index < ( 16 * 9 );
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( ( data_index % 16 ) * 0x11 );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          16 * 9,
+	          data,
+	          16 * 9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < ( 16 * 9 );
+	     data_index += 16 )
+	{
+		result = memory_compare(
+		          &( data[ data_index ] ),
+		          bde_test_aes_ni_ecb_128_ciphertext,
+		          16 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_encrypt_ecb(
+	          NULL,
+	          plaintext,
+	          16 * 9,
+	          data,
+	          16 * 9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          15,
+	          data,
+	          16 * 9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          16 * 9,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_decrypt_cbc function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_decrypt_cbc(
+     void )
+{
+	uint8_t data[ 128 ];
+	uint8_t initialization_vectors[ 32 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		initialization_vectors[ data_index ] = (uint8_t) data_index;
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          bde_test_aes_ni_cbc_128_key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption of a 8 block sector
+	 */
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          16,
+	          128,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 128;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 (uint8_t) data_index );
+	}
+	/* Test in-place decryption of two 4 block sectors, where the initialization
+	 * vector of the second sector is the last encrypted block of the first sector
+	 */
+	result = memory_copy(
+	          &( initialization_vectors[ 16 ] ),
+	          &( bde_test_aes_ni_cbc_128_ciphertext[ 48 ] ),
+	          16 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = memory_copy(
+	          data,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          32,
+	          64,
+	          data,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 128;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 (uint8_t) data_index );
+	}
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_decrypt_cbc(
+	          NULL,
+	          initialization_vectors,
+	          16,
+	          128,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          NULL,
+	          16,
+	          128,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          16,
+	          64,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          16,
+	          100,
+	          bde_test_aes_ni_cbc_128_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_crypt_xts function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_crypt_xts(
+     void )
+{
+	uint8_t data[ 128 ];
+	uint8_t key[ 64 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+	libbde_aes_ni_key_schedule_t tweak_key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	result = memory_set(
+	          key,
+	          0,
+	          32 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &tweak_key_schedule,
+	          &( key[ 16 ] ),
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption of a 2 block sector with a 128-bit key
+	 */
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          32,
+	          bde_test_aes_ni_xts_128_ciphertext,
+	          32,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 0 );
+	}
+	/* Test decryption of two 4 block sectors with a 256-bit key
+	 * and of a 8 block sector which uses the parallel blocks code path
+	 */
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &tweak_key_schedule,
+	          &( key[ 32 ] ),
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0x123456789ULL,
+	          128,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 128;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 (uint8_t) data_index );
+	}
+	/* Test encryption in-place
+	 */
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x123456789ULL,
+	          128,
+	          data,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_crypt_xts(
+	          NULL,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          128,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          -1,
+	          0,
+	          128,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          100,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          128,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          112,
+	          data,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          128,
+	          bde_test_aes_ni_xts_256_ciphertext,
+	          128,
+	          data,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	/* TODO: add tests for libbde_aes_ni_is_supported */
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_key_schedule_set_key",
+	 bde_test_aes_ni_key_schedule_set_key );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_encrypt_ecb",
+	 bde_test_aes_ni_encrypt_ecb );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_decrypt_cbc",
+	 bde_test_aes_ni_decrypt_cbc );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_crypt_xts",
+	 bde_test_aes_ni_crypt_xts );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,672 @@
+/*
+ * Library VAES functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_aes_ni.h"
+#include "../libbde/libbde_aes_vaes.h"
+#include "../libbde/libbde_definitions.h"
+
+/* The VAES functions process 16 blocks at a time, the test data therefore
+ * contains more than 16 blocks to test both the wide and the single block code path
+ */
+#define BDE_TEST_AES_VAES_DATA_SIZE	( 16 * 37 )
+
+/* FIPS-197 appendix C.1 AES-128 key 0x00 - 0x0f with plaintext 0x00, 0x11, ..., 0xff
+ */
+uint8_t bde_test_aes_vaes_ecb_128_ciphertext[ 16 ] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_aes_vaes_encrypt_ecb function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_vaes_encrypt_ecb(
+     void )
+{
+	uint8_t data[ BDE_TEST_AES_VAES_DATA_SIZE ];
+	uint8_t key[ 16 ];
+	uint8_t plaintext[ BDE_TEST_AES_VAES_DATA_SIZE ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_vaes_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < BDE_TEST_AES_VAES_DATA_SIZE;
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( ( data_index % 16 ) * 0x11 );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_vaes_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < BDE_TEST_AES_VAES_DATA_SIZE;
+	     data_index += 16 )
+	{
+		result = memory_compare(
+		          &( data[ data_index ] ),
+		          bde_test_aes_vaes_ecb_128_ciphertext,
+		          16 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_aes_vaes_encrypt_ecb(
+	          NULL,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_vaes_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          15,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_vaes_encrypt_ecb(
+	          &key_schedule,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_vaes_decrypt_cbc function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_vaes_decrypt_cbc(
+     void )
+{
+	uint8_t aes_ni_data[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+	uint8_t ciphertext[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+	uint8_t data[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+	uint8_t initialization_vectors[ 32 ];
+	uint8_t key[ 32 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_vaes_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		initialization_vectors[ data_index ] = (uint8_t) ( data_index * 7 );
+		key[ data_index ]                    = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < ( BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+	     data_index++ )
+	{
+		ciphertext[ data_index ] = (uint8_t) ( ( data_index * 31 ) ^ ( data_index >> 8 ) );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          aes_ni_data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption of two sectors, the result should match that of AES-NI
+	 */
+	result = libbde_aes_vaes_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          aes_ni_data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place decryption
+	 */
+	result = memory_copy(
+	          data,
+	          ciphertext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_aes_vaes_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          aes_ni_data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_vaes_decrypt_cbc(
+	          NULL,
+	          initialization_vectors,
+	          32,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_vaes_decrypt_cbc(
+	          &key_schedule,
+	          initialization_vectors,
+	          16,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          ciphertext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_vaes_crypt_xts function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_vaes_crypt_xts(
+     void )
+{
+	uint8_t aes_ni_data[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+	uint8_t data[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+	uint8_t key[ 64 ];
+	uint8_t plaintext[ BDE_TEST_AES_VAES_DATA_SIZE * 2 ];
+
+	libbde_aes_ni_key_schedule_t key_schedule;
+	libbde_aes_ni_key_schedule_t tweak_key_schedule;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_aes_vaes_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < ( BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( ( data_index * 13 ) ^ ( data_index >> 8 ) );
+	}
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &key_schedule,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_key_schedule_set_key(
+	          &tweak_key_schedule,
+	          &( key[ 32 ] ),
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          aes_ni_data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test encryption of two sectors, the result should match that of AES-NI
+	 */
+	result = libbde_aes_vaes_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          aes_ni_data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decryption in-place
+	 */
+	result = libbde_aes_vaes_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0x123456789ULL,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_vaes_crypt_xts(
+	          NULL,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_vaes_crypt_xts(
+	          &key_schedule,
+	          &tweak_key_schedule,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0,
+	          BDE_TEST_AES_VAES_DATA_SIZE,
+	          plaintext,
+	          BDE_TEST_AES_VAES_DATA_SIZE * 2,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	/* TODO: add tests for libbde_aes_vaes_is_supported */
+
+	BDE_TEST_RUN(
+	 "libbde_aes_vaes_encrypt_ecb",
+	 bde_test_aes_vaes_encrypt_ecb );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_vaes_decrypt_cbc",
+	 bde_test_aes_vaes_decrypt_cbc );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_vaes_crypt_xts",
+	 bde_test_aes_vaes_crypt_xts );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,458 @@
+/*
+ * Library Elephant diffuser functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_diffuser.h"
+
+/* The result of Diffuser decryption of the data bytes 0x00 - 0x3f
+ */
+uint8_t bde_test_diffuser_decrypted_data[ 64 ] = {
+	0x7f, 0x84, 0x34, 0x97, 0x2d, 0x8b, 0x6c, 0xec, 0xd7, 0xf7, 0x8e, 0x5b, 0xc1, 0xb7, 0x50, 0xfe,
+	0xdc, 0xcb, 0x6f, 0x2b, 0xf1, 0x2c, 0x72, 0xc1, 0x71, 0xef, 0xc6, 0x3d, 0x55, 0x14, 0xd2, 0x6d,
+	0xc9, 0xd5, 0x12, 0x65, 0x0a, 0x61, 0xf0, 0xc2, 0x4e, 0xd3, 0xf4, 0xec, 0x56, 0x56, 0x59, 0x4c,
+	0xf2, 0x28, 0x6d, 0xb5, 0x0a, 0x9c, 0xca, 0x6a, 0x34, 0x0d, 0x3e, 0xd9, 0xa8, 0x63, 0xbd, 0xa9 };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_diffuser_decrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_diffuser_decrypt(
+     void )
+{
+	uint8_t data[ 64 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	result = libbde_diffuser_decrypt(
+	          data,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_decrypted_data,
+	          64 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test decryption of data that is not 32-bit aligned
+	 */
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		data[ data_index + 1 ] = (uint8_t) data_index;
+	}
+	result = libbde_diffuser_decrypt(
+	          &( data[ 1 ] ),
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          &( data[ 1 ] ),
+	          bde_test_diffuser_decrypted_data,
+	          64 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_diffuser_decrypt(
+	          NULL,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          60,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_diffuser_encrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_diffuser_encrypt(
+     void )
+{
+	uint8_t data[ 512 ];
+	uint8_t large_data[ 8192 ];
+	uint8_t unaligned_data[ 8192 + 1 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = memory_copy(
+	          data,
+	          bde_test_diffuser_decrypted_data,
+	          64 ) != NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libbde_diffuser_encrypt(
+	          data,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 (uint8_t) data_index );
+	}
+	/* Test that encryption reverses decryption of a sector
+	 */
+	for( data_index = 0;
+	     data_index < 512;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index * 7 );
+	}
+	result = libbde_diffuser_decrypt(
+	          data,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_diffuser_encrypt(
+	          data,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 512;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "data[ data_index ]",
+		 data[ data_index ],
+		 (uint8_t) ( data_index * 7 ) );
+	}
+	/* Test unaligned data that does not fit in the values buffer on the stack
+	 */
+	for( data_index = 0;
+	     data_index < 8192;
+	     data_index++ )
+	{
+		large_data[ data_index ]         = (uint8_t) ( data_index * 7 );
+		unaligned_data[ data_index + 1 ] = (uint8_t) ( data_index * 7 );
+	}
+	result = libbde_diffuser_decrypt(
+	          large_data,
+	          8192,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_diffuser_decrypt(
+	          &( unaligned_data[ 1 ] ),
+	          8192,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          &( unaligned_data[ 1 ] ),
+	          large_data,
+	          8192 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_diffuser_encrypt(
+	          &( unaligned_data[ 1 ] ),
+	          8192,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 8192;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "unaligned_data[ data_index + 1 ]",
+		 unaligned_data[ data_index + 1 ],
+		 (uint8_t) ( data_index * 7 ) );
+	}
+	/* Test error cases
+	 */
+	result = libbde_diffuser_encrypt(
+	          NULL,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_encrypt(
+	          data,
+	          60,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_diffuser_decrypt",
+	 bde_test_diffuser_decrypt );
+
+	/* TODO: add tests for libbde_diffuser_a_decrypt */
+
+	/* TODO: add tests for libbde_diffuser_b_decrypt */
+
+	BDE_TEST_RUN(
+	 "libbde_diffuser_encrypt",
+	 bde_test_diffuser_encrypt );
+
+	/* TODO: add tests for libbde_diffuser_a_encrypt */
+
+	/* TODO: add tests for libbde_diffuser_b_encrypt */
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,907 @@
+/*
+ * Library encryption functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_encryption.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_encryption_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_initialize(
+     void )
+{
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "context->engine",
+	 context->engine,
+	 LIBBDE_ENCRYPTION_ENGINE_FUSED );
+
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_initialize(
+	          NULL,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (libbde_encryption_context_t *) 0x12345678UL;
+
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = NULL;
+
+	result = libbde_encryption_initialize(
+	          &context,
+	          0xffff,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_set_engine function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_set_engine(
+     void )
+{
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_encryption_set_engine(
+	          context,
+	          LIBBDE_ENCRYPTION_ENGINE_STAGED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "context->engine",
+	 context->engine,
+	 LIBBDE_ENCRYPTION_ENGINE_STAGED );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_set_engine(
+	          NULL,
+	          LIBBDE_ENCRYPTION_ENGINE_STAGED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_engine(
+	          context,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_decrypt_sector function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_decrypt_sector(
+     void )
+{
+	uint8_t generic_data[ 512 ];
+	uint8_t input_data[ 512 ];
+	uint8_t key[ 64 ];
+	uint8_t sector_data[ 512 ];
+
+	uint16_t methods[ 6 ] = {
+		LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_CBC,
+		LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER,
+		LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_XTS };
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int method_index                     = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 512;
+	     data_index++ )
+	{
+		input_data[ data_index ] = (uint8_t) ( data_index * 7 );
+	}
+	for( data_index = 0;
+	     data_index < 64;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) ( data_index + 1 );
+	}
+	/* Test that the method specific decrypt function decrypts the same data
+	 * as the generic function
+	 */
+	for( method_index = 0;
+	     method_index < 6;
+	     method_index++ )
+	{
+		result = libbde_encryption_initialize(
+		          &context,
+		          methods[ method_index ],
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_set_keys(
+		          context,
+		          key,
+		          64,
+		          key,
+		          64,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_crypt(
+		          context,
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          512,
+		          generic_data,
+		          512,
+		          0x2400,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_decrypt_sector(
+		          context,
+		          input_data,
+		          512,
+		          sector_data,
+		          512,
+		          0x2400,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          sector_data,
+		          generic_data,
+		          512 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libbde_encryption_free(
+		          &context,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	result = libbde_encryption_decrypt_sector(
+	          NULL,
+	          input_data,
+	          512,
+	          sector_data,
+	          512,
+	          0x2400,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test decrypt without keys
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_decrypt_sector(
+	          context,
+	          input_data,
+	          512,
+	          sector_data,
+	          512,
+	          0x2400,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_crypt_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_crypt_sectors(
+     void )
+{
+	uint8_t fused_data[ 2048 ];
+	uint8_t input_data[ 2048 ];
+	uint8_t key[ 16 ];
+	uint8_t staged_data[ 2048 ];
+
+	int crypto_backends[ 2 ] = {
+		LIBBDE_CRYPTO_BACKEND_AUTOMATIC,
+		LIBBDE_CRYPTO_BACKEND_PORTABLE };
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int backend_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 2048;
+	     data_index++ )
+	{
+		input_data[ data_index ] = (uint8_t) ( data_index * 13 );
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		key[ data_index ] = (uint8_t) data_index;
+	}
+	/* Test that the staged and fused engines decrypt the same data
+	 * with the default and the portable crypto backend
+	 */
+	for( backend_index = 0;
+	     backend_index < 2;
+	     backend_index++ )
+	{
+		result = libbde_encryption_set_crypto_backend(
+		          crypto_backends[ backend_index ],
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_initialize(
+		          &context,
+		          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "context",
+		 context );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_set_keys(
+		          context,
+		          key,
+		          16,
+		          key,
+		          16,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_set_engine(
+		          context,
+		          LIBBDE_ENCRYPTION_ENGINE_STAGED,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_crypt_sectors(
+		          context,
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          2048,
+		          staged_data,
+		          2048,
+		          0x10000,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_set_engine(
+		          context,
+		          LIBBDE_ENCRYPTION_ENGINE_FUSED,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_encryption_crypt_sectors(
+		          context,
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		          input_data,
+		          2048,
+		          fused_data,
+		          2048,
+		          0x10000,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          fused_data,
+		          staged_data,
+		          2048 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = libbde_encryption_free(
+		          &context,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libbde_encryption_set_crypto_backend(
+	          LIBBDE_CRYPTO_BACKEND_AUTOMATIC,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          key,
+	          16,
+	          key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          2048,
+	          fused_data,
+	          2048,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          2048,
+	          fused_data,
+	          2048,
+	          0x10001,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          input_data,
+	          2000,
+	          fused_data,
+	          2048,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_initialize",
+	 bde_test_encryption_initialize );
+
+	/* TODO: add tests for libbde_encryption_free */
+
+	/* TODO: add tests for libbde_encryption_clone */
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_set_engine",
+	 bde_test_encryption_set_engine );
+
+	/* TODO: add tests for libbde_encryption_set_keys */
+
+	/* TODO: add tests for libbde_encryption_crypt */
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_decrypt_sector",
+	 bde_test_encryption_decrypt_sector );
+
+	/* TODO: add tests for libbde_encryption_decrypt_diffuser_sector */
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_crypt_sectors",
+	 bde_test_encryption_crypt_sectors );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -33,6 +33,7 @@
 #include "bde_test_memory.h"
 #include "bde_test_unused.h"
 
+#include "../libbde/libbde_definitions.h"
 #include "../libbde/libbde_io_handle.h"
 
 #if defined( __GNUC__ )
@@ -270,6 +271,556 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_io_handle_get_sector_storage function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_get_sector_storage(
+     void )
+{
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	off64_t physical_offset       = 0;
+	uint8_t storage_type          = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 0x00010000;
+	io_handle->encrypted_volume_size  = 0x00100000;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+
+	/* Test regular cases
+	 */
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          512,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "physical_offset",
+	 (int64_t) physical_offset,
+	 (int64_t) 0x00040200 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          0x00020200,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_SPARSE );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          0x00100000,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "physical_offset",
+	 (int64_t) physical_offset,
+	 (int64_t) 0x00100000 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_UNENCRYPTED );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test an offset beyond 2 TiB on a multi-terabyte volume
+	 */
+	io_handle->encrypted_volume_size = (size64_t) 0x0000100000000000ULL;
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          (off64_t) 0x00000f0000000200LL,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "physical_offset",
+	 (int64_t) physical_offset,
+	 (int64_t) 0x00000f0000000200LL );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->encrypted_volume_size = 0x00100000;
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_get_sector_storage(
+	          NULL,
+	          0,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          -1,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          0,
+	          1,
+	          NULL,
+	          &storage_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_sector_storage(
+	          io_handle,
+	          0,
+	          1,
+	          &physical_offset,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_io_handle_get_sectors_run function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_get_sectors_run(
+     void )
+{
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t run_size               = 0;
+	off64_t physical_offset       = 0;
+	uint8_t storage_type          = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 0x00010000;
+	io_handle->encrypted_volume_size  = 0x00100000;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+
+	/* Test regular cases
+	 */
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          512,
+	          0x00010000,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "physical_offset",
+	 (int64_t) physical_offset,
+	 (int64_t) 0x00040200 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 7680 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          0x00010000,
+	          0x00020000,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_SPARSE );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 0x00020000 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          0x000ffe00,
+	          1024,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 512 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a run beyond 2 TiB on a multi-terabyte volume
+	 */
+	io_handle->encrypted_volume_size = (size64_t) 0x0000100000000000ULL;
+
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          (off64_t) 0x00000f0000000000LL,
+	          0x00010000,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "physical_offset",
+	 (int64_t) physical_offset,
+	 (int64_t) 0x00000f0000000000LL );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "storage_type",
+	 storage_type,
+	 LIBBDE_SECTOR_STORAGE_TYPE_ENCRYPTED );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "run_size",
+	 run_size,
+	 (size_t) 0x00010000 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->encrypted_volume_size = 0x00100000;
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_get_sectors_run(
+	          NULL,
+	          0,
+	          512,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          0,
+	          0,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          &run_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_sectors_run(
+	          io_handle,
+	          0,
+	          512,
+	          1,
+	          &physical_offset,
+	          &storage_type,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -301,7 +852,17 @@ int main(
 
 	/* TODO: add tests for libbde_io_handle_read_volume_header */
 
-	/* TODO: add tests for libbde_io_handle_read_sector */
+	BDE_TEST_RUN(
+	 "libbde_io_handle_get_sector_storage",
+	 bde_test_io_handle_get_sector_storage );
+
+	BDE_TEST_RUN(
+	 "libbde_io_handle_get_sectors_run",
+	 bde_test_io_handle_get_sectors_run );
+
+	/* TODO: add tests for libbde_io_handle_decrypt_sectors_run */
+
+	/* TODO: add tests for libbde_io_handle_read_sectors */
 
 	/* TODO: add tests for libbde_io_handle_read_unencrypted_volume_header */
 
@@ -33,8 +33,21 @@
 #include "bde_test_memory.h"
 #include "bde_test_unused.h"
 
+#include "../libbde/libbde_io_handle.h"
 #include "../libbde/libbde_metadata.h"
 
+uint8_t bde_test_metadata_block_data1[ 160 ] = {
+	0x2d, 0x46, 0x56, 0x45, 0x2d, 0x46, 0x53, 0x2d, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x60, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00, 0x60, 0x00, 0x00, 0x00,
+	0x3e, 0x1c, 0x5b, 0x71, 0x0d, 0x2a, 0x4c, 0x41, 0x9f, 0x86, 0x11, 0x5c, 0x20, 0x7e, 0x94, 0xd2,
+	0x01, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x80, 0x00, 0x00, 0x3a, 0x5d, 0x3e, 0x0b, 0xc7, 0x01,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
 #if defined( __GNUC__ )
 
 /* Tests the libbde_metadata_initialize function
@@ -270,6 +283,324 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_metadata_read_block_data function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_metadata_read_block_data(
+     void )
+{
+	libbde_io_handle_t *io_handle = NULL;
+	libbde_metadata_t *metadata   = NULL;
+	libcerror_error_t *error      = NULL;
+	uint64_t creation_time        = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+
+	result = libbde_metadata_initialize(
+	          &metadata,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata",
+	 metadata );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          160,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_UINT16(
+	 "metadata->version",
+	 metadata->version,
+	 2 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT16(
+	 "metadata->encryption_method",
+	 metadata->encryption_method,
+	 0x8000 );
+
+	result = libbde_metadata_get_creation_time(
+	          metadata,
+	          &creation_time,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "creation_time",
+	 creation_time,
+	 (uint64_t) 0x01c70b3e5d3a0000UL );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_metadata_read_block_data(
+	          NULL,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          160,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          NULL,
+	          bde_test_metadata_block_data1,
+	          160,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          NULL,
+	          160,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          0,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the metadata entries are not within the data
+	 */
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          128,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the metadata offsets do not match
+	 */
+	io_handle->third_metadata_offset = 0x00040000;
+
+	result = libbde_metadata_read_block_data(
+	          metadata,
+	          io_handle,
+	          bde_test_metadata_block_data1,
+	          160,
+	          NULL,
+	          0,
+	          &error );
+
+	io_handle->third_metadata_offset = 0x00030000;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_metadata_free(
+	          &metadata,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "metadata",
+	 metadata );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &metadata,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libbde_metadata_get_creation_time function
  * Returns 1 if successful or 0 if not
  */
@@ -1117,6 +1448,10 @@ int main(
 
 	/* TODO: add tests for libbde_metadata_read_block */
 
+	BDE_TEST_RUN(
+	 "libbde_metadata_read_block_data",
+	 bde_test_metadata_read_block_data );
+
 	/* TODO: add tests for libbde_metadata_read_header */
 
 	/* TODO: add tests for libbde_metadata_read_entries */
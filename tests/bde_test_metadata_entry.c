@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -35,6 +36,10 @@
 
 #include "../libbde/libbde_metadata_entry.h"
 
+uint8_t bde_test_metadata_entry_data1[ 30 ] = {
+	0x0c, 0x00, 0x07, 0x00, 0x02, 0x00, 0x01, 0x00, 0x41, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00,
+	0x01, 0x00, 0x01, 0x00, 0xaa, 0xbb, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
 #if defined( __GNUC__ )
 
 /* Tests the libbde_metadata_entry_initialize function
@@ -270,6 +275,344 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_metadata_entry_read function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_metadata_entry_read(
+     void )
+{
+	libbde_metadata_entry_t *metadata_entry = NULL;
+	libcerror_error_t *error                = NULL;
+	ssize_t read_count                      = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_metadata_entry_initialize(
+	          &metadata_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "metadata_entry",
+	 metadata_entry );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	read_count = libbde_metadata_entry_read(
+	              metadata_entry,
+	              bde_test_metadata_entry_data1,
+	              30,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) 12 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_UINT16(
+	 "metadata_entry->type",
+	 metadata_entry->type,
+	 0x0007 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT16(
+	 "metadata_entry->value_type",
+	 metadata_entry->value_type,
+	 0x0002 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT16(
+	 "metadata_entry->value_data_size",
+	 metadata_entry->value_data_size,
+	 4 );
+
+	/* The value data references the metadata data
+	 */
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "value_data_offset",
+	 (size_t) ( metadata_entry->value_data - bde_test_metadata_entry_data1 ),
+	 (size_t) 8 );
+
+	/* Test error cases
+	 */
+	read_count = libbde_metadata_entry_read(
+	              NULL,
+	              bde_test_metadata_entry_data1,
+	              30,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_metadata_entry_read(
+	              metadata_entry,
+	              NULL,
+	              30,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_metadata_entry_read(
+	              metadata_entry,
+	              bde_test_metadata_entry_data1,
+	              11,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_metadata_entry_free(
+	          &metadata_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "metadata_entry",
+	 metadata_entry );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( metadata_entry != NULL )
+	{
+		libbde_metadata_entry_free(
+		 &metadata_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_metadata_entry_initialize_entries function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_metadata_entry_initialize_entries(
+     void )
+{
+	libbde_metadata_entry_t *entries = NULL;
+	libcerror_error_t *error         = NULL;
+	int number_of_entries            = 0;
+	int result                       = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_metadata_entry_initialize_entries(
+	          &entries,
+	          &number_of_entries,
+	          bde_test_metadata_entry_data1,
+	          30,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "entries",
+	 entries );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 entries );
+
+	entries = NULL;
+
+	/* Test with the data ending before the second entry
+	 */
+	result = libbde_metadata_entry_initialize_entries(
+	          &entries,
+	          &number_of_entries,
+	          bde_test_metadata_entry_data1,
+	          20,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "entries",
+	 entries );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 entries );
+
+	entries = NULL;
+
+	/* Test with only the empty entry
+	 */
+	result = libbde_metadata_entry_initialize_entries(
+	          &entries,
+	          &number_of_entries,
+	          &( bde_test_metadata_entry_data1[ 22 ] ),
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "entries",
+	 entries );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_metadata_entry_initialize_entries(
+	          NULL,
+	          &number_of_entries,
+	          bde_test_metadata_entry_data1,
+	          30,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_entry_initialize_entries(
+	          &entries,
+	          NULL,
+	          bde_test_metadata_entry_data1,
+	          30,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_metadata_entry_initialize_entries(
+	          &entries,
+	          &number_of_entries,
+	          NULL,
+	          30,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( entries != NULL )
+	{
+		memory_free(
+		 entries );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -297,7 +640,13 @@ int main(
 	 "libbde_metadata_entry_free",
 	 bde_test_metadata_entry_free );
 
-	/* TODO: add tests for libbde_metadata_entry_read */
+	BDE_TEST_RUN(
+	 "libbde_metadata_entry_read",
+	 bde_test_metadata_entry_read );
+
+	BDE_TEST_RUN(
+	 "libbde_metadata_entry_initialize_entries",
+	 bde_test_metadata_entry_initialize_entries );
 
 	/* TODO: add tests for libbde_metadata_entry_read_string */
 
@@ -0,0 +1,809 @@
+/*
+ * Library password_keep type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_password.h"
+#include "../libbde/libbde_password_keep.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_password_keep_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_initialize(
+     void )
+{
+	libbde_password_keep_t *password_keep = NULL;
+	libcerror_error_t *error              = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "password_keep",
+	 password_keep );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "password_keep",
+	 password_keep );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_initialize(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_keep = (libbde_password_keep_t *) 0x12345678UL;
+
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_keep = NULL;
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_append_stretched_key and libbde_password_keep_get_stretched_key functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_append_stretched_key(
+     void )
+{
+	uint8_t password_hash[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libbde_password_keep_stretched_key_t *first_stretched_key = NULL;
+	libbde_password_keep_stretched_key_t *stretched_key       = NULL;
+	libbde_password_keep_t *password_keep                     = NULL;
+	libcerror_error_t *error                                  = NULL;
+	size_t data_index                                         = 0;
+	int result                                                = 0;
+	int stretched_key_index                                   = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		password_hash[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		salt[ data_index ] = (uint8_t) ( 0xa0 + data_index );
+	}
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_append_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          &first_stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "first_stretched_key",
+	 first_stretched_key );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_UINT8(
+	 "first_stretched_key->key_is_set",
+	 first_stretched_key->key_is_set,
+	 0 );
+
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "stretched_key",
+	 (int) ( stretched_key == first_stretched_key ),
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the least recently appended stretched key is replaced
+	 * when all stretched keys are used
+	 */
+	for( stretched_key_index = 0;
+	     stretched_key_index < LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS;
+	     stretched_key_index++ )
+	{
+		salt[ 0 ] = (uint8_t) ( stretched_key_index + 1 );
+
+		result = libbde_password_keep_append_stretched_key(
+		          password_keep,
+		          password_hash,
+		          32,
+		          salt,
+		          16,
+		          &stretched_key,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->number_of_stretched_keys",
+	 password_keep->number_of_stretched_keys,
+	 LIBBDE_MAXIMUM_NUMBER_OF_STRETCHED_KEYS );
+
+	salt[ 0 ] = 0xa0;
+
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_append_stretched_key(
+	          NULL,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_append_stretched_key(
+	          password_keep,
+	          password_hash,
+	          16,
+	          salt,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          NULL,
+	          16,
+	          &stretched_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_stretched_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_calculate_stretched_keys and libbde_password_keep_calculate_key functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_calculate_key(
+     void )
+{
+	uint8_t expected_key[ 32 ];
+	uint8_t key[ 32 ];
+	uint8_t password_hash[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libbde_password_keep_stretched_key_t *stretched_key = NULL;
+	libbde_password_keep_t *password_keep               = NULL;
+	libcerror_error_t *error                            = NULL;
+	size_t data_index                                   = 0;
+	int result                                          = 0;
+	int stretched_key_index                             = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		password_hash[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		salt[ data_index ] = (uint8_t) ( 0xa0 + data_index );
+	}
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test concurrent calculation of multiple stretched keys
+	 */
+	for( stretched_key_index = 0;
+	     stretched_key_index < 3;
+	     stretched_key_index++ )
+	{
+		salt[ 0 ] = (uint8_t) stretched_key_index;
+
+		result = libbde_password_keep_append_stretched_key(
+		          password_keep,
+		          password_hash,
+		          32,
+		          salt,
+		          16,
+		          &stretched_key,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libbde_password_keep_calculate_stretched_keys(
+	          password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( stretched_key_index = 0;
+	     stretched_key_index < 3;
+	     stretched_key_index++ )
+	{
+		salt[ 0 ] = (uint8_t) stretched_key_index;
+
+		result = libbde_password_calculate_key(
+		          password_hash,
+		          32,
+		          salt,
+		          16,
+		          expected_key,
+		          32,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		BDE_TEST_ASSERT_EQUAL_UINT8(
+		 "stretched_keys[ stretched_key_index ].key_is_set",
+		 password_keep->stretched_keys[ stretched_key_index ].key_is_set,
+		 1 );
+
+		result = memory_compare(
+		          password_keep->stretched_keys[ stretched_key_index ].key,
+		          expected_key,
+		          32 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		/* Test that the stretched key is reused
+		 */
+		result = libbde_password_keep_calculate_key(
+		          password_keep,
+		          password_hash,
+		          32,
+		          salt,
+		          16,
+		          key,
+		          32,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          key,
+		          expected_key,
+		          32 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->number_of_stretched_keys",
+	 password_keep->number_of_stretched_keys,
+	 3 );
+
+	/* Test calculation of a stretched key that was not appended
+	 */
+	salt[ 0 ] = 0xa0;
+
+	result = libbde_password_keep_calculate_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->number_of_stretched_keys",
+	 password_keep->number_of_stretched_keys,
+	 4 );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_calculate_stretched_keys(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_calculate_key(
+	          NULL,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_calculate_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          NULL,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_calculate_key(
+	          password_keep,
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_initialize",
+	 bde_test_password_keep_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_free",
+	 bde_test_password_keep_free );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_append_stretched_key",
+	 bde_test_password_keep_append_stretched_key );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_calculate_key",
+	 bde_test_password_keep_calculate_key );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
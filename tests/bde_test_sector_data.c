@@ -102,6 +102,8 @@ int main(
 
 	/* TODO: add tests for libbde_sector_data_read */
 
+	/* TODO: add tests for libbde_sector_data_read_multiple */
+
 #endif /* defined( __GNUC__ ) */
 
 	return( EXIT_SUCCESS );
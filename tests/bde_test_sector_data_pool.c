@@ -0,0 +1,626 @@
+/*
+ * Library sector_data_pool type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_sector_data.h"
+#include "../libbde/libbde_sector_data_pool.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_sector_data_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_pool_initialize(
+     void )
+{
+	libbde_sector_data_pool_t *sector_data_pool = NULL;
+	libcerror_error_t *error                    = NULL;
+	int result                                  = 0;
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests             = 2;
+	int number_of_memset_fail_tests             = 2;
+	int test_number                             = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          512,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sector_data_pool_free(
+	          &sector_data_pool,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_data_pool_initialize(
+	          NULL,
+	          512,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_data_pool = (libbde_sector_data_pool_t *) 0x12345678UL;
+
+	result = libbde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          512,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_data_pool = NULL;
+
+	result = libbde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          512,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_sector_data_pool_initialize with malloc failing
+		 */
+		bde_test_malloc_attempts_before_fail = test_number;
+
+		result = libbde_sector_data_pool_initialize(
+		          &sector_data_pool,
+		          512,
+		          16,
+		          &error );
+
+		if( bde_test_malloc_attempts_before_fail != -1 )
+		{
+			bde_test_malloc_attempts_before_fail = -1;
+
+			if( sector_data_pool != NULL )
+			{
+				libbde_sector_data_pool_free(
+				 &sector_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "sector_data_pool",
+			 sector_data_pool );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_sector_data_pool_initialize with memset failing
+		 */
+		bde_test_memset_attempts_before_fail = test_number;
+
+		result = libbde_sector_data_pool_initialize(
+		          &sector_data_pool,
+		          512,
+		          16,
+		          &error );
+
+		if( bde_test_memset_attempts_before_fail != -1 )
+		{
+			bde_test_memset_attempts_before_fail = -1;
+
+			if( sector_data_pool != NULL )
+			{
+				libbde_sector_data_pool_free(
+				 &sector_data_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "sector_data_pool",
+			 sector_data_pool );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data_pool != NULL )
+	{
+		libbde_sector_data_pool_free(
+		 &sector_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_data_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_sector_data_pool_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_data_pool_get_sector_data and libbde_sector_data_pool_release_sector_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_pool_get_and_release_sector_data(
+     void )
+{
+	libbde_sector_data_pool_t *sector_data_pool = NULL;
+	libbde_sector_data_t *released_sector_data  = NULL;
+	libbde_sector_data_t *sector_data           = NULL;
+	libcerror_error_t *error                    = NULL;
+	uint64_t number_of_allocations              = 0;
+	uint64_t number_of_reuses                   = 0;
+	int result                                  = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_sector_data_pool_initialize(
+	          &sector_data_pool,
+	          512,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sector_data",
+	 sector_data );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "sector_data->data_size",
+	 sector_data->data_size,
+	 (size_t) 512 );
+
+	released_sector_data = sector_data;
+
+	result = libbde_sector_data_pool_release_sector_data(
+	          sector_data_pool,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The released sector data should be reused
+	 */
+	result = libbde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_data",
+	 (int) ( sector_data == released_sector_data ),
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sector_data_pool_get_statistics(
+	          sector_data_pool,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 (uint64_t) 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 (uint64_t) 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sector_data_pool_release_sector_data(
+	          sector_data_pool,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Sector data with a different data size is freed
+	 */
+	result = libbde_sector_data_initialize(
+	          &sector_data,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sector_data_pool_release_sector_data(
+	          sector_data_pool,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_data_pool_get_sector_data(
+	          NULL,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_pool_get_sector_data(
+	          sector_data_pool,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_pool_release_sector_data(
+	          NULL,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_pool_release_sector_data(
+	          sector_data_pool,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_sector_data_pool_free(
+	          &sector_data_pool,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data_pool",
+	 sector_data_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( sector_data_pool != NULL )
+	{
+		libbde_sector_data_pool_free(
+		 &sector_data_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_sector_data_pool_initialize",
+	 bde_test_sector_data_pool_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_data_pool_free",
+	 bde_test_sector_data_pool_free );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_data_pool_get_sector_data",
+	 bde_test_sector_data_pool_get_and_release_sector_data );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
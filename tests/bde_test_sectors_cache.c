@@ -0,0 +1,645 @@
+/*
+ * Library sectors_cache type test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_sector_data.h"
+#include "../libbde/libbde_sectors_cache.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_sectors_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sectors_cache_initialize(
+     void )
+{
+	libbde_sectors_cache_t *sectors_cache = NULL;
+	libcerror_error_t *error              = NULL;
+	int result                            = 0;
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests       = 2;
+	int number_of_memset_fail_tests       = 2;
+	int test_number                       = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbde_sectors_cache_initialize(
+	          &sectors_cache,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sectors_cache",
+	 sectors_cache );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sectors_cache_free(
+	          &sectors_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sectors_cache",
+	 sectors_cache );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_sectors_cache_initialize(
+	          NULL,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sectors_cache = (libbde_sectors_cache_t *) 0x12345678UL;
+
+	result = libbde_sectors_cache_initialize(
+	          &sectors_cache,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	sectors_cache = NULL;
+
+	result = libbde_sectors_cache_initialize(
+	          &sectors_cache,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_sectors_cache_initialize with malloc failing
+		 */
+		bde_test_malloc_attempts_before_fail = test_number;
+
+		result = libbde_sectors_cache_initialize(
+		          &sectors_cache,
+		          16,
+		          &error );
+
+		if( bde_test_malloc_attempts_before_fail != -1 )
+		{
+			bde_test_malloc_attempts_before_fail = -1;
+
+			if( sectors_cache != NULL )
+			{
+				libbde_sectors_cache_free(
+				 &sectors_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "sectors_cache",
+			 sectors_cache );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_sectors_cache_initialize with memset failing
+		 */
+		bde_test_memset_attempts_before_fail = test_number;
+
+		result = libbde_sectors_cache_initialize(
+		          &sectors_cache,
+		          16,
+		          &error );
+
+		if( bde_test_memset_attempts_before_fail != -1 )
+		{
+			bde_test_memset_attempts_before_fail = -1;
+
+			if( sectors_cache != NULL )
+			{
+				libbde_sectors_cache_free(
+				 &sectors_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "sectors_cache",
+			 sectors_cache );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sectors_cache != NULL )
+	{
+		libbde_sectors_cache_free(
+		 &sectors_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sectors_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sectors_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_sectors_cache_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sectors_cache_get_sector_data_by_offset and libbde_sectors_cache_set_sector_data_by_offset functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sectors_cache_get_and_set_sector_data_by_offset(
+     void )
+{
+	libbde_sector_data_t *cached_sector_data  = NULL;
+	libbde_sector_data_t *evicted_sector_data = NULL;
+	libbde_sector_data_t *sector_data         = NULL;
+	libbde_sectors_cache_t *sectors_cache     = NULL;
+	libcerror_error_t *error                  = NULL;
+	off64_t offset                            = 0;
+	int number_of_entries                     = 0;
+	int number_of_evictions                   = 0;
+	int result                                = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_sectors_cache_initialize(
+	          &sectors_cache,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "sectors_cache",
+	 sectors_cache );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( offset = 0;
+	     offset < 3 * 512;
+	     offset += 512 )
+	{
+		result = libbde_sector_data_initialize(
+		          &sector_data,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "sector_data",
+		 sector_data );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_sectors_cache_set_sector_data_by_offset(
+		          sectors_cache,
+		          offset,
+		          sector_data,
+		          &evicted_sector_data,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		cached_sector_data = sector_data;
+		sector_data        = NULL;
+
+		if( evicted_sector_data != NULL )
+		{
+			result = libbde_sector_data_free(
+			          &evicted_sector_data,
+			          &error );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			number_of_evictions++;
+		}
+	}
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_evictions",
+	 number_of_evictions,
+	 1 );
+
+	result = libbde_sectors_cache_get_number_of_entries(
+	          sectors_cache,
+	          &number_of_entries,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The least recently used entry at offset 0 should have been evicted
+	 */
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          sectors_cache,
+	          0,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          sectors_cache,
+	          1024,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_data",
+	 (int) ( sector_data == cached_sector_data ),
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	sector_data = NULL;
+
+	/* An offset beyond 1 TiB must not alias a lower offset
+	 */
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          sectors_cache,
+	          (off64_t) 1024 + ( (off64_t) 1 << 40 ),
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sector_data",
+	 sector_data );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          NULL,
+	          0,
+	          &sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sectors_cache_get_sector_data_by_offset(
+	          sectors_cache,
+	          0,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sectors_cache_set_sector_data_by_offset(
+	          sectors_cache,
+	          0,
+	          NULL,
+	          &evicted_sector_data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sectors_cache_set_sector_data_by_offset(
+	          sectors_cache,
+	          0,
+	          cached_sector_data,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_sectors_cache_free(
+	          &sectors_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "sectors_cache",
+	 sectors_cache );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( evicted_sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &evicted_sector_data,
+		 NULL );
+	}
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( sectors_cache != NULL )
+	{
+		libbde_sectors_cache_free(
+		 &sectors_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_sectors_cache_initialize",
+	 bde_test_sectors_cache_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_sectors_cache_free",
+	 bde_test_sectors_cache_free );
+
+	/* TODO: add tests for libbde_sectors_cache_empty */
+
+	BDE_TEST_RUN(
+	 "libbde_sectors_cache_get_sector_data_by_offset",
+	 bde_test_sectors_cache_get_and_set_sector_data_by_offset );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
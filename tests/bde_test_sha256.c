@@ -0,0 +1,599 @@
+/*
+ * Library SHA-256 key stretching functions test program
+ *
+ * Copyright (C) 2011-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_sha256.h"
+
+/* The number of key iterations used by the stretch key tests,
+ * BitLocker itself uses 0x100000 key iterations
+ */
+#define BDE_TEST_SHA256_NUMBER_OF_ITERATIONS	16
+
+/* SHA-256 of "abc" from FIPS 180-2 appendix B.1
+ */
+uint32_t bde_test_sha256_abc_hash[ 8 ] = {
+	0xba7816bfUL, 0x8f01cfeaUL, 0x414140deUL, 0x5dae2223UL, 0xb00361a3UL, 0x96177a9cUL, 0xb410ff61UL, 0xf20015adUL };
+
+/* The stretched key of password hash 0x00 - 0x1f and salt 0xa0 - 0xaf
+ * after BDE_TEST_SHA256_NUMBER_OF_ITERATIONS key iterations
+ */
+uint8_t bde_test_sha256_stretched_key[ 32 ] = {
+	0xcc, 0xcb, 0xb3, 0xa1, 0xd0, 0xaa, 0x30, 0x42, 0x42, 0x3c, 0x5d, 0xa3, 0xda, 0xff, 0x2f, 0xe4,
+	0x36, 0x74, 0xe7, 0x70, 0x19, 0xf6, 0x91, 0xdd, 0x8a, 0x62, 0x2c, 0xb2, 0xe2, 0x6b, 0x35, 0x00 };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_sha256_transform function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_transform(
+     void )
+{
+	uint32_t message_words[ 16 ];
+	uint32_t state[ 8 ] = {
+		0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+	int result     = 0;
+	int word_index = 0;
+
+	/* Initialize test
+	 */
+	for( word_index = 0;
+	     word_index < 16;
+	     word_index++ )
+	{
+		message_words[ word_index ] = 0;
+	}
+	/* "abc" followed by the padding and the data size in bits
+	 */
+	message_words[ 0 ]  = 0x61626380UL;
+	message_words[ 15 ] = 24;
+
+	/* Test regular cases
+	 */
+	libbde_sha256_transform(
+	 state,
+	 message_words );
+
+	result = memory_compare(
+	          state,
+	          bde_test_sha256_abc_hash,
+	          sizeof( uint32_t ) * 8 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libbde_sha256_stretch_key_portable function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_stretch_key_portable(
+     void )
+{
+	uint8_t key[ 32 ];
+	uint8_t password_hash[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		password_hash[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		salt[ data_index ] = (uint8_t) ( 0xa0 + data_index );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_sha256_stretch_key_portable(
+	          password_hash,
+	          salt,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretched_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_sha256_stretch_key_portable(
+	          NULL,
+	          salt,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key_portable(
+	          password_hash,
+	          NULL,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key_portable(
+	          password_hash,
+	          salt,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sha256_ni_stretch_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_ni_stretch_key(
+     void )
+{
+	uint8_t key[ 32 ];
+	uint8_t password_hash[ 32 ];
+	uint8_t portable_key[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libcerror_error_t *error  = NULL;
+	size_t data_index         = 0;
+	uint32_t iteration_number = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_sha256_ni_is_supported();
+
+	if( result == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		password_hash[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		salt[ data_index ] = (uint8_t) ( 0xa0 + data_index );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_sha256_ni_stretch_key(
+	          password_hash,
+	          salt,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretched_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the result matches the portable implementation
+	 * for iteration counts that use more than the lower byte
+	 */
+	for( iteration_number = 1;
+	     iteration_number <= 0x1001;
+	     iteration_number += 0x0100 )
+	{
+		result = libbde_sha256_stretch_key_portable(
+		          password_hash,
+		          salt,
+		          iteration_number,
+		          portable_key,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_sha256_ni_stretch_key(
+		          password_hash,
+		          salt,
+		          iteration_number,
+		          key,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          key,
+		          portable_key,
+		          32 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_sha256_ni_stretch_key(
+	          NULL,
+	          salt,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sha256_stretch_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_stretch_key(
+     void )
+{
+	uint8_t key[ 32 ];
+	uint8_t password_hash[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		password_hash[ data_index ] = (uint8_t) data_index;
+	}
+	for( data_index = 0;
+	     data_index < 16;
+	     data_index++ )
+	{
+		salt[ data_index ] = (uint8_t) ( 0xa0 + data_index );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_sha256_stretch_key(
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretched_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_sha256_stretch_key(
+	          NULL,
+	          32,
+	          salt,
+	          16,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key(
+	          password_hash,
+	          16,
+	          salt,
+	          16,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key(
+	          password_hash,
+	          32,
+	          salt,
+	          32,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key(
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          0,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_key(
+	          password_hash,
+	          32,
+	          salt,
+	          16,
+	          BDE_TEST_SHA256_NUMBER_OF_ITERATIONS,
+	          key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_transform",
+	 bde_test_sha256_transform );
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_stretch_key_portable",
+	 bde_test_sha256_stretch_key_portable );
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_ni_stretch_key",
+	 bde_test_sha256_ni_stretch_key );
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_stretch_key",
+	 bde_test_sha256_stretch_key );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
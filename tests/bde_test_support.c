@@ -595,6 +595,146 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_get_crypto_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_get_crypto_backend(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int crypto_backend       = 0;
+	int result               = 0;
+
+	result = libbde_get_crypto_backend(
+	          &crypto_backend,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "crypto_backend",
+	 crypto_backend,
+	 LIBBDE_CRYPTO_BACKEND_AUTOMATIC );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_get_crypto_backend(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_set_crypto_backend function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_set_crypto_backend(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int crypto_backend       = 0;
+	int result               = 0;
+
+	result = libbde_set_crypto_backend(
+	          LIBBDE_CRYPTO_BACKEND_PORTABLE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_get_crypto_backend(
+	          &crypto_backend,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "crypto_backend",
+	 crypto_backend,
+	 LIBBDE_CRYPTO_BACKEND_PORTABLE );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_set_crypto_backend(
+	          LIBBDE_CRYPTO_BACKEND_AUTOMATIC,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_set_crypto_backend(
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libbde_check_volume_signature function
  * Returns 1 if successful or 0 if not
  */
@@ -1060,6 +1200,14 @@ int main(
 	 "libbde_set_codepage",
 	 bde_test_set_codepage );
 
+	BDE_TEST_RUN(
+	 "libbde_get_crypto_backend",
+	 bde_test_get_crypto_backend );
+
+	BDE_TEST_RUN(
+	 "libbde_set_crypto_backend",
+	 bde_test_set_crypto_backend );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -1467,6 +1468,151 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_volume_open_memory function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_open_memory(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libbde_volume_t *volume  = NULL;
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_open_memory(
+	          NULL,
+	          buffer,
+	          512,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_open_memory(
+	          volume,
+	          NULL,
+	          512,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_open_memory(
+	          volume,
+	          buffer,
+	          0,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_open_memory(
+	          volume,
+	          buffer,
+	          512,
+	          LIBBDE_OPEN_WRITE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
 /* Tests the libbde_volume_signal_abort function
  * Returns 1 if successful or 0 if not
  */
@@ -1676,22 +1822,1144 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_encryption_method function
+/* Tests the libbde_volume_get_cache_block_size and libbde_volume_set_cache_block_size functions
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_encryption_method(
+int bde_test_volume_get_cache_block_size(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size_t cache_block_size  = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_cache_block_size(
+	          volume,
+	          &cache_block_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_set_cache_block_size(
+	          volume,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_cache_block_size(
+	          NULL,
+	          &cache_block_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_get_cache_block_size(
+	          volume,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_cache_block_size(
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_cache_block_size(
+	          volume,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_readahead_depth and libbde_volume_set_readahead_depth functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_readahead_depth(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int readahead_depth      = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_readahead_depth(
+	          volume,
+	          &readahead_depth,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          readahead_depth,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_readahead_depth(
+	          NULL,
+	          &readahead_depth,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_get_readahead_depth(
+	          volume,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_readahead_depth(
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          1025,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_number_of_threads and libbde_volume_set_number_of_threads functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_number_of_threads(
+     libbde_volume_t *volume )
+{
+	uint8_t multi_threaded_buffer[ 32768 ];
+	uint8_t single_threaded_buffer[ 32768 ];
+
+	libcerror_error_t *error              = NULL;
+	ssize_t multi_threaded_read_count     = 0;
+	ssize_t single_threaded_read_count    = 0;
+	off64_t offset                        = 0;
+	int is_locked                         = 0;
+	int number_of_threads                 = 0;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_number_of_threads(
+	          volume,
+	          &number_of_threads,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_threads",
+	 number_of_threads,
+	 0 );
+
+	is_locked = libbde_volume_is_locked(
+	             volume,
+	             &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "is_locked",
+	 is_locked,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test if a read decrypted by multiple threads matches a single-threaded read
+	 */
+	if( is_locked == 0 )
+	{
+		offset = libbde_volume_seek_offset(
+		          volume,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) 0 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		single_threaded_read_count = libbde_volume_read_buffer(
+		                              volume,
+		                              single_threaded_buffer,
+		                              32768,
+		                              &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "single_threaded_read_count",
+		 single_threaded_read_count,
+		 (ssize_t) 32768 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_volume_set_number_of_threads(
+		          volume,
+		          4,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		offset = libbde_volume_seek_offset(
+		          volume,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) 0 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		multi_threaded_read_count = libbde_volume_read_buffer(
+		                             volume,
+		                             multi_threaded_buffer,
+		                             32768,
+		                             &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "multi_threaded_read_count",
+		 multi_threaded_read_count,
+		 (ssize_t) 32768 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          multi_threaded_buffer,
+		          single_threaded_buffer,
+		          32768 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	result = libbde_volume_set_number_of_threads(
+	          volume,
+	          number_of_threads,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_number_of_threads(
+	          NULL,
+	          &number_of_threads,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_get_number_of_threads(
+	          volume,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_number_of_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_number_of_threads(
+	          volume,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_number_of_threads(
+	          volume,
+	          33,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	libbde_volume_set_number_of_threads(
+	 volume,
+	 0,
+	 NULL );
+
+	return( 0 );
+}
+
+/* Tests the libbde_volume_pread_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_pread_buffer(
+     libbde_volume_t *volume )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	read_count = libbde_volume_pread_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_pread_buffer(
+	              volume,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_pread_buffer(
+	              volume,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_pread_buffer(
+	              volume,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Make sure the current offset is not changed
+	 */
+	result = libbde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 (int64_t) offset,
+	 (int64_t) 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests that libbde_volume_pread_buffer does not take sector data from the pool
+ * when large aligned reads bypass the sectors cache
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_pread_buffer_sector_data_pool(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error                = NULL;
+	uint8_t *buffer                         = NULL;
+	size64_t volume_size                    = 0;
+	size_t cache_block_size                 = 0;
+	ssize_t read_count                      = 0;
+	uint64_t number_of_allocations          = 0;
+	uint64_t number_of_reuses               = 0;
+	uint64_t previous_number_of_allocations = 0;
+	uint64_t previous_number_of_reuses      = 0;
+	off64_t offset                          = 0;
+	int read_index                          = 0;
+	int readahead_depth                     = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_is_locked(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		return( 1 );
+	}
+	result = libbde_volume_get_size(
+	          volume,
+	          &volume_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_get_cache_block_size(
+	          volume,
+	          &cache_block_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( ( cache_block_size == 0 )
+	 || ( volume_size < (size64_t) ( 8 * cache_block_size ) ) )
+	{
+		return( 1 );
+	}
+	/* Disable the readahead since it takes sector data from the pool in the background
+	 */
+	result = libbde_volume_get_readahead_depth(
+	          volume,
+	          &readahead_depth,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * 2 * cache_block_size );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "buffer",
+	 buffer );
+
+	result = libbde_volume_get_sector_data_pool_statistics(
+	          volume,
+	          &previous_number_of_allocations,
+	          &previous_number_of_reuses,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( read_index = 0;
+	     read_index < 16;
+	     read_index++ )
+	{
+		offset = (off64_t) ( ( read_index % 4 ) * 2 * cache_block_size );
+
+		read_count = libbde_volume_pread_buffer(
+		              volume,
+		              buffer,
+		              2 * cache_block_size,
+		              offset,
+		              &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) ( 2 * cache_block_size ) );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* The reads bypass the sectors cache hence no sector data should have been taken from the pool
+	 */
+	result = libbde_volume_get_sector_data_pool_statistics(
+	          volume,
+	          &number_of_allocations,
+	          &number_of_reuses,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_allocations",
+	 number_of_allocations,
+	 previous_number_of_allocations );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "number_of_reuses",
+	 number_of_reuses,
+	 previous_number_of_reuses );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	result = libbde_volume_set_readahead_depth(
+	          volume,
+	          readahead_depth,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( readahead_depth != 0 )
+	{
+		libbde_volume_set_readahead_depth(
+		 volume,
+		 readahead_depth,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_optimal_io_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_optimal_io_size(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size_t io_size           = 0;
+	int is_locked            = 0;
+	int result               = 0;
+
+	is_locked = libbde_volume_is_locked(
+	             volume,
+	             &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "is_locked",
+	 is_locked,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( is_locked == 0 )
+	{
+		result = libbde_volume_get_optimal_io_size(
+		          volume,
+		          &io_size,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		BDE_TEST_ASSERT_NOT_EQUAL_INT(
+		 "io_size",
+		 (int) io_size,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_volume_get_optimal_io_size(
+	          NULL,
+	          &io_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_get_optimal_io_size(
+	          volume,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_encryption_method function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_encryption_method(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error     = NULL;
+	uint16_t encryption_method   = 0;
+	int encryption_method_is_set = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_encryption_method(
+	          volume,
+	          &encryption_method,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	encryption_method_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_encryption_method(
+	          NULL,
+	          &encryption_method,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( encryption_method_is_set != 0 )
+	{
+		result = libbde_volume_get_encryption_method(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_creation_time function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_creation_time(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t creation_time   = 0;
+	int creation_time_is_set = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_creation_time(
+	          volume,
+	          &creation_time,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	creation_time_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_creation_time(
+	          NULL,
+	          &creation_time,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( creation_time_is_set != 0 )
+	{
+		result = libbde_volume_get_creation_time(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_utf8_description_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_utf8_description_size(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error     = NULL;
-	uint16_t encryption_method   = 0;
-	int encryption_method_is_set = 0;
-	int result                   = 0;
+	libcerror_error_t *error         = NULL;
+	size_t utf8_description_size     = 0;
+	int result                       = 0;
+	int utf8_description_size_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_encryption_method(
+	result = libbde_volume_get_utf8_description_size(
 	          volume,
-	          &encryption_method,
+	          &utf8_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1703,13 +2971,13 @@ int bde_test_volume_get_encryption_method(
 	 "error",
 	 error );
 
-	encryption_method_is_set = result;
+	utf8_description_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_encryption_method(
+	result = libbde_volume_get_utf8_description_size(
 	          NULL,
-	          &encryption_method,
+	          &utf8_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1724,9 +2992,9 @@ int bde_test_volume_get_encryption_method(
 	libcerror_error_free(
 	 &error );
 
-	if( encryption_method_is_set != 0 )
+	if( utf8_description_size_is_set != 0 )
 	{
-		result = libbde_volume_get_encryption_method(
+		result = libbde_volume_get_utf8_description_size(
 		          volume,
 		          NULL,
 		          &error );
@@ -1754,22 +3022,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_creation_time function
+/* Tests the libbde_volume_get_utf8_description function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_creation_time(
+int bde_test_volume_get_utf8_description(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	uint64_t creation_time   = 0;
-	int creation_time_is_set = 0;
-	int result               = 0;
+	uint8_t utf8_description[ 512 ];
+
+	libcerror_error_t *error    = NULL;
+	int result                  = 0;
+	int utf8_description_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_creation_time(
+	result = libbde_volume_get_utf8_description(
 	          volume,
-	          &creation_time,
+	          utf8_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1781,13 +3051,14 @@ int bde_test_volume_get_creation_time(
 	 "error",
 	 error );
 
-	creation_time_is_set = result;
+	utf8_description_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_creation_time(
+	result = libbde_volume_get_utf8_description(
 	          NULL,
-	          &creation_time,
+	          utf8_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1802,11 +3073,48 @@ int bde_test_volume_get_creation_time(
 	libcerror_error_free(
 	 &error );
 
-	if( creation_time_is_set != 0 )
+	if( utf8_description_is_set != 0 )
 	{
-		result = libbde_volume_get_creation_time(
+		result = libbde_volume_get_utf8_description(
 		          volume,
 		          NULL,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf8_description(
+		          volume,
+		          utf8_description,
+		          0,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+	        BDE_TEST_ASSERT_IS_NOT_NULL(
+	         "error",
+	         error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf8_description(
+		          volume,
+		          utf8_description,
+		          (size_t) SSIZE_MAX + 1,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
@@ -1832,22 +3140,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf8_description_size function
+/* Tests the libbde_volume_get_utf16_description_size function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf8_description_size(
+int bde_test_volume_get_utf16_description_size(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error         = NULL;
-	size_t utf8_description_size     = 0;
-	int result                       = 0;
-	int utf8_description_size_is_set = 0;
+	libcerror_error_t *error          = NULL;
+	size_t utf16_description_size     = 0;
+	int result                        = 0;
+	int utf16_description_size_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_utf8_description_size(
+	result = libbde_volume_get_utf16_description_size(
 	          volume,
-	          &utf8_description_size,
+	          &utf16_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1859,13 +3167,13 @@ int bde_test_volume_get_utf8_description_size(
 	 "error",
 	 error );
 
-	utf8_description_size_is_set = result;
+	utf16_description_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf8_description_size(
+	result = libbde_volume_get_utf16_description_size(
 	          NULL,
-	          &utf8_description_size,
+	          &utf16_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1880,9 +3188,9 @@ int bde_test_volume_get_utf8_description_size(
 	libcerror_error_free(
 	 &error );
 
-	if( utf8_description_size_is_set != 0 )
+	if( utf16_description_size_is_set != 0 )
 	{
-		result = libbde_volume_get_utf8_description_size(
+		result = libbde_volume_get_utf16_description_size(
 		          volume,
 		          NULL,
 		          &error );
@@ -1910,23 +3218,23 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf8_description function
+/* Tests the libbde_volume_get_utf16_description function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf8_description(
+int bde_test_volume_get_utf16_description(
      libbde_volume_t *volume )
 {
-	uint8_t utf8_description[ 512 ];
+	uint16_t utf16_description[ 512 ];
 
-	libcerror_error_t *error    = NULL;
-	int result                  = 0;
-	int utf8_description_is_set = 0;
+	libcerror_error_t *error     = NULL;
+	int result                   = 0;
+	int utf16_description_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_utf8_description(
+	result = libbde_volume_get_utf16_description(
 	          volume,
-	          utf8_description,
+	          utf16_description,
 	          512,
 	          &error );
 
@@ -1939,13 +3247,13 @@ int bde_test_volume_get_utf8_description(
 	 "error",
 	 error );
 
-	utf8_description_is_set = result;
+	utf16_description_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf8_description(
+	result = libbde_volume_get_utf16_description(
 	          NULL,
-	          utf8_description,
+	          utf16_description,
 	          512,
 	          &error );
 
@@ -1961,9 +3269,9 @@ int bde_test_volume_get_utf8_description(
 	libcerror_error_free(
 	 &error );
 
-	if( utf8_description_is_set != 0 )
+	if( utf16_description_is_set != 0 )
 	{
-		result = libbde_volume_get_utf8_description(
+		result = libbde_volume_get_utf16_description(
 		          volume,
 		          NULL,
 		          512,
@@ -1981,9 +3289,9 @@ int bde_test_volume_get_utf8_description(
 		libcerror_error_free(
 		 &error );
 
-		result = libbde_volume_get_utf8_description(
+		result = libbde_volume_get_utf16_description(
 		          volume,
-		          utf8_description,
+		          utf16_description,
 		          0,
 		          &error );
 
@@ -1999,9 +3307,9 @@ int bde_test_volume_get_utf8_description(
 		libcerror_error_free(
 		 &error );
 
-		result = libbde_volume_get_utf8_description(
+		result = libbde_volume_get_utf16_description(
 		          volume,
-		          utf8_description,
+		          utf16_description,
 		          (size_t) SSIZE_MAX + 1,
 		          &error );
 
@@ -2028,22 +3336,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf16_description_size function
+/* Tests the libbde_volume_get_number_of_key_protectors function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf16_description_size(
+int bde_test_volume_get_number_of_key_protectors(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error          = NULL;
-	size_t utf16_description_size     = 0;
-	int result                        = 0;
-	int utf16_description_size_is_set = 0;
+	libcerror_error_t *error            = NULL;
+	int number_of_key_protectors        = 0;
+	int number_of_key_protectors_is_set = 0;
+	int result                          = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_utf16_description_size(
+	result = libbde_volume_get_number_of_key_protectors(
 	          volume,
-	          &utf16_description_size,
+	          &number_of_key_protectors,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2055,13 +3363,112 @@ int bde_test_volume_get_utf16_description_size(
 	 "error",
 	 error );
 
-	utf16_description_size_is_set = result;
+	number_of_key_protectors_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf16_description_size(
+	result = libbde_volume_get_number_of_key_protectors(
+	          NULL,
+	          &number_of_key_protectors,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( number_of_key_protectors_is_set != 0 )
+	{
+		result = libbde_volume_get_number_of_key_protectors(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_volume_master_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_volume_master_key(
+     libbde_volume_t *volume )
+{
+	uint8_t volume_master_key[ 32 ];
+
+	libcerror_error_t *error     = NULL;
+	int result                   = 0;
+	int volume_master_key_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_volume_master_key(
+	          volume,
+	          volume_master_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	volume_master_key_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_volume_master_key(
+	          NULL,
+	          volume_master_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_get_volume_master_key(
+	          volume,
 	          NULL,
-	          &utf16_description_size,
+	          32,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -2076,11 +3483,12 @@ int bde_test_volume_get_utf16_description_size(
 	libcerror_error_free(
 	 &error );
 
-	if( utf16_description_size_is_set != 0 )
+	if( volume_master_key_is_set != 0 )
 	{
-		result = libbde_volume_get_utf16_description_size(
+		result = libbde_volume_get_volume_master_key(
 		          volume,
-		          NULL,
+		          volume_master_key,
+		          16,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
@@ -2106,24 +3514,26 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf16_description function
+/* Tests the libbde_volume_get_keys function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf16_description(
+int bde_test_volume_get_keys(
      libbde_volume_t *volume )
 {
-	uint16_t utf16_description[ 512 ];
+	uint8_t full_volume_encryption_key[ 64 ];
+	uint8_t tweak_key[ 64 ];
 
-	libcerror_error_t *error     = NULL;
-	int result                   = 0;
-	int utf16_description_is_set = 0;
+	libcerror_error_t *error = NULL;
+	int result               = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_utf16_description(
+	result = libbde_volume_get_keys(
 	          volume,
-	          utf16_description,
-	          512,
+	          full_volume_encryption_key,
+	          64,
+	          tweak_key,
+	          64,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2135,14 +3545,14 @@ int bde_test_volume_get_utf16_description(
 	 "error",
 	 error );
 
-	utf16_description_is_set = result;
-
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf16_description(
+	result = libbde_volume_get_keys(
 	          NULL,
-	          utf16_description,
-	          512,
+	          full_volume_encryption_key,
+	          64,
+	          tweak_key,
+	          64,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -2157,62 +3567,46 @@ int bde_test_volume_get_utf16_description(
 	libcerror_error_free(
 	 &error );
 
-	if( utf16_description_is_set != 0 )
-	{
-		result = libbde_volume_get_utf16_description(
-		          volume,
-		          NULL,
-		          512,
-		          &error );
-
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
+	result = libbde_volume_get_keys(
+	          volume,
+	          NULL,
+	          64,
+	          tweak_key,
+	          64,
+	          &error );
 
-		result = libbde_volume_get_utf16_description(
-		          volume,
-		          utf16_description,
-		          0,
-		          &error );
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-	        BDE_TEST_ASSERT_IS_NOT_NULL(
-	         "error",
-	         error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
+	result = libbde_volume_get_keys(
+	          volume,
+	          full_volume_encryption_key,
+	          64,
+	          NULL,
+	          64,
+	          &error );
 
-		result = libbde_volume_get_utf16_description(
-		          volume,
-		          utf16_description,
-		          (size_t) SSIZE_MAX + 1,
-		          &error );
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	libcerror_error_free(
+	 &error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2224,40 +3618,104 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_number_of_key_protectors function
+/* Tests the libbde_volume_set_volume_master_key function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_number_of_key_protectors(
-     libbde_volume_t *volume )
+int bde_test_volume_set_volume_master_key(
+     void )
 {
-	libcerror_error_t *error            = NULL;
-	int number_of_key_protectors        = 0;
-	int number_of_key_protectors_is_set = 0;
-	int result                          = 0;
+	uint8_t volume_master_key[ 32 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+	uint8_t retrieved_volume_master_key[ 32 ];
+
+	libbde_volume_t *volume  = NULL;
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume",
+	 volume );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_number_of_key_protectors(
+	result = libbde_volume_get_volume_master_key(
 	          volume,
-	          &number_of_key_protectors,
+	          retrieved_volume_master_key,
+	          32,
 	          &error );
 
-	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
 	BDE_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	number_of_key_protectors_is_set = result;
+	result = libbde_volume_set_volume_master_key(
+	          volume,
+	          volume_master_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_get_volume_master_key(
+	          volume,
+	          retrieved_volume_master_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          retrieved_volume_master_key,
+	          volume_master_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_number_of_key_protectors(
+	result = libbde_volume_set_volume_master_key(
 	          NULL,
-	          &number_of_key_protectors,
+	          volume_master_key,
+	          32,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -2272,25 +3730,61 @@ int bde_test_volume_get_number_of_key_protectors(
 	libcerror_error_free(
 	 &error );
 
-	if( number_of_key_protectors_is_set != 0 )
-	{
-		result = libbde_volume_get_number_of_key_protectors(
-		          volume,
-		          NULL,
-		          &error );
+	result = libbde_volume_set_volume_master_key(
+	          volume,
+	          NULL,
+	          32,
+	          &error );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_volume_master_key(
+	          volume,
+	          volume_master_key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2299,6 +3793,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -2369,6 +3869,14 @@ int main(
 	 "libbde_volume_free",
 	 bde_test_volume_free );
 
+	BDE_TEST_RUN(
+	 "libbde_volume_open_memory",
+	 bde_test_volume_open_memory );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_set_volume_master_key",
+	 bde_test_volume_set_volume_master_key );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2394,6 +3902,8 @@ int main(
 
 		/* TODO add test for libbde_volume_open_file_io_handle */
 
+		/* TODO add test for libbde_volume_open_file_io_pool */
+
 #endif /* defined( LIBBDE_HAVE_BFIO ) */
 
 		BDE_TEST_RUN(
@@ -2448,6 +3958,16 @@ int main(
 
 		/* TODO: add tests for libbde_volume_read_buffer_at_offset */
 
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_pread_buffer",
+		 bde_test_volume_pread_buffer,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_pread_buffer_sector_data_pool",
+		 bde_test_volume_pread_buffer_sector_data_pool,
+		 volume );
+
 		/* TODO: add tests for libbde_volume_write_buffer */
 
 		/* TODO: add tests for libbde_volume_write_buffer_at_offset */
@@ -2464,6 +3984,26 @@ int main(
 		 bde_test_volume_get_size,
 		 volume );
 
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_cache_block_size",
+		 bde_test_volume_get_cache_block_size,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_readahead_depth",
+		 bde_test_volume_get_readahead_depth,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_number_of_threads",
+		 bde_test_volume_get_number_of_threads,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_optimal_io_size",
+		 bde_test_volume_get_optimal_io_size,
+		 volume );
+
 		BDE_TEST_RUN_WITH_ARGS(
 		 "libbde_volume_get_encryption_method",
 		 bde_test_volume_get_encryption_method,
@@ -2503,6 +4043,16 @@ int main(
 
 		/* TODO: add tests for libbde_volume_get_key_protector */
 
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_volume_master_key",
+		 bde_test_volume_get_volume_master_key,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_get_keys",
+		 bde_test_volume_get_keys,
+		 volume );
+
 		/* TODO: add tests for libbde_volume_set_keys */
 
 		/* TODO: add tests for libbde_volume_set_utf8_password */
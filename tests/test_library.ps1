@@ -10,7 +10,7 @@ $TestPrefix = Split-Path -path ${Pwd}.Path -parent
 $TestPrefix = Split-Path -path ${TestPrefix} -leaf
 $TestPrefix = ${TestPrefix}.Substring(3)
 
-$LibraryTests = "aes_ccm_encrypted_key error io_handle key key_protector metadata metadata_entry notify sector_data stretch_key volume_master_key"
+$LibraryTests = "aes_ccm_encrypted_key error io_handle key key_protector metadata metadata_entry notify sector_data sector_data_pool sectors_cache stretch_key volume_master_key"
 $LibraryTestsWithInput = "support volume"
 
 $TestToolDirectory = "..\msvscpp\Release"
@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-LIBRARY_TESTS="aes_ccm_encrypted_key error io_handle key key_protector metadata metadata_entry notify sector_data stretch_key volume_master_key";
+LIBRARY_TESTS="aes_af_alg aes_ccm_encrypted_key aes_ni aes_vaes diffuser encryption error io_handle io_uring key key_memo key_protector metadata metadata_entry notify password_keep sector_data sector_data_pool sectors_cache sha256 stretch_key volume_master_key";
 LIBRARY_TESTS_WITH_INPUT="support volume";
 OPTION_SETS="password recovery_password";
 